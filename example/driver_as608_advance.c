@@ -38,6 +38,76 @@
 
 static as608_handle_t gs_handle;        /**< as608 handle */
 static uint32_t gs_addr = 0;            /**< as608 address */
+static as608_capture_config_t gs_capture;        /**< as608 capture config */
+static as608_enroll_t gs_enroll;                 /**< as608 enroll */
+static void (*gs_input_callback)(int8_t status, const char *const fmt, ...) = NULL;        /**< input callback */
+static uint8_t gs_timeout = 0;                   /**< input timeout flag */
+static as608_verify_t gs_verify;                 /**< as608 verify */
+static void (*gs_verify_work)(void) = NULL;      /**< verify host work */
+
+/**
+ * @brief     enroll progress callback
+ * @param[in] *arg pointer to a callback argument
+ * @param[in] event enroll event
+ * @param[in] sample sample number
+ * @param[in] status chip status
+ * @note      it maps the enroll events to the input fingerprint callback
+ */
+static void a_input_callback(void *arg, as608_enroll_event_t event, uint8_t sample, as608_status_t status)
+{
+    (void)arg;
+    (void)status;
+
+    /* save the timeout */
+    gs_timeout = (event == AS608_ENROLL_EVENT_TIMEOUT) ? 1 : 0;
+    if (gs_input_callback == NULL)
+    {
+        return;
+    }
+    switch (event)
+    {
+        case AS608_ENROLL_EVENT_FEATURE :
+        {
+            if (sample == 1)
+            {
+                /* output */
+                gs_input_callback(1, "please put your finger on the sensor again.\n");
+            }
+            else
+            {
+                /* output */
+                gs_input_callback(2, "generate feature success.\n");
+            }
+
+            break;
+        }
+        case AS608_ENROLL_EVENT_RETRY :
+        {
+            /* output */
+            gs_input_callback(3, "image is not clear, please keep your finger on the sensor.\n");
+
+            break;
+        }
+        case AS608_ENROLL_EVENT_QUALITY :
+        {
+            /* output */
+            gs_input_callback(4, "feature is poor, please lift your finger and put it on the sensor again.\n");
+
+            break;
+        }
+        case AS608_ENROLL_EVENT_ERROR :
+        {
+            /* output */
+            gs_input_callback(-1, "error.\n");
+
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
 
 /**
  * @brief     advance example init
@@ -59,6 +129,9 @@ uint8_t as608_advance_init(uint32_t addr)
     DRIVER_AS608_LINK_UART_WRITE(&gs_handle, as608_interface_uart_write);
     DRIVER_AS608_LINK_UART_FLUSH(&gs_handle, as608_interface_uart_flush);
     DRIVER_AS608_LINK_DELAY_MS(&gs_handle, as608_interface_delay_ms);
+    DRIVER_AS608_LINK_TIMESTAMP_MS(&gs_handle, as608_interface_timestamp_ms);
+    DRIVER_AS608_LINK_UART_SET_BAUD_RATE(&gs_handle, as608_interface_uart_set_baud_rate);
+    DRIVER_AS608_LINK_UART_DRAIN(&gs_handle, as608_interface_uart_drain);
     DRIVER_AS608_LINK_DEBUG_PRINT(&gs_handle, as608_interface_debug_print);
 
     /* as608 init */
@@ -192,6 +265,14 @@ uint8_t as608_advance_init(uint32_t addr)
     /* set address */
     gs_addr = addr;
 
+    /* the touch line is optional */
+    (void)as608_interface_touch_init();
+
+    /* capture polls tightly after the prompt and sleeps on the touch line */
+    (void)as608_capture_config_init(&gs_capture);
+    gs_capture.timeout_ms = AS608_ADVANCE_DEFAULT_TIMEOUT * 1000;
+    gs_capture.wait = as608_interface_touch_wait;
+
     return 0;
 }
 
@@ -217,201 +298,56 @@ uint8_t as608_advance_input_fingerprint(void (*callback)(int8_t status, const ch
                                         as608_status_t *status)
 {
     uint8_t res;
-    uint32_t timeout;
-
-    /* max default time */
-    timeout = AS608_ADVANCE_DEFAULT_TIMEOUT;
-
-    /* wait your finger */
-    while (timeout != 0)
-    {
-        /* run the callback */
-        if (callback != NULL)
-        {
-            /* output */
-            callback(0, "please put your finger on the sensor.\n");
-        }
-
-        /* get image */
-        res = as608_get_image(&gs_handle, gs_addr, status);
-        if (res != 0)
-        {
-            return 1;
-        }
-        if (*status == AS608_STATUS_OK)
-        {
-            /* generate feature */
-            res = as608_generate_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_1, status);
-            if (res != 0)
-            {
-                return 1;
-            }
-            if (*status == AS608_STATUS_OK)
-            {
-                /* run the callback */
-                if (callback != NULL)
-                {
-                    /* output */
-                    callback(1, "please put your finger on the sensor again.\n");
-                }
-
-                /* max default time */
-                timeout = AS608_ADVANCE_DEFAULT_TIMEOUT;
-
-                /* wait your finger */
-                while (timeout != 0)
-                {
-                    /* get image */
-                    res = as608_get_image(&gs_handle, gs_addr, status);
-                    if (res != 0)
-                    {
-                        return 1;
-                    }
-                    if (*status == AS608_STATUS_OK)
-                    {
-                        /* generate feature */
-                        res = as608_generate_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_2, status);
-                        if (res != 0)
-                        {
-                            return 1;
-                        }
-                        if (*status == AS608_STATUS_OK)
-                        {
-                            /* run the callback */
-                            if (callback != NULL)
-                            {
-                                /* output */
-                                callback(2, "generate feature success.\n");
-                            }
-
-                            goto next;
-                        }
-                        else
-                        {
-                            /* run the callback */
-                            if (callback != NULL)
-                            {
-                                /* output */
-                                callback(-1, "error.\n");
-                            }
-                        }
-                    }
-
-                    /* delay 1000ms */
-                    as608_interface_delay_ms(1000);
-
-                    /* timeout-- */
-                    timeout--;
-                }
-
-                /* check timeout */
-                if (timeout == 0)
-                {
-                    return 2;
-                }
-            }
-            else
-            {
-                /* run the callback */
-                if (callback != NULL)
-                {
-                    /* output */
-                    callback(-1, "error.\n");
-                }
-            }
-        }
-
-        /* delay 1000ms */
-        as608_interface_delay_ms(1000);
-
-        /* timeout-- */
-        timeout--;
-    }
+    as608_bool_t done;
 
-    /* check timeout */
-    if (timeout == 0)
+    /* run the callback */
+    if (callback != NULL)
     {
-        return 2;
+        /* output */
+        callback(0, "please put your finger on the sensor.\n");
     }
 
-    next:
-    /* match feature */
-    res = as608_match_feature(&gs_handle, gs_addr, score, status);
+    /* start the enrollment */
+    gs_input_callback = callback;
+    gs_timeout = 0;
+    res = as608_enroll_start(&gs_handle, &gs_enroll, gs_addr, &gs_capture, a_input_callback, NULL);
     if (res != 0)
     {
         return 1;
     }
-    if (*status != AS608_STATUS_OK)
-    {
-        /* run the callback */
-        if (callback != NULL)
-        {
-            /* output */
-            callback(-1, "error.\n");
-        }
-
-        return 1;
-    }
 
-    /* combine feature */
-    res = as608_combine_feature(&gs_handle, gs_addr, status);
-    if (res != 0)
+    /* step until the enrollment is over */
+    do
     {
-        return 1;
-    }
-    if (*status != AS608_STATUS_OK)
-    {
-        /* run the callback */
-        if (callback != NULL)
+        res = as608_enroll_step(&gs_handle, &gs_enroll, &done);
+        if (res != 0)
         {
-            /* output */
-            callback(-1, "error.\n");
-        }
+            *status = gs_enroll.status;
 
-        return 1;
-    }
-
-    /* get valid template number */
-    res = as608_get_valid_template_number(&gs_handle, gs_addr, page_number, status);
-    if (res != 0)
-    {
-        return 1;
-    }
-    if (*status != AS608_STATUS_OK)
-    {
-        /* run the callback */
-        if (callback != NULL)
-        {
-            /* output */
-            callback(-1, "error.\n");
+            return 1;
         }
-
-        return 1;
-    }
-
-    /* store feature */
-    res = as608_store_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_2, *page_number, status);
-    if (res != 0)
-    {
-        return 1;
-    }
-    if (*status != AS608_STATUS_OK)
-    {
-        /* run the callback */
-        if (callback != NULL)
+        if (done == AS608_BOOL_FALSE)
         {
-            /* output */
-            callback(-1, "error.\n");
+            /* the step never waits, leave the cpu to others */
+            as608_interface_delay_ms(1);
         }
+    } while (done == AS608_BOOL_FALSE);
 
-        return 1;
+    /* check the result */
+    *status = gs_enroll.status;
+    if (gs_enroll.state != AS608_ENROLL_STATE_DONE)
+    {
+        return gs_timeout ? 2 : 1;
     }
+    *score = gs_enroll.score;
+    *page_number = gs_enroll.page_number;
 
     return 0;
 }
 
 /**
- * @brief      advance example verify
+ * @brief      advance example run the verify pipeline
+ * @param[in]  mode search mode
  * @param[out] *found_page pointer to a found page buffer
  * @param[out] *score pointer to a score buffer
  * @param[out] *status pointer to a status buffer
@@ -420,45 +356,72 @@ uint8_t as608_advance_input_fingerprint(void (*callback)(int8_t status, const ch
  *             - 1 verify failed
  * @note       none
  */
-uint8_t as608_advance_verify(uint16_t *found_page, uint16_t *score, as608_status_t *status)
+static uint8_t a_advance_verify(as608_verify_mode_t mode, uint16_t *found_page, uint16_t *score, as608_status_t *status)
 {
     uint8_t res;
+    as608_bool_t done;
 
-    /* get image */
-    res = as608_get_image(&gs_handle, gs_addr, status);
+    /* take the image once, then generate and search */
+    res = as608_verify_start(&gs_handle, &gs_verify, gs_addr, mode,
+                             AS608_ADVANCE_DEFAULT_FEATURE,
+                             0, 300, NULL);
     if (res != 0)
     {
         return 1;
     }
-    if (*status != AS608_STATUS_OK)
-    {
-        return 1;
-    }
 
-    /* generate feature */
-    res = as608_generate_feature(&gs_handle, gs_addr, AS608_ADVANCE_DEFAULT_FEATURE, status);
-    if (res != 0)
-    {
-        return 1;
-    }
-    if (*status != AS608_STATUS_OK)
+    /* step until the verify is over */
+    do
     {
-        return 1;
-    }
+        res = as608_verify_step(&gs_handle, &gs_verify, &done);
+        if (res != 0)
+        {
+            *status = gs_verify.status;
 
-    /* search feature */
-    res = as608_search_feature(&gs_handle, gs_addr,
-                               AS608_ADVANCE_DEFAULT_FEATURE,
-                               0, 300, found_page,
-                               score, status);
-    if (res != 0)
+            return 1;
+        }
+        if (done == AS608_BOOL_FALSE)
+        {
+            if (gs_verify_work != NULL)
+            {
+                /* the chip is busy, run the host work */
+                gs_verify_work();
+            }
+            else
+            {
+                /* the step never waits, leave the cpu to others */
+                as608_interface_delay_ms(1);
+            }
+        }
+    } while (done == AS608_BOOL_FALSE);
+
+    /* check the result */
+    *status = gs_verify.status;
+    if (gs_verify.phase != AS608_VERIFY_STATE_SEARCH)
     {
         return 1;
     }
+    *found_page = gs_verify.found_page;
+    *score = gs_verify.score;
 
     return 0;
 }
 
+/**
+ * @brief      advance example verify
+ * @param[out] *found_page pointer to a found page buffer
+ * @param[out] *score pointer to a score buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 verify failed
+ * @note       none
+ */
+uint8_t as608_advance_verify(uint16_t *found_page, uint16_t *score, as608_status_t *status)
+{
+    return a_advance_verify(AS608_VERIFY_MODE_SEARCH, found_page, score, status);
+}
+
 /**
  * @brief      advance example high speed verify
  * @param[out] *found_page pointer to a found page buffer
@@ -471,39 +434,34 @@ uint8_t as608_advance_verify(uint16_t *found_page, uint16_t *score, as608_status
  */
 uint8_t as608_advance_high_speed_verify(uint16_t *found_page, uint16_t *score, as608_status_t *status)
 {
-    uint8_t res;
+    return a_advance_verify(AS608_VERIFY_MODE_HIGH_SPEED_SEARCH, found_page, score, status);
+}
 
-    /* get image */
-    res = as608_get_image(&gs_handle, gs_addr, status);
-    if (res != 0)
-    {
-        return 1;
-    }
-    if (*status != AS608_STATUS_OK)
-    {
-        return 1;
-    }
+/**
+ * @brief     advance example set the verify work
+ * @param[in] *work pointer to a host work function, it can be NULL
+ * @return    status code
+ *            - 0 success
+ * @note      the work runs between the verify steps while the chip processes the command in flight,
+ *            it should return quickly
+ */
+uint8_t as608_advance_set_verify_work(void (*work)(void))
+{
+    gs_verify_work = work;
 
-    /* generate feature */
-    res = as608_generate_feature(&gs_handle, gs_addr, AS608_ADVANCE_DEFAULT_FEATURE, status);
-    if (res != 0)
-    {
-        return 1;
-    }
-    if (*status != AS608_STATUS_OK)
-    {
-        return 1;
-    }
+    return 0;
+}
 
-    /* high speed search feature */
-    res = as608_high_speed_search(&gs_handle, gs_addr,
-                                  AS608_ADVANCE_DEFAULT_FEATURE,
-                                  0, 300, found_page,
-                                  score, status);
-    if (res != 0)
-    {
-        return 1;
-    }
+/**
+ * @brief      advance example get the last verify timing
+ * @param[out] *timing pointer to a verify timing buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t as608_advance_get_verify_timing(as608_verify_timing_t *timing)
+{
+    *timing = gs_verify.timing;
 
     return 0;
 }
@@ -895,6 +853,41 @@ uint8_t as608_advance_upload_image(uint8_t *output_buffer, uint16_t *output_len,
     return 0;
 }
 
+/**
+ * @brief      advance example upload image to a sink
+ * @param[in]  sink pointer to a sink function
+ * @param[in]  *arg pointer to a sink argument
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 upload image failed
+ * @note       none
+ */
+uint8_t as608_advance_upload_image_to_sink(as608_sink_t sink, void *arg, as608_status_t *status)
+{
+    uint8_t res;
+
+    /* get image */
+    res = as608_get_image(&gs_handle, gs_addr, status);
+    if (res != 0)
+    {
+        return 1;
+    }
+    if (*status != AS608_STATUS_OK)
+    {
+        return 1;
+    }
+
+    /* upload image */
+    res = as608_upload_image_to_sink(&gs_handle, gs_addr, sink, arg, status);
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
 /**
  * @brief      advance example download image
  * @param[in]  page_number page number
@@ -929,6 +922,9 @@ uint8_t as608_advance_download_image(uint16_t page_number, uint8_t *input_buffer
  */
 uint8_t as608_advance_deinit(void)
 {
+    /* deinit the touch line */
+    (void)as608_interface_touch_deinit();
+
     /* deinit as608 */
     if (as608_deinit(&gs_handle) != 0)
     {
@@ -111,6 +111,8 @@ uint8_t as608_advance_print_status(as608_status_t status);
  *             - 0 please put your finger on the sensor
  *             - 1 please put your finger on the sensor again
  *             - 2 generate feature success
+ *             - 3 image is not clear, the image is taken again
+ *             - 4 feature is poor, the sample is taken again after the lift
  */
 uint8_t as608_advance_input_fingerprint(void (*callback)(int8_t status, const char *const fmt, ...), 
                                         uint16_t *score,
@@ -141,6 +143,25 @@ uint8_t as608_advance_verify(uint16_t *found_page, uint16_t *score, as608_status
  */
 uint8_t as608_advance_high_speed_verify(uint16_t *found_page, uint16_t *score, as608_status_t *status);
 
+/**
+ * @brief     advance example set the verify work
+ * @param[in] *work pointer to a host work function, it can be NULL
+ * @return    status code
+ *            - 0 success
+ * @note      the work runs between the verify steps while the chip processes the command in flight,
+ *            it should return quickly
+ */
+uint8_t as608_advance_set_verify_work(void (*work)(void));
+
+/**
+ * @brief      advance example get the last verify timing
+ * @param[out] *timing pointer to a verify timing buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t as608_advance_get_verify_timing(as608_verify_timing_t *timing);
+
 /**
  * @brief      advance example delete fingerprint
  * @param[in]  page_number page number
@@ -295,6 +316,18 @@ uint8_t as608_advance_download_flash_feature(uint16_t page_number, uint8_t *inpu
  */
 uint8_t as608_advance_upload_image(uint8_t *output_buffer, uint16_t *output_len, as608_status_t *status);
 
+/**
+ * @brief      advance example upload image to a sink
+ * @param[in]  sink pointer to a sink function
+ * @param[in]  *arg pointer to a sink argument
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 upload image failed
+ * @note       none
+ */
+uint8_t as608_advance_upload_image_to_sink(as608_sink_t sink, void *arg, as608_status_t *status);
+
 /**
  * @brief      advance example download image
  * @param[in]  page_number page number
@@ -38,6 +38,22 @@
 
 static as608_handle_t gs_handle;        /**< as608 handle */
 static uint32_t gs_addr = 0;            /**< as608 address */
+static as608_capture_config_t gs_capture;        /**< as608 capture config */
+
+/**
+ * @brief     basic example get the capture time left
+ * @param[in] start start timestamp
+ * @return    time left in ms
+ * @note      none
+ */
+static uint32_t a_basic_capture_left(uint32_t start)
+{
+    uint32_t elapsed;
+
+    elapsed = as608_interface_timestamp_ms() - start;
+
+    return (elapsed >= gs_capture.timeout_ms) ? 0 : (gs_capture.timeout_ms - elapsed);
+}
 
 /**
  * @brief     basic example init
@@ -59,6 +75,9 @@ uint8_t as608_basic_init(uint32_t addr)
     DRIVER_AS608_LINK_UART_WRITE(&gs_handle, as608_interface_uart_write);
     DRIVER_AS608_LINK_UART_FLUSH(&gs_handle, as608_interface_uart_flush);
     DRIVER_AS608_LINK_DELAY_MS(&gs_handle, as608_interface_delay_ms);
+    DRIVER_AS608_LINK_TIMESTAMP_MS(&gs_handle, as608_interface_timestamp_ms);
+    DRIVER_AS608_LINK_UART_SET_BAUD_RATE(&gs_handle, as608_interface_uart_set_baud_rate);
+    DRIVER_AS608_LINK_UART_DRAIN(&gs_handle, as608_interface_uart_drain);
     DRIVER_AS608_LINK_DEBUG_PRINT(&gs_handle, as608_interface_debug_print);
 
     /* as608 init */
@@ -192,6 +211,14 @@ uint8_t as608_basic_init(uint32_t addr)
     /* set address */
     gs_addr = addr;
 
+    /* the touch line is optional */
+    (void)as608_interface_touch_init();
+
+    /* capture polls tightly after the prompt and sleeps on the touch line */
+    (void)as608_capture_config_init(&gs_capture);
+    gs_capture.timeout_ms = AS608_BASIC_DEFAULT_TIMEOUT * 1000;
+    gs_capture.wait = as608_interface_touch_wait;
+
     return 0;
 }
 
@@ -217,14 +244,23 @@ uint8_t as608_basic_input_fingerprint(void (*callback)(int8_t status, const char
                                       as608_status_t *status)
 {
     uint8_t res;
-    uint32_t timeout;
+    uint32_t start;
+    as608_capture_config_t capture;
 
-    /* max default time */
-    timeout = AS608_BASIC_DEFAULT_TIMEOUT;
+    /* all attempts share one deadline */
+    capture = gs_capture;
+    start = as608_interface_timestamp_ms();
 
     /* wait your finger */
-    while (timeout != 0)
+    while (1)
     {
+        /* check the deadline */
+        capture.timeout_ms = a_basic_capture_left(start);
+        if (capture.timeout_ms == 0)
+        {
+            return 2;
+        }
+
         /* run the callback */
         if (callback != NULL)
         {
@@ -232,8 +268,12 @@ uint8_t as608_basic_input_fingerprint(void (*callback)(int8_t status, const char
             callback(0, "please put your finger on the sensor.\n");
         }
 
-        /* get image */
-        res = as608_get_image(&gs_handle, gs_addr, status);
+        /* capture the image in the time left */
+        res = as608_capture_image(&gs_handle, gs_addr, &capture, NULL, status);
+        if (res == 4)
+        {
+            return 2;
+        }
         if (res != 0)
         {
             return 1;
@@ -255,14 +295,25 @@ uint8_t as608_basic_input_fingerprint(void (*callback)(int8_t status, const char
                     callback(1, "please put your finger on the sensor again.\n");
                 }
 
-                /* max default time */
-                timeout = AS608_BASIC_DEFAULT_TIMEOUT;
+                /* the second sample gets a new deadline */
+                start = as608_interface_timestamp_ms();
 
                 /* wait your finger */
-                while (timeout != 0)
+                while (1)
                 {
-                    /* get image */
-                    res = as608_get_image(&gs_handle, gs_addr, status);
+                    /* check the deadline */
+                    capture.timeout_ms = a_basic_capture_left(start);
+                    if (capture.timeout_ms == 0)
+                    {
+                        return 2;
+                    }
+
+                    /* capture the image in the time left */
+                    res = as608_capture_image(&gs_handle, gs_addr, &capture, NULL, status);
+                    if (res == 4)
+                    {
+                        return 2;
+                    }
                     if (res != 0)
                     {
                         return 1;
@@ -296,18 +347,6 @@ uint8_t as608_basic_input_fingerprint(void (*callback)(int8_t status, const char
                             }
                         }
                     }
-
-                    /* delay 1000ms */
-                    as608_interface_delay_ms(1000);
-
-                    /* timeout-- */
-                    timeout--;
-                }
-
-                /* check timeout */
-                if (timeout == 0)
-                {
-                    return 2;
                 }
             }
             else
@@ -320,18 +359,6 @@ uint8_t as608_basic_input_fingerprint(void (*callback)(int8_t status, const char
                 }
             }
         }
-
-        /* delay 1000ms */
-        as608_interface_delay_ms(1000);
-
-        /* timeout-- */
-        timeout--;
-    }
-
-    /* check timeout */
-    if (timeout == 0)
-    {
-        return 2;
     }
 
     next:
@@ -584,6 +611,9 @@ uint8_t as608_basic_empty_fingerprint(as608_status_t *status)
  */
 uint8_t as608_basic_deinit(void)
 {
+    /* deinit the touch line */
+    (void)as608_interface_touch_deinit();
+
     /* deinit as608 */
     if (as608_deinit(&gs_handle) != 0)
     {
@@ -86,6 +86,31 @@ uint8_t as608_interface_uart_flush(void)
     return 0;
 }
 
+/**
+ * @brief     interface uart set the baud rate
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+uint8_t as608_interface_uart_set_baud_rate(uint32_t baud_rate)
+{
+    return 0;
+}
+
+/**
+ * @brief  interface uart drain
+ * @return status code
+ *         - 0 success
+ *         - 1 uart drain failed
+ * @note   it returns when all the written bytes are sent
+ */
+uint8_t as608_interface_uart_drain(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface uart write
  * @param[in] *buf pointer to a data buffer
@@ -110,6 +135,16 @@ void as608_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief  interface timestamp ms
+ * @return monotonic time in ms
+ * @note   none
+ */
+uint32_t as608_interface_timestamp_ms(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -119,3 +154,174 @@ void as608_interface_debug_print(const char *const fmt, ...)
 {
     
 }
+
+/**
+ * @brief  interface touch init
+ * @return status code
+ *         - 0 success
+ *         - 1 touch init failed
+ * @note   the touch line is optional
+ */
+uint8_t as608_interface_touch_init(void)
+{
+    return 1;
+}
+
+/**
+ * @brief  interface touch deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 touch deinit failed
+ * @note   none
+ */
+uint8_t as608_interface_touch_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface touch wait
+ * @param[in] ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      it returns at the touch edge, without the touch line it delays ms and returns 2
+ */
+uint8_t as608_interface_touch_wait(uint32_t ms)
+{
+    as608_interface_delay_ms(ms);
+    
+    return 2;
+}
+
+/**
+ * @brief     interface transport uart init
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_init(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart deinit
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_deinit(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface transport uart read
+ * @param[in]  *ctx pointer to a transport context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       none
+ */
+uint16_t as608_interface_transport_uart_read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart write
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_write(void *ctx, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart flush
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_flush(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport delay ms
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] ms time
+ * @note      none
+ */
+void as608_interface_transport_delay_ms(void *ctx, uint32_t ms)
+{
+
+}
+
+/**
+ * @brief     interface transport timestamp ms
+ * @param[in] *ctx pointer to a transport context
+ * @return    monotonic time in ms
+ * @note      none
+ */
+uint32_t as608_interface_transport_timestamp_ms(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart set the baud rate
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_set_baud_rate(void *ctx, uint32_t baud_rate)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart writev
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are sent in order as one write
+ */
+uint8_t as608_interface_transport_uart_writev(void *ctx, as608_iovec_t *iov, uint8_t count)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart drain
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart drain failed
+ * @note      it returns when all the written bytes are sent
+ */
+uint8_t as608_interface_transport_uart_drain(void *ctx)
+{
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_fault.h
+ * @brief     as608 fault transport header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef AS608_FAULT_H
+#define AS608_FAULT_H
+
+#include "driver_as608.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup as608_fault as608 fault transport function
+ * @brief    as608 fault transport function modules
+ * @{
+ */
+
+/**
+ * @brief as608 fault buffer size definition
+ */
+#define AS608_FAULT_BUFFER_SIZE    1024
+
+/**
+ * @brief as608 fault config structure definition
+ * @note  all probabilities are in ppm, 0 disables the fault
+ */
+typedef struct as608_fault_config_s
+{
+    uint32_t seed;               /**< random seed */
+    uint32_t drop_ppm;           /**< received byte drop probability */
+    uint32_t flip_ppm;           /**< received byte bit flip probability */
+    uint32_t tx_flip_ppm;        /**< sent byte bit flip probability */
+    uint16_t split_max;          /**< max length of one read, 0 means no split */
+    uint8_t coalesce;            /**< merged reads while the bytes keep coming, 0 or 1 means no merge */
+    uint32_t reorder_ppm;        /**< read chunk swap probability */
+    uint32_t latency_ms;         /**< extra latency of every response */
+    uint32_t stall_ppm;          /**< response stall probability */
+    uint32_t stall_ms;           /**< stall time */
+} as608_fault_config_t;
+
+/**
+ * @brief as608 fault stats structure definition
+ */
+typedef struct as608_fault_stats_s
+{
+    uint32_t dropped;            /**< dropped bytes */
+    uint32_t flipped;            /**< flipped received bytes */
+    uint32_t tx_flipped;         /**< flipped sent bytes */
+    uint32_t split;              /**< split reads */
+    uint32_t coalesced;          /**< merged reads */
+    uint32_t reordered;          /**< swapped chunks */
+    uint32_t delayed;            /**< delayed responses */
+    uint32_t stalled;            /**< stalled responses */
+} as608_fault_stats_t;
+
+/**
+ * @brief as608 fault structure definition
+ */
+typedef struct as608_fault_s
+{
+    const as608_transport_t *transport;          /**< inner transport */
+    void *ctx;                                   /**< inner transport context */
+    as608_fault_config_t config;                 /**< fault config */
+    as608_fault_stats_t stats;                   /**< fault stats */
+    uint32_t rng;                                /**< random state */
+    uint32_t clock;                              /**< delayed time used without the inner timestamp */
+    uint32_t release_ms;                         /**< time when the response can be read */
+    uint8_t coalesce;                            /**< merged reads of the current chunk */
+    uint8_t buf[AS608_FAULT_BUFFER_SIZE];        /**< pending received bytes */
+    uint16_t len;                                /**< pending length */
+} as608_fault_t;
+
+/**
+ * @brief     as608 fault init
+ * @param[in] *fault pointer to an as608 fault structure
+ * @param[in] *transport pointer to the inner transport
+ * @param[in] *ctx pointer to the inner transport context
+ * @param[in] *config pointer to a fault config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the same seed gives the same faults for the same traffic
+ */
+uint8_t as608_fault_init(as608_fault_t *fault, const as608_transport_t *transport, void *ctx,
+                         const as608_fault_config_t *config);
+
+/**
+ * @brief  as608 fault get the transport
+ * @return pointer to the fault transport
+ * @note   link it with an as608 fault structure as the context, 
+ *         e.g. DRIVER_AS608_LINK_TRANSPORT(&handle, as608_fault_transport(), &fault)
+ */
+const as608_transport_t *as608_fault_transport(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
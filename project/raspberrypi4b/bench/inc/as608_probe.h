@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_probe.h
+ * @brief     as608 probe transport header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef AS608_PROBE_H
+#define AS608_PROBE_H
+
+#include "driver_as608.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup as608_probe as608 probe transport function
+ * @brief    as608 probe transport function modules
+ * @{
+ */
+
+/**
+ * @brief as608 probe phase structure definition
+ * @note  the polling sleeps while waiting or receiving are also counted in wait_us or receive_us
+ */
+typedef struct as608_probe_phase_s
+{
+    uint64_t write_us;           /**< time spent in the uart write */
+    uint64_t wait_us;            /**< time from the end of a write to the first response byte */
+    uint64_t receive_us;         /**< time from the first to the last response byte */
+    uint64_t sleep_us;           /**< time spent in delay_ms */
+} as608_probe_phase_t;
+
+/**
+ * @brief as608 probe structure definition
+ */
+typedef struct as608_probe_s
+{
+    const as608_transport_t *transport;          /**< inner transport */
+    void *ctx;                                   /**< inner transport context */
+    as608_probe_phase_t phase;                   /**< phase time of the current call */
+    uint64_t write_end_us;                       /**< end time of the last write */
+    uint64_t first_us;                           /**< time of the first response byte */
+    uint64_t last_us;                            /**< time of the last response byte */
+    uint8_t waiting;                             /**< waiting for the first response byte flag */
+    uint8_t receiving;                           /**< receiving the response flag */
+} as608_probe_t;
+
+/**
+ * @brief     as608 probe init
+ * @param[in] *probe pointer to an as608 probe structure
+ * @param[in] *transport pointer to the inner transport
+ * @param[in] *ctx pointer to the inner transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t as608_probe_init(as608_probe_t *probe, const as608_transport_t *transport, void *ctx);
+
+/**
+ * @brief  as608 probe get the transport
+ * @return pointer to the probe transport
+ * @note   link it with an as608 probe structure as the context
+ */
+const as608_transport_t *as608_probe_transport(void);
+
+/**
+ * @brief     as608 probe begin a call
+ * @param[in] *probe pointer to an as608 probe structure
+ * @note      the phase time is cleared
+ */
+void as608_probe_begin(as608_probe_t *probe);
+
+/**
+ * @brief      as608 probe end a call
+ * @param[in]  *probe pointer to an as608 probe structure
+ * @param[out] *phase pointer to a phase structure
+ * @note       none
+ */
+void as608_probe_end(as608_probe_t *probe, as608_probe_phase_t *phase);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
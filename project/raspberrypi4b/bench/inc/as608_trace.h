@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_trace.h
+ * @brief     as608 trace recorder and replay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef AS608_TRACE_H
+#define AS608_TRACE_H
+
+#include "driver_as608.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup as608_trace as608 trace recorder and replay function
+ * @brief    as608 trace recorder and replay function modules
+ * @{
+ */
+
+/**
+ * @brief as608 trace file header length definition
+ * @note  "A6TR", version and 3 reserved bytes
+ */
+#define AS608_TRACE_FILE_HEADER_LEN    8
+
+/**
+ * @brief as608 trace record header length definition
+ * @note  timestamp_ms(4), direction(1), type(1), command(1), reserved(1), addr(4), len(2), sum(2),
+ *        all in little endian and followed by len payload bytes
+ */
+#define AS608_TRACE_RECORD_HEADER_LEN  16
+
+/**
+ * @brief as608 trace recorder structure definition
+ */
+typedef struct as608_trace_recorder_s
+{
+    FILE *fp;                    /**< trace file */
+    uint32_t frames;             /**< recorded frames */
+    uint32_t bytes;              /**< recorded bytes */
+    uint8_t error;               /**< write error flag */
+} as608_trace_recorder_t;
+
+/**
+ * @brief as608 trace replay structure definition
+ */
+typedef struct as608_trace_replay_s
+{
+    uint8_t *buf;                /**< trace in memory */
+    uint32_t size;               /**< trace size */
+    uint32_t point;              /**< next record */
+    uint32_t clock;              /**< virtual clock in ms */
+    uint32_t base;               /**< virtual clock minus the trace clock of the last sent frame */
+    uint8_t frame[384];          /**< received frame on the wire */
+    uint16_t frame_len;          /**< received frame length */
+    uint16_t frame_point;        /**< received frame read point */
+    uint32_t sent;               /**< replayed sent frames */
+    uint32_t received;           /**< replayed received frames */
+    uint32_t mismatched;         /**< sent frames which differ from the trace */
+} as608_trace_replay_t;
+
+/**
+ * @brief     as608 trace recorder init
+ * @param[in] *recorder pointer to an as608 trace recorder structure
+ * @param[in] *fp pointer to an opened trace file
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the file header is written
+ */
+uint8_t as608_trace_recorder_init(as608_trace_recorder_t *recorder, FILE *fp);
+
+/**
+ * @brief     as608 trace record one frame
+ * @param[in] *arg pointer to an as608 trace recorder structure
+ * @param[in] *frame pointer to a trace frame
+ * @note      link it with as608_set_trace
+ */
+void as608_trace_record(void *arg, as608_trace_frame_t *frame);
+
+/**
+ * @brief         as608 trace read the next record
+ * @param[in]     *buf pointer to a trace buffer
+ * @param[in]     size trace size
+ * @param[in,out] *point pointer to a record point buffer
+ * @param[out]    *frame pointer to a trace frame buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 end of the trace
+ *                - 2 record is broken
+ * @note          payload points into buf, the point of a new trace is AS608_TRACE_FILE_HEADER_LEN
+ */
+uint8_t as608_trace_next(uint8_t *buf, uint32_t size, uint32_t *point, as608_trace_frame_t *frame);
+
+/**
+ * @brief      as608 trace encode a frame to the wire bytes
+ * @param[in]  *frame pointer to a trace frame
+ * @param[out] *buf pointer to a wire buffer
+ * @return     wire length
+ * @note       buf must hold len + 11 bytes
+ */
+uint16_t as608_trace_encode(as608_trace_frame_t *frame, uint8_t *buf);
+
+/**
+ * @brief     as608 trace replay init
+ * @param[in] *replay pointer to an as608 trace replay structure
+ * @param[in] *buf pointer to a trace buffer
+ * @param[in] size trace size
+ * @return    status code
+ *            - 0 success
+ *            - 1 trace is invalid
+ * @note      buf must be kept until the replay ends
+ */
+uint8_t as608_trace_replay_init(as608_trace_replay_t *replay, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief  as608 trace replay get the transport
+ * @return pointer to the replay transport
+ * @note   link it with an as608 trace replay structure as the context,
+ *         every write moves to the next sent frame of the trace and the received frames after it
+ *         are read at their recorded delay on a virtual clock, so delay_ms never sleeps
+ */
+const as608_transport_t *as608_trace_replay_transport(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
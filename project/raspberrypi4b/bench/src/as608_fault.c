@@ -0,0 +1,460 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_fault.c
+ * @brief     as608 fault transport source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "as608_fault.h"
+#include <string.h>
+
+/**
+ * @brief     fault get the next random number
+ * @param[in] *fault pointer to an as608 fault structure
+ * @return    random number
+ * @note      xorshift32
+ */
+static uint32_t a_fault_random(as608_fault_t *fault)
+{
+    uint32_t x = fault->rng;
+    
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    fault->rng = x;
+    
+    return x;
+}
+
+/**
+ * @brief     fault check a chance
+ * @param[in] *fault pointer to an as608 fault structure
+ * @param[in] ppm probability in ppm
+ * @return    1 if the fault happens, otherwise 0
+ * @note      no random number is taken when ppm is 0
+ */
+static uint8_t a_fault_chance(as608_fault_t *fault, uint32_t ppm)
+{
+    if (ppm == 0)
+    {
+        return 0;
+    }
+    
+    return ((a_fault_random(fault) % 1000000) < ppm) ? 1 : 0;
+}
+
+/**
+ * @brief     fault get the time
+ * @param[in] *fault pointer to an as608 fault structure
+ * @return    time in ms
+ * @note      the delayed time is used if the inner transport has no timestamp
+ */
+static uint32_t a_fault_now(as608_fault_t *fault)
+{
+    if (fault->transport->timestamp_ms != NULL)
+    {
+        return fault->transport->timestamp_ms(fault->ctx);
+    }
+    else
+    {
+        return fault->clock;
+    }
+}
+
+/**
+ * @brief     fault uart init
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+static uint8_t a_fault_uart_init(void *ctx)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    
+    fault->len = 0;
+    fault->coalesce = 0;
+    fault->release_ms = a_fault_now(fault);
+    
+    return fault->transport->uart_init(fault->ctx);
+}
+
+/**
+ * @brief     fault uart deinit
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+static uint8_t a_fault_uart_deinit(void *ctx)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    
+    return fault->transport->uart_deinit(fault->ctx);
+}
+
+/**
+ * @brief      fault uart read
+ * @param[in]  *ctx pointer to an as608 fault structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       the inner bytes are dropped or flipped when they arrive, 
+ *             then held, merged, split or swapped when they are read
+ */
+static uint16_t a_fault_uart_read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    uint8_t tmp[384];
+    uint16_t i;
+    uint16_t n;
+    uint16_t m;
+    uint16_t k;
+    
+    /* pull the inner bytes and corrupt them, only when more bytes are needed or merged, 
+       because the inner read may wait for the uart */
+    n = AS608_FAULT_BUFFER_SIZE - fault->len;
+    n = (n > sizeof(tmp)) ? sizeof(tmp) : n;
+    n = ((fault->len < len) || (fault->config.coalesce > 1)) ? n : 0;
+    if (n != 0)
+    {
+        n = fault->transport->uart_read(fault->ctx, tmp, n);
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (a_fault_chance(fault, fault->config.drop_ppm) != 0)
+        {
+            fault->stats.dropped++;
+            
+            continue;
+        }
+        if (a_fault_chance(fault, fault->config.flip_ppm) != 0)
+        {
+            tmp[i] ^= (uint8_t)(1 << (a_fault_random(fault) % 8));
+            fault->stats.flipped++;
+        }
+        fault->buf[fault->len] = tmp[i];
+        fault->len++;
+    }
+    if ((fault->len == 0) || (len == 0))
+    {
+        return 0;
+    }
+    
+    /* hold the response until the latency or the stall passes */
+    if ((int32_t)(a_fault_now(fault) - fault->release_ms) < 0)
+    {
+        return 0;
+    }
+    
+    /* merge the reads while the bytes keep coming */
+    if ((n != 0) && (fault->config.coalesce > 1) && ((fault->coalesce + 1) < fault->config.coalesce))
+    {
+        fault->coalesce++;
+        fault->stats.coalesced++;
+        
+        return 0;
+    }
+    fault->coalesce = 0;
+    
+    /* split the read */
+    m = (fault->len > len) ? len : fault->len;
+    m = (m > sizeof(tmp)) ? sizeof(tmp) : m;
+    if (fault->config.split_max != 0)
+    {
+        k = (uint16_t)(1 + a_fault_random(fault) % fault->config.split_max);
+        if (k < m)
+        {
+            m = k;
+            fault->stats.split++;
+        }
+    }
+    
+    /* swap this chunk with the next one */
+    if ((fault->len > m) && (a_fault_chance(fault, fault->config.reorder_ppm) != 0))
+    {
+        k = fault->len - m;
+        k = (k > m) ? m : k;
+        memcpy(tmp, fault->buf, m);
+        memmove(fault->buf, fault->buf + m, k);
+        memcpy(fault->buf + k, tmp, m);
+        m = k;
+        fault->stats.reordered++;
+    }
+    
+    /* output the chunk */
+    memcpy(buf, fault->buf, m);
+    fault->len -= m;
+    memmove(fault->buf, fault->buf + m, fault->len);
+    
+    return m;
+}
+
+/**
+ * @brief     fault uart flush
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      the pending bytes are dropped with the inner ones
+ */
+static uint8_t a_fault_uart_flush(void *ctx)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    
+    fault->len = 0;
+    fault->coalesce = 0;
+    
+    return fault->transport->uart_flush(fault->ctx);
+}
+
+/**
+ * @brief     fault start a new response
+ * @param[in] *fault pointer to an as608 fault structure
+ * @note      the response is delayed or stalled
+ */
+static void a_fault_response_start(as608_fault_t *fault)
+{
+    fault->release_ms = a_fault_now(fault) + fault->config.latency_ms;
+    if (fault->config.latency_ms != 0)
+    {
+        fault->stats.delayed++;
+    }
+    if (a_fault_chance(fault, fault->config.stall_ppm) != 0)
+    {
+        fault->release_ms += fault->config.stall_ms;
+        fault->stats.stalled++;
+    }
+    fault->coalesce = 0;
+}
+
+/**
+ * @brief     fault uart write
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      every write starts a new response for the latency and the stall
+ */
+static uint8_t a_fault_uart_write(void *ctx, uint8_t *buf, uint16_t len)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    uint8_t tmp[384];
+    uint16_t i;
+    
+    /* delay or stall the response */
+    a_fault_response_start(fault);
+    
+    /* corrupt the sent bytes */
+    if ((fault->config.tx_flip_ppm != 0) && (len <= sizeof(tmp)))
+    {
+        memcpy(tmp, buf, len);
+        for (i = 0; i < len; i++)
+        {
+            if (a_fault_chance(fault, fault->config.tx_flip_ppm) != 0)
+            {
+                tmp[i] ^= (uint8_t)(1 << (a_fault_random(fault) % 8));
+                fault->stats.tx_flipped++;
+            }
+        }
+        
+        return fault->transport->uart_write(fault->ctx, tmp, len);
+    }
+    
+    return fault->transport->uart_write(fault->ctx, buf, len);
+}
+
+/**
+ * @brief     fault uart writev
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are joined when the sent bytes are corrupted or the inner transport has no writev
+ */
+static uint8_t a_fault_uart_writev(void *ctx, as608_iovec_t *iov, uint8_t count)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    uint8_t tmp[384];
+    uint16_t l;
+    uint8_t i;
+    
+    if ((fault->config.tx_flip_ppm != 0) || (fault->transport->uart_writev == NULL))
+    {
+        /* join the buffers */
+        l = 0;
+        for (i = 0; i < count; i++)
+        {
+            if ((l + iov[i].len) > sizeof(tmp))
+            {
+                return 1;
+            }
+            memcpy(tmp + l, iov[i].buf, iov[i].len);
+            l += iov[i].len;
+        }
+        
+        return a_fault_uart_write(ctx, tmp, l);
+    }
+    
+    /* delay or stall the response */
+    a_fault_response_start(fault);
+    
+    return fault->transport->uart_writev(fault->ctx, iov, count);
+}
+
+/**
+ * @brief     fault delay ms
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_fault_delay_ms(void *ctx, uint32_t ms)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    
+    fault->clock += ms;
+    fault->transport->delay_ms(fault->ctx, ms);
+}
+
+/**
+ * @brief     fault timestamp ms
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @return    time in ms
+ * @note      none
+ */
+static uint32_t a_fault_timestamp_ms(void *ctx)
+{
+    return a_fault_now((as608_fault_t *)ctx);
+}
+
+/**
+ * @brief     fault uart set the baud rate
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+static uint8_t a_fault_uart_set_baud_rate(void *ctx, uint32_t baud_rate)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    
+    if (fault->transport->uart_set_baud_rate == NULL)
+    {
+        return 1;
+    }
+    
+    return fault->transport->uart_set_baud_rate(fault->ctx, baud_rate);
+}
+
+/**
+ * @brief     fault uart drain
+ * @param[in] *ctx pointer to an as608 fault structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart drain failed
+ * @note      none
+ */
+static uint8_t a_fault_uart_drain(void *ctx)
+{
+    as608_fault_t *fault = (as608_fault_t *)ctx;
+    
+    if (fault->transport->uart_drain == NULL)
+    {
+        return 0;
+    }
+    
+    return fault->transport->uart_drain(fault->ctx);
+}
+
+/**
+ * @brief fault transport definition
+ */
+static const as608_transport_t gs_fault_transport =
+{
+    .uart_init = a_fault_uart_init,
+    .uart_deinit = a_fault_uart_deinit,
+    .uart_read = a_fault_uart_read,
+    .uart_flush = a_fault_uart_flush,
+    .uart_write = a_fault_uart_write,
+    .delay_ms = a_fault_delay_ms,
+    .timestamp_ms = a_fault_timestamp_ms,
+    .uart_set_baud_rate = a_fault_uart_set_baud_rate,
+    .uart_writev = a_fault_uart_writev,
+    .uart_drain = a_fault_uart_drain,
+};
+
+/**
+ * @brief     as608 fault init
+ * @param[in] *fault pointer to an as608 fault structure
+ * @param[in] *transport pointer to the inner transport
+ * @param[in] *ctx pointer to the inner transport context
+ * @param[in] *config pointer to a fault config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the same seed gives the same faults for the same traffic
+ */
+uint8_t as608_fault_init(as608_fault_t *fault, const as608_transport_t *transport, void *ctx,
+                         const as608_fault_config_t *config)
+{
+    if ((fault == NULL) || (transport == NULL) || (config == NULL))
+    {
+        return 1;
+    }
+    
+    memset(fault, 0, sizeof(as608_fault_t));
+    fault->transport = transport;
+    fault->ctx = ctx;
+    fault->config = *config;
+    fault->rng = (config->seed != 0) ? config->seed : 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  as608 fault get the transport
+ * @return pointer to the fault transport
+ * @note   link it with an as608 fault structure as the context, 
+ *         e.g. DRIVER_AS608_LINK_TRANSPORT(&handle, as608_fault_transport(), &fault)
+ */
+const as608_transport_t *as608_fault_transport(void)
+{
+    return &gs_fault_transport;
+}
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_probe.c
+ * @brief     as608 probe transport source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "as608_probe.h"
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief  probe get the monotonic time
+ * @return time in us
+ * @note   none
+ */
+static uint64_t a_probe_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     probe close the current response
+ * @param[in] *probe pointer to an as608 probe structure
+ * @note      none
+ */
+static void a_probe_close(as608_probe_t *probe)
+{
+    if (probe->receiving != 0)
+    {
+        probe->phase.receive_us += probe->last_us - probe->first_us;
+    }
+    probe->waiting = 0;
+    probe->receiving = 0;
+}
+
+/**
+ * @brief     probe uart init
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+static uint8_t a_probe_uart_init(void *ctx)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    
+    return probe->transport->uart_init(probe->ctx);
+}
+
+/**
+ * @brief     probe uart deinit
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+static uint8_t a_probe_uart_deinit(void *ctx)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    
+    return probe->transport->uart_deinit(probe->ctx);
+}
+
+/**
+ * @brief      probe uart read
+ * @param[in]  *ctx pointer to an as608 probe structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       none
+ */
+static uint16_t a_probe_uart_read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    uint16_t l;
+    uint64_t now;
+    
+    l = probe->transport->uart_read(probe->ctx, buf, len);
+    if (l != 0)
+    {
+        now = a_probe_now_us();
+        if (probe->waiting != 0)
+        {
+            probe->phase.wait_us += now - probe->write_end_us;
+            probe->waiting = 0;
+            probe->receiving = 1;
+            probe->first_us = now;
+        }
+        probe->last_us = now;
+    }
+    
+    return l;
+}
+
+/**
+ * @brief     probe uart flush
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+static uint8_t a_probe_uart_flush(void *ctx)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    
+    return probe->transport->uart_flush(probe->ctx);
+}
+
+/**
+ * @brief     probe uart write
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      every write closes the last response and waits for a new one
+ */
+static uint8_t a_probe_uart_write(void *ctx, uint8_t *buf, uint16_t len)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    uint8_t res;
+    uint64_t start;
+    
+    a_probe_close(probe);
+    start = a_probe_now_us();
+    res = probe->transport->uart_write(probe->ctx, buf, len);
+    probe->write_end_us = a_probe_now_us();
+    probe->phase.write_us += probe->write_end_us - start;
+    probe->waiting = 1;
+    
+    return res;
+}
+
+/**
+ * @brief     probe uart writev
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are joined when the inner transport has no writev
+ */
+static uint8_t a_probe_uart_writev(void *ctx, as608_iovec_t *iov, uint8_t count)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    uint8_t tmp[384];
+    uint8_t res;
+    uint8_t i;
+    uint16_t l;
+    uint64_t start;
+    
+    a_probe_close(probe);
+    start = a_probe_now_us();
+    if (probe->transport->uart_writev != NULL)
+    {
+        res = probe->transport->uart_writev(probe->ctx, iov, count);
+    }
+    else
+    {
+        /* join the buffers */
+        l = 0;
+        res = 0;
+        for (i = 0; i < count; i++)
+        {
+            if ((l + iov[i].len) > sizeof(tmp))
+            {
+                res = 1;
+                
+                break;
+            }
+            memcpy(tmp + l, iov[i].buf, iov[i].len);
+            l += iov[i].len;
+        }
+        if (res == 0)
+        {
+            res = probe->transport->uart_write(probe->ctx, tmp, l);
+        }
+    }
+    probe->write_end_us = a_probe_now_us();
+    probe->phase.write_us += probe->write_end_us - start;
+    probe->waiting = 1;
+    
+    return res;
+}
+
+/**
+ * @brief     probe delay ms
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_probe_delay_ms(void *ctx, uint32_t ms)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    uint64_t start;
+    
+    start = a_probe_now_us();
+    probe->transport->delay_ms(probe->ctx, ms);
+    probe->phase.sleep_us += a_probe_now_us() - start;
+}
+
+/**
+ * @brief     probe timestamp ms
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @return    time in ms
+ * @note      none
+ */
+static uint32_t a_probe_timestamp_ms(void *ctx)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    
+    if (probe->transport->timestamp_ms != NULL)
+    {
+        return probe->transport->timestamp_ms(probe->ctx);
+    }
+    else
+    {
+        return (uint32_t)(a_probe_now_us() / 1000);
+    }
+}
+
+/**
+ * @brief     probe uart set the baud rate
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+static uint8_t a_probe_uart_set_baud_rate(void *ctx, uint32_t baud_rate)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    
+    if (probe->transport->uart_set_baud_rate == NULL)
+    {
+        return 1;
+    }
+    
+    return probe->transport->uart_set_baud_rate(probe->ctx, baud_rate);
+}
+
+/**
+ * @brief     probe uart drain
+ * @param[in] *ctx pointer to an as608 probe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart drain failed
+ * @note      none
+ */
+static uint8_t a_probe_uart_drain(void *ctx)
+{
+    as608_probe_t *probe = (as608_probe_t *)ctx;
+    
+    if (probe->transport->uart_drain == NULL)
+    {
+        return 0;
+    }
+    
+    return probe->transport->uart_drain(probe->ctx);
+}
+
+/**
+ * @brief probe transport definition
+ */
+static const as608_transport_t gs_probe_transport =
+{
+    .uart_init = a_probe_uart_init,
+    .uart_deinit = a_probe_uart_deinit,
+    .uart_read = a_probe_uart_read,
+    .uart_flush = a_probe_uart_flush,
+    .uart_write = a_probe_uart_write,
+    .delay_ms = a_probe_delay_ms,
+    .timestamp_ms = a_probe_timestamp_ms,
+    .uart_set_baud_rate = a_probe_uart_set_baud_rate,
+    .uart_writev = a_probe_uart_writev,
+    .uart_drain = a_probe_uart_drain,
+};
+
+/**
+ * @brief     as608 probe init
+ * @param[in] *probe pointer to an as608 probe structure
+ * @param[in] *transport pointer to the inner transport
+ * @param[in] *ctx pointer to the inner transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t as608_probe_init(as608_probe_t *probe, const as608_transport_t *transport, void *ctx)
+{
+    if ((probe == NULL) || (transport == NULL))
+    {
+        return 1;
+    }
+    
+    memset(probe, 0, sizeof(as608_probe_t));
+    probe->transport = transport;
+    probe->ctx = ctx;
+    
+    return 0;
+}
+
+/**
+ * @brief  as608 probe get the transport
+ * @return pointer to the probe transport
+ * @note   link it with an as608 probe structure as the context
+ */
+const as608_transport_t *as608_probe_transport(void)
+{
+    return &gs_probe_transport;
+}
+
+/**
+ * @brief     as608 probe begin a call
+ * @param[in] *probe pointer to an as608 probe structure
+ * @note      the phase time is cleared
+ */
+void as608_probe_begin(as608_probe_t *probe)
+{
+    memset(&probe->phase, 0, sizeof(as608_probe_phase_t));
+    probe->waiting = 0;
+    probe->receiving = 0;
+}
+
+/**
+ * @brief      as608 probe end a call
+ * @param[in]  *probe pointer to an as608 probe structure
+ * @param[out] *phase pointer to a phase structure
+ * @note       none
+ */
+void as608_probe_end(as608_probe_t *probe, as608_probe_phase_t *phase)
+{
+    a_probe_close(probe);
+    *phase = probe->phase;
+}
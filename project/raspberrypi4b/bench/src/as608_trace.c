@@ -0,0 +1,448 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_trace.c
+ * @brief     as608 trace recorder and replay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "as608_trace.h"
+#include <string.h>
+
+/**
+ * @brief trace file magic definition
+ */
+static const uint8_t gsc_trace_magic[4] = {'A', '6', 'T', 'R'};
+
+/**
+ * @brief trace file version definition
+ */
+#define TRACE_VERSION    1
+
+/**
+ * @brief     trace put a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] value input value
+ * @param[in] len value length
+ * @note      none
+ */
+static void a_trace_put(uint8_t *buf, uint32_t value, uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (value >> (8 * i)) & 0xFF;
+    }
+}
+
+/**
+ * @brief     trace get a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len value length
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_trace_get(uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint32_t value;
+    
+    value = 0;
+    for (i = 0; i < len; i++)
+    {
+        value |= (uint32_t)buf[i] << (8 * i);
+    }
+    
+    return value;
+}
+
+/**
+ * @brief     as608 trace recorder init
+ * @param[in] *recorder pointer to an as608 trace recorder structure
+ * @param[in] *fp pointer to an opened trace file
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the file header is written
+ */
+uint8_t as608_trace_recorder_init(as608_trace_recorder_t *recorder, FILE *fp)
+{
+    uint8_t header[AS608_TRACE_FILE_HEADER_LEN];
+    
+    if ((recorder == NULL) || (fp == NULL))
+    {
+        return 1;
+    }
+    
+    memset(recorder, 0, sizeof(as608_trace_recorder_t));
+    recorder->fp = fp;
+    memset(header, 0, AS608_TRACE_FILE_HEADER_LEN);
+    memcpy(header, gsc_trace_magic, 4);
+    header[4] = TRACE_VERSION;
+    if (fwrite(header, 1, AS608_TRACE_FILE_HEADER_LEN, fp) != AS608_TRACE_FILE_HEADER_LEN)
+    {
+        return 1;
+    }
+    recorder->bytes = AS608_TRACE_FILE_HEADER_LEN;
+    
+    return 0;
+}
+
+/**
+ * @brief     as608 trace record one frame
+ * @param[in] *arg pointer to an as608 trace recorder structure
+ * @param[in] *frame pointer to a trace frame
+ * @note      link it with as608_set_trace
+ */
+void as608_trace_record(void *arg, as608_trace_frame_t *frame)
+{
+    as608_trace_recorder_t *recorder = (as608_trace_recorder_t *)arg;
+    uint8_t header[AS608_TRACE_RECORD_HEADER_LEN];
+    
+    a_trace_put(&header[0], frame->timestamp_ms, 4);
+    header[4] = (uint8_t)frame->direction;
+    header[5] = frame->type;
+    header[6] = frame->command;
+    header[7] = 0;
+    a_trace_put(&header[8], frame->addr, 4);
+    a_trace_put(&header[12], frame->len, 2);
+    a_trace_put(&header[14], frame->sum, 2);
+    if ((fwrite(header, 1, AS608_TRACE_RECORD_HEADER_LEN, recorder->fp) != AS608_TRACE_RECORD_HEADER_LEN) ||
+        (fwrite(frame->payload, 1, frame->len, recorder->fp) != frame->len))
+    {
+        recorder->error = 1;
+        
+        return;
+    }
+    recorder->frames++;
+    recorder->bytes += AS608_TRACE_RECORD_HEADER_LEN + frame->len;
+}
+
+/**
+ * @brief         as608 trace read the next record
+ * @param[in]     *buf pointer to a trace buffer
+ * @param[in]     size trace size
+ * @param[in,out] *point pointer to a record point buffer
+ * @param[out]    *frame pointer to a trace frame buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 end of the trace
+ *                - 2 record is broken
+ * @note          payload points into buf, the point of a new trace is AS608_TRACE_FILE_HEADER_LEN
+ */
+uint8_t as608_trace_next(uint8_t *buf, uint32_t size, uint32_t *point, as608_trace_frame_t *frame)
+{
+    uint8_t *p;
+    
+    if (*point >= size)
+    {
+        return 1;
+    }
+    if ((size - *point) < AS608_TRACE_RECORD_HEADER_LEN)
+    {
+        return 2;
+    }
+    
+    p = buf + *point;
+    frame->timestamp_ms = a_trace_get(&p[0], 4);
+    frame->direction = (as608_trace_direction_t)p[4];
+    frame->type = p[5];
+    frame->command = p[6];
+    frame->addr = a_trace_get(&p[8], 4);
+    frame->len = (uint16_t)a_trace_get(&p[12], 2);
+    frame->sum = (uint16_t)a_trace_get(&p[14], 2);
+    frame->payload = &p[AS608_TRACE_RECORD_HEADER_LEN];
+    if ((frame->len > (384 - 11)) || 
+        ((size - *point - AS608_TRACE_RECORD_HEADER_LEN) < frame->len))
+    {
+        return 2;
+    }
+    *point += AS608_TRACE_RECORD_HEADER_LEN + frame->len;
+    
+    return 0;
+}
+
+/**
+ * @brief      as608 trace encode a frame to the wire bytes
+ * @param[in]  *frame pointer to a trace frame
+ * @param[out] *buf pointer to a wire buffer
+ * @return     wire length
+ * @note       buf must hold len + 11 bytes
+ */
+uint16_t as608_trace_encode(as608_trace_frame_t *frame, uint8_t *buf)
+{
+    uint16_t l;
+    
+    l = frame->len + 2;
+    buf[0] = 0xEF;
+    buf[1] = 0x01;
+    buf[2] = (frame->addr >> 24) & 0xFF;
+    buf[3] = (frame->addr >> 16) & 0xFF;
+    buf[4] = (frame->addr >> 8) & 0xFF;
+    buf[5] = (frame->addr >> 0) & 0xFF;
+    buf[6] = frame->type;
+    buf[7] = (l >> 8) & 0xFF;
+    buf[8] = (l >> 0) & 0xFF;
+    memcpy(&buf[9], frame->payload, frame->len);
+    buf[9 + frame->len] = (frame->sum >> 8) & 0xFF;
+    buf[10 + frame->len] = (frame->sum >> 0) & 0xFF;
+    
+    return frame->len + 11;
+}
+
+/**
+ * @brief     replay uart init
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_replay_uart_init(void *ctx)
+{
+    (void)ctx;
+    
+    return 0;
+}
+
+/**
+ * @brief     replay uart deinit
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_replay_uart_deinit(void *ctx)
+{
+    (void)ctx;
+    
+    return 0;
+}
+
+/**
+ * @brief      replay uart read
+ * @param[in]  *ctx pointer to an as608 trace replay structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       a received frame is read when the virtual clock reaches its recorded delay
+ */
+static uint16_t a_replay_uart_read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    as608_trace_replay_t *replay = (as608_trace_replay_t *)ctx;
+    as608_trace_frame_t frame;
+    uint32_t point;
+    uint16_t l;
+    uint16_t n;
+    
+    l = 0;
+    while (l < len)
+    {
+        if (replay->frame_point < replay->frame_len)
+        {
+            n = replay->frame_len - replay->frame_point;
+            n = (n < (len - l)) ? n : (len - l);
+            memcpy(buf + l, &replay->frame[replay->frame_point], n);
+            replay->frame_point += n;
+            l += n;
+            
+            continue;
+        }
+        
+        /* the next received frame is read when it is due */
+        point = replay->point;
+        if ((as608_trace_next(replay->buf, replay->size, &point, &frame) != 0) ||
+            (frame.direction != AS608_TRACE_DIRECTION_RX) ||
+            ((int32_t)(replay->clock - (replay->base + frame.timestamp_ms)) < 0))
+        {
+            break;
+        }
+        replay->point = point;
+        replay->frame_len = as608_trace_encode(&frame, replay->frame);
+        replay->frame_point = 0;
+        replay->received++;
+    }
+    
+    return l;
+}
+
+/**
+ * @brief     replay uart flush
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @return    status code
+ *            - 0 success
+ * @note      the frame in reading is dropped
+ */
+static uint8_t a_replay_uart_flush(void *ctx)
+{
+    as608_trace_replay_t *replay = (as608_trace_replay_t *)ctx;
+    
+    replay->frame_len = 0;
+    replay->frame_point = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     replay uart write
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ * @note      the received frames before the next sent frame are skipped and
+ *            the written bytes are compared with the sent frame
+ */
+static uint8_t a_replay_uart_write(void *ctx, uint8_t *buf, uint16_t len)
+{
+    as608_trace_replay_t *replay = (as608_trace_replay_t *)ctx;
+    as608_trace_frame_t frame;
+    uint8_t wire[384];
+    
+    while (as608_trace_next(replay->buf, replay->size, &replay->point, &frame) == 0)
+    {
+        if (frame.direction == AS608_TRACE_DIRECTION_TX)
+        {
+            replay->base = replay->clock - frame.timestamp_ms;
+            replay->sent++;
+            if ((as608_trace_encode(&frame, wire) != len) || (memcmp(wire, buf, len) != 0))
+            {
+                replay->mismatched++;
+            }
+            
+            return 0;
+        }
+    }
+    
+    /* the trace is over */
+    replay->point = replay->size;
+    replay->mismatched++;
+    
+    return 0;
+}
+
+/**
+ * @brief     replay delay ms
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @param[in] ms time
+ * @note      the virtual clock adds ms
+ */
+static void a_replay_delay_ms(void *ctx, uint32_t ms)
+{
+    as608_trace_replay_t *replay = (as608_trace_replay_t *)ctx;
+    
+    replay->clock += ms;
+}
+
+/**
+ * @brief     replay timestamp ms
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @return    virtual time in ms
+ * @note      none
+ */
+static uint32_t a_replay_timestamp_ms(void *ctx)
+{
+    as608_trace_replay_t *replay = (as608_trace_replay_t *)ctx;
+    
+    return replay->clock;
+}
+
+/**
+ * @brief     replay uart set the baud rate
+ * @param[in] *ctx pointer to an as608 trace replay structure
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_replay_uart_set_baud_rate(void *ctx, uint32_t baud_rate)
+{
+    (void)ctx;
+    (void)baud_rate;
+    
+    return 0;
+}
+
+/**
+ * @brief replay transport definition
+ */
+static const as608_transport_t gs_replay_transport =
+{
+    .uart_init = a_replay_uart_init,
+    .uart_deinit = a_replay_uart_deinit,
+    .uart_read = a_replay_uart_read,
+    .uart_flush = a_replay_uart_flush,
+    .uart_write = a_replay_uart_write,
+    .delay_ms = a_replay_delay_ms,
+    .timestamp_ms = a_replay_timestamp_ms,
+    .uart_set_baud_rate = a_replay_uart_set_baud_rate,
+};
+
+/**
+ * @brief     as608 trace replay init
+ * @param[in] *replay pointer to an as608 trace replay structure
+ * @param[in] *buf pointer to a trace buffer
+ * @param[in] size trace size
+ * @return    status code
+ *            - 0 success
+ *            - 1 trace is invalid
+ * @note      buf must be kept until the replay ends
+ */
+uint8_t as608_trace_replay_init(as608_trace_replay_t *replay, uint8_t *buf, uint32_t size)
+{
+    if ((replay == NULL) || (buf == NULL) || (size < AS608_TRACE_FILE_HEADER_LEN))
+    {
+        return 1;
+    }
+    if ((memcmp(buf, gsc_trace_magic, 4) != 0) || (buf[4] != TRACE_VERSION))
+    {
+        return 1;
+    }
+    
+    memset(replay, 0, sizeof(as608_trace_replay_t));
+    replay->buf = buf;
+    replay->size = size;
+    replay->point = AS608_TRACE_FILE_HEADER_LEN;
+    
+    return 0;
+}
+
+/**
+ * @brief  as608 trace replay get the transport
+ * @return pointer to the replay transport
+ * @note   link it with an as608 trace replay structure as the context,
+ *         every write moves to the next sent frame of the trace and the received frames after it
+ *         are read at their recorded delay on a virtual clock, so delay_ms never sleeps
+ */
+const as608_transport_t *as608_trace_replay_transport(void)
+{
+    return &gs_replay_transport;
+}
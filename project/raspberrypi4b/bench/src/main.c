@@ -0,0 +1,1183 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     bench main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+#include "driver_as608_interface.h"
+#include "raspberrypi4b_driver_as608_interface.h"
+#include "as608_emulator.h"
+#include "as608_fault.h"
+#include "as608_probe.h"
+#include "as608_trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief bench phase number definition
+ */
+#define BENCH_PHASE_NUM    5
+
+/**
+ * @brief bench api structure definition
+ */
+typedef struct bench_api_s
+{
+    const char *name;                       /**< api name */
+    uint8_t (*run)(void);                   /**< point to a run function address */
+    uint8_t enable;                         /**< enable flag */
+    uint32_t count;                         /**< successful calls */
+    uint32_t failed;                        /**< failed attempts */
+    uint64_t retry_us;                      /**< time spent in the failed attempts */
+    uint32_t *sample[BENCH_PHASE_NUM];      /**< samples of every phase in us */
+} bench_api_t;
+
+/**
+ * @brief uart transport definition
+ */
+static const as608_transport_t gs_transport =
+{
+    .uart_init = as608_interface_transport_uart_init,
+    .uart_deinit = as608_interface_transport_uart_deinit,
+    .uart_read = as608_interface_transport_uart_read,
+    .uart_flush = as608_interface_transport_uart_flush,
+    .uart_write = as608_interface_transport_uart_write,
+    .delay_ms = as608_interface_transport_delay_ms,
+    .timestamp_ms = as608_interface_transport_timestamp_ms,
+    .uart_set_baud_rate = as608_interface_transport_uart_set_baud_rate,
+    .uart_writev = as608_interface_transport_uart_writev,
+    .uart_drain = as608_interface_transport_uart_drain,
+};
+
+/**
+ * @brief phase name definition
+ */
+static const char *const gsc_phase[BENCH_PHASE_NUM] = {"total", "write", "wait", "receive", "sleep"};
+
+/**
+ * @brief global var definition
+ */
+static as608_handle_t gs_handle;                            /**< as608 handle */
+static as608_fault_t gs_fault;                              /**< fault transport */
+static as608_probe_t gs_probe;                              /**< probe transport */
+static as608_stats_t gs_stats;                              /**< driver stats */
+static as608_stats_t gs_snapshot;                           /**< driver stats snapshot */
+static as608_trace_recorder_t gs_recorder;                  /**< trace recorder */
+static as608_trace_replay_t gs_replay;                      /**< trace replay */
+static uint8_t gs_tracing = 0;                              /**< tracing flag */
+static uint8_t gs_replaying = 0;                            /**< replaying flag */
+static as608_emulator_t gs_emu;                             /**< built-in emulator */
+static volatile uint8_t gs_emu_stop = 0;                    /**< emulator stop flag */
+static uint8_t gs_verbose = 0;                              /**< verbose flag */
+static uint32_t gs_addr = 0xFFFFFFFF;                       /**< chip address */
+static uint8_t gs_image[AS608_EMULATOR_IMAGE_SIZE];         /**< image buffer */
+static uint16_t gs_image_len = 0;                           /**< image length */
+static uint8_t gs_feature[AS608_EMULATOR_FEATURE_SIZE];     /**< feature buffer */
+static as608_best_identify_t gs_best;                      /**< best identify statistics */
+
+/**
+ * @brief     bench print format data
+ * @param[in] fmt format data
+ * @note      the driver messages are only printed in the verbose mode
+ */
+static void a_bench_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    if (gs_verbose == 0)
+    {
+        return;
+    }
+    va_start(args, fmt);
+    (void)vsnprintf(str, 256, fmt, args);
+    va_end(args);
+    (void)fprintf(stderr, "%s", str);
+}
+
+/**
+ * @brief  get the monotonic time
+ * @return time in us
+ * @note   none
+ */
+static uint64_t a_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief      load a file
+ * @param[in]  *path pointer to a file path
+ * @param[out] **buf pointer to a buffer pointer
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       free the buffer after use
+ */
+static uint8_t a_load(const char *path, uint8_t **buf, uint32_t *size)
+{
+    long l;
+    FILE *fp;
+    
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    (void)fseek(fp, 0, SEEK_END);
+    l = ftell(fp);
+    (void)fseek(fp, 0, SEEK_SET);
+    *buf = (uint8_t *)malloc((l > 0) ? (size_t)l : 1);
+    if ((l < 0) || (*buf == NULL) || (fread(*buf, 1, (size_t)l, fp) != (size_t)l))
+    {
+        free(*buf);
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    *size = (uint32_t)l;
+    (void)fclose(fp);
+    
+    return 0;
+}
+
+/**
+ * @brief     parse a percent
+ * @param[in] *str pointer to a string buffer
+ * @return    probability in ppm
+ * @note      none
+ */
+static uint32_t a_ppm(const char *str)
+{
+    double p;
+    
+    p = atof(str);
+    p = (p < 0.0) ? 0.0 : p;
+    p = (p > 100.0) ? 100.0 : p;
+    
+    return (uint32_t)(p * 10000.0 + 0.5);
+}
+
+/**
+ * @brief  run get image
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_get_image(void)
+{
+    as608_status_t status;
+    
+    return as608_get_image(&gs_handle, gs_addr, &status);
+}
+
+/**
+ * @brief  run generate feature
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_generate_feature(void)
+{
+    as608_status_t status;
+    
+    return as608_generate_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_1, &status);
+}
+
+/**
+ * @brief  run search feature
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_search_feature(void)
+{
+    uint16_t found_page;
+    uint16_t score;
+    as608_status_t status;
+    
+    return as608_search_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_1, 0, 300, &found_page, &score, &status);
+}
+
+/**
+ * @brief  run high speed search
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_high_speed_search(void)
+{
+    uint16_t found_page;
+    uint16_t score;
+    as608_status_t status;
+    
+    return as608_high_speed_search(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_1, 0, 300, &found_page, &score, &status);
+}
+
+/**
+ * @brief  run identify
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_identify(void)
+{
+    uint16_t page_number;
+    uint16_t score;
+    as608_status_t status;
+    
+    return as608_identify(&gs_handle, gs_addr, &page_number, &score, &status);
+}
+
+/**
+ * @brief  run best identify
+ * @return result code
+ * @note   the statistics are learned across the runs
+ */
+static uint8_t a_run_best_identify(void)
+{
+    uint16_t page_number;
+    uint16_t score;
+    as608_status_t status;
+    
+    return as608_best_identify(&gs_handle, &gs_best, gs_addr, 0, 300, &page_number, &score, &status);
+}
+
+/**
+ * @brief  run upload feature
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_upload_feature(void)
+{
+    uint16_t len;
+    as608_status_t status;
+    
+    len = sizeof(gs_feature);
+    
+    return as608_upload_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_1, gs_feature, &len, &status);
+}
+
+/**
+ * @brief  run upload image
+ * @return result code
+ * @note   the uploaded image is used by the download image
+ */
+static uint8_t a_run_upload_image(void)
+{
+    uint8_t res;
+    uint16_t len;
+    as608_status_t status;
+    
+    len = sizeof(gs_image);
+    res = as608_upload_image(&gs_handle, gs_addr, gs_image, &len, &status);
+    if (res == 0)
+    {
+        gs_image_len = len;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  run download image
+ * @return result code
+ * @note   none
+ */
+static uint8_t a_run_download_image(void)
+{
+    as608_status_t status;
+    
+    return as608_download_image(&gs_handle, gs_addr, gs_image, gs_image_len, &status);
+}
+
+/**
+ * @brief api list definition
+ */
+static bench_api_t gs_api[] =
+{
+    {"get_image", a_run_get_image, 1, 0, 0, 0, {NULL}},
+    {"generate_feature", a_run_generate_feature, 1, 0, 0, 0, {NULL}},
+    {"search_feature", a_run_search_feature, 1, 0, 0, 0, {NULL}},
+    {"high_speed_search", a_run_high_speed_search, 1, 0, 0, 0, {NULL}},
+    {"identify", a_run_identify, 1, 0, 0, 0, {NULL}},
+    {"best_identify", a_run_best_identify, 1, 0, 0, 0, {NULL}},
+    {"upload_feature", a_run_upload_feature, 1, 0, 0, 0, {NULL}},
+    {"upload_image", a_run_upload_image, 1, 0, 0, 0, {NULL}},
+    {"download_image", a_run_download_image, 1, 0, 0, 0, {NULL}},
+};
+
+/**
+ * @brief     emulator write all bytes
+ * @param[in] fd pty master handle
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @note      it gives up when the emulator stops
+ */
+static void a_emulator_write(int fd, uint8_t *buf, uint32_t len)
+{
+    struct pollfd pfd;
+    ssize_t n;
+    
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+    while ((len != 0) && (gs_emu_stop == 0))
+    {
+        n = write(fd, buf, len);
+        if (n > 0)
+        {
+            buf += n;
+            len -= (uint32_t)n;
+        }
+        else if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            return;
+        }
+        else
+        {
+            (void)poll(&pfd, 1, 10);
+        }
+    }
+}
+
+/**
+ * @brief     emulator thread
+ * @param[in] *arg pointer to a pty master handle
+ * @return    NULL
+ * @note      the responses are sent at the pty speed after the command latency
+ */
+static void *a_emulator_thread(void *arg)
+{
+    int fd = *(int *)arg;
+    uint8_t buf[512];
+    uint32_t l;
+    uint32_t delay;
+    ssize_t n;
+    struct pollfd pfd;
+    
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    while (gs_emu_stop == 0)
+    {
+        if ((poll(&pfd, 1, 10) > 0) && ((pfd.revents & POLLIN) != 0))
+        {
+            n = read(fd, buf, sizeof(buf));
+            if (n > 0)
+            {
+                (void)as608_emulator_input(&gs_emu, buf, (uint32_t)n, &delay);
+                if (delay != 0)
+                {
+                    (void)usleep(delay * 1000);
+                }
+            }
+        }
+        while ((l = as608_emulator_output(&gs_emu, buf, sizeof(buf))) != 0)
+        {
+            a_emulator_write(fd, buf, l);
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief      emulator start
+ * @param[out] *master pointer to a pty master handle buffer
+ * @param[out] *slave pointer to a pty slave handle buffer
+ * @param[out] *thread pointer to a thread buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ * @note       the slave is kept open, so the master does not fail when the driver closes the port
+ */
+static uint8_t a_emulator_start(int *master, int *slave, pthread_t *thread)
+{
+    struct termios cfg;
+    
+    *master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((*master) < 0)
+    {
+        perror("bench: open pty failed.\n");
+        
+        return 1;
+    }
+    if ((grantpt(*master) != 0) || (unlockpt(*master) != 0))
+    {
+        perror("bench: unlock pty failed.\n");
+        (void)close(*master);
+        
+        return 1;
+    }
+    *slave = open(ptsname(*master), O_RDWR | O_NOCTTY);
+    if ((*slave) < 0)
+    {
+        perror("bench: open slave failed.\n");
+        (void)close(*master);
+        
+        return 1;
+    }
+    if (tcgetattr(*slave, &cfg) == 0)
+    {
+        cfmakeraw(&cfg);
+        (void)tcsetattr(*slave, TCSANOW, &cfg);
+    }
+    (void)fcntl(*master, F_SETFL, fcntl(*master, F_GETFL, 0) | O_NONBLOCK);
+    if (pthread_create(thread, NULL, a_emulator_thread, master) != 0)
+    {
+        perror("bench: create thread failed.\n");
+        (void)close(*slave);
+        (void)close(*master);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     compare two samples
+ * @param[in] *a pointer to a sample
+ * @param[in] *b pointer to a sample
+ * @return    compare result
+ * @note      none
+ */
+static int a_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     get a percentile of the sorted samples
+ * @param[in] *sample pointer to the sorted samples
+ * @param[in] count sample count
+ * @param[in] p percentile
+ * @return    percentile value
+ * @note      nearest rank
+ */
+static uint32_t a_percentile(uint32_t *sample, uint32_t count, uint32_t p)
+{
+    uint32_t rank;
+    
+    if (count == 0)
+    {
+        return 0;
+    }
+    rank = (count * p + 99) / 100;
+    rank = (rank == 0) ? 1 : rank;
+    
+    return sample[rank - 1];
+}
+
+/**
+ * @brief     get the mean of the samples
+ * @param[in] *sample pointer to the samples
+ * @param[in] count sample count
+ * @return    mean value
+ * @note      none
+ */
+static double a_mean(uint32_t *sample, uint32_t count)
+{
+    uint32_t i;
+    double sum = 0.0;
+    
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    for (i = 0; i < count; i++)
+    {
+        sum += sample[i];
+    }
+    
+    return sum / count;
+}
+
+/**
+ * @brief     output the result in csv
+ * @param[in] *fp pointer to a file
+ * @note      none
+ */
+static void a_output_csv(FILE *fp)
+{
+    uint32_t i;
+    uint32_t k;
+    bench_api_t *api;
+    
+    fprintf(fp, "api,phase,count,failed,retry_us,mean_us,p50_us,p95_us,p99_us,max_us\n");
+    for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+    {
+        api = &gs_api[i];
+        if (api->enable == 0)
+        {
+            continue;
+        }
+        for (k = 0; k < BENCH_PHASE_NUM; k++)
+        {
+            fprintf(fp, "%s,%s,%u,%u,%llu,%.1f,%u,%u,%u,%u\n", api->name, gsc_phase[k], api->count, api->failed,
+                    (unsigned long long)api->retry_us, a_mean(api->sample[k], api->count),
+                    a_percentile(api->sample[k], api->count, 50), a_percentile(api->sample[k], api->count, 95),
+                    a_percentile(api->sample[k], api->count, 99), a_percentile(api->sample[k], api->count, 100));
+        }
+    }
+}
+
+/**
+ * @brief     output the result in json
+ * @param[in] *fp pointer to a file
+ * @param[in] *uart pointer to a uart context
+ * @param[in] times run times
+ * @param[in] retry max retries
+ * @note      none
+ */
+static void a_output_json(FILE *fp, raspberrypi4b_as608_uart_ctx_t *uart, uint32_t times, uint32_t retry)
+{
+    uint32_t i;
+    uint32_t k;
+    uint32_t n;
+    bench_api_t *api;
+    
+    fprintf(fp, "{\n  \"device\": \"%s\",\n  \"baud_rate\": %u,\n  \"times\": %u,\n  \"retry\": %u,\n", 
+            uart->name, uart->baud_rate, times, retry);
+    fprintf(fp, "  \"fault\": {\"dropped\": %u, \"flipped\": %u, \"tx_flipped\": %u, \"split\": %u, "
+            "\"coalesced\": %u, \"reordered\": %u, \"delayed\": %u, \"stalled\": %u},\n",
+            gs_fault.stats.dropped, gs_fault.stats.flipped, gs_fault.stats.tx_flipped, gs_fault.stats.split,
+            gs_fault.stats.coalesced, gs_fault.stats.reordered, gs_fault.stats.delayed, gs_fault.stats.stalled);
+    fprintf(fp, "  \"driver\": {\"byte_in\": %u, \"byte_out\": %u, \"sum\": %u, \"header\": %u, \"len\": %u, "
+            "\"type\": %u, \"addr\": %u, \"timeout\": %u},\n",
+            gs_snapshot.byte_in, gs_snapshot.byte_out, gs_snapshot.error[AS608_STATS_ERROR_SUM], 
+            gs_snapshot.error[AS608_STATS_ERROR_HEADER], gs_snapshot.error[AS608_STATS_ERROR_LEN], 
+            gs_snapshot.error[AS608_STATS_ERROR_TYPE], gs_snapshot.error[AS608_STATS_ERROR_ADDR], 
+            gs_snapshot.error[AS608_STATS_ERROR_TIMEOUT]);
+    fprintf(fp, "  \"uart\": {\"polls\": %u, \"reads\": %u},\n", uart->reader.polls, uart->reader.reads);
+    if (gs_tracing != 0)
+    {
+        fprintf(fp, "  \"trace\": {\"frames\": %u, \"bytes\": %u},\n", gs_recorder.frames, gs_recorder.bytes);
+    }
+    if (gs_replaying != 0)
+    {
+        fprintf(fp, "  \"replay\": {\"sent\": %u, \"received\": %u, \"mismatched\": %u},\n", 
+                gs_replay.sent, gs_replay.received, gs_replay.mismatched);
+    }
+    fprintf(fp, "  \"results\": [");
+    n = 0;
+    for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+    {
+        api = &gs_api[i];
+        if (api->enable == 0)
+        {
+            continue;
+        }
+        fprintf(fp, "%s\n    {\"api\": \"%s\", \"count\": %u, \"failed\": %u, \"retry_us\": %llu,", 
+                (n != 0) ? "," : "", api->name, api->count, api->failed, (unsigned long long)api->retry_us);
+        for (k = 0; k < BENCH_PHASE_NUM; k++)
+        {
+            fprintf(fp, "%s\n     \"%s\": {\"mean_us\": %.1f, \"p50_us\": %u, \"p95_us\": %u, \"p99_us\": %u, \"max_us\": %u}",
+                    (k != 0) ? "," : "", gsc_phase[k], a_mean(api->sample[k], api->count),
+                    a_percentile(api->sample[k], api->count, 50), a_percentile(api->sample[k], api->count, 95),
+                    a_percentile(api->sample[k], api->count, 99), a_percentile(api->sample[k], api->count, 100));
+        }
+        fprintf(fp, "}");
+        n++;
+    }
+    fprintf(fp, "\n  ]\n}\n");
+}
+
+/**
+ * @brief     run an api
+ * @param[in] *api pointer to an api structure
+ * @param[in] times run times
+ * @param[in] retry max retries of one call
+ * @note      the phases of the failed attempts are not sampled
+ */
+static void a_run(bench_api_t *api, uint32_t times, uint32_t retry)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint64_t start;
+    as608_probe_phase_t phase;
+    
+    for (i = 0; i < times; i++)
+    {
+        res = 1;
+        for (j = 0; (j <= retry) && (res != 0); j++)
+        {
+            as608_probe_begin(&gs_probe);
+            start = a_now_us();
+            res = api->run();
+            start = a_now_us() - start;
+            as608_probe_end(&gs_probe, &phase);
+            if (res != 0)
+            {
+                api->failed++;
+                api->retry_us += start;
+                if (gs_verbose != 0)
+                {
+                    fprintf(stderr, "bench: %s returned %u.\n", api->name, res);
+                }
+            }
+        }
+        if (res == 0)
+        {
+            api->sample[0][api->count] = (uint32_t)start;
+            api->sample[1][api->count] = (uint32_t)phase.write_us;
+            api->sample[2][api->count] = (uint32_t)phase.wait_us;
+            api->sample[3][api->count] = (uint32_t)phase.receive_us;
+            api->sample[4][api->count] = (uint32_t)phase.sleep_us;
+            api->count++;
+        }
+    }
+    for (j = 0; j < BENCH_PHASE_NUM; j++)
+    {
+        qsort(api->sample[j], api->count, sizeof(uint32_t), a_compare);
+    }
+}
+
+/**
+ * @brief     select the apis
+ * @param[in] *list pointer to a comma separated api list
+ * @return    status code
+ *            - 0 success
+ *            - 1 api is invalid
+ * @note      none
+ */
+static uint8_t a_select(char *list)
+{
+    uint32_t i;
+    uint8_t found;
+    char *name;
+    char *save;
+    
+    if (strcmp(list, "all") == 0)
+    {
+        return 0;
+    }
+    for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+    {
+        gs_api[i].enable = 0;
+    }
+    for (name = strtok_r(list, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save))
+    {
+        found = 0;
+        for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+        {
+            if (strcmp(name, gs_api[i].name) == 0)
+            {
+                gs_api[i].enable = 1;
+                found = 1;
+            }
+        }
+        if (found == 0)
+        {
+            fprintf(stderr, "bench: %s is invalid.\n", name);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief help
+ * @note  none
+ */
+static void a_help(void)
+{
+    printf("Usage:\n");
+    printf("  as608_bench [--device=<path> | --emulator] [--baud=<rate>] [--addr=<address>] [--api=<list>]\n");
+    printf("              [--times=<num>] [--retry=<num>] [--format=<csv | json>] [--output=<path>]\n");
+    printf("              [--emulator-latency=<command>:<ms>] [--seed=<num>] [--drop=<percent>] [--flip=<percent>]\n");
+    printf("              [--tx-flip=<percent>] [--split=<len>] [--coalesce=<reads>] [--reorder=<percent>]\n");
+    printf("              [--latency=<ms>] [--stall=<percent>] [--stall-time=<ms>] [--trace=<path>]\n");
+    printf("              [--replay=<path>] [--verbose]\n");
+    printf("  as608_bench (-h | --help)\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --device=<path>               Set the uart device.([default: AS608_UART or /dev/ttyS0])\n");
+    printf("  --emulator                    Run against the built-in emulator on a pty.\n");
+    printf("  --baud=<rate>                 Set the uart baud rate.([default: 57600])\n");
+    printf("  --addr=<address>              Set the chip address in hex.([default: 0xFFFFFFFF])\n");
+    printf("  --api=<list>                  Set the comma separated apis, get_image, generate_feature, search_feature,\n");
+    printf("                                high_speed_search, identify, best_identify, upload_feature, upload_image,\n");
+    printf("                                download_image.\n");
+    printf("                                ([default: all])\n");
+    printf("  --times=<num>                 Set the run times of every api.([default: 100])\n");
+    printf("  --retry=<num>                 Set the max retries of one call.([default: 3])\n");
+    printf("  --format=<csv | json>         Set the output format.([default: csv])\n");
+    printf("  --output=<path>               Set the output file.([default: stdout])\n");
+    printf("  --emulator-latency=<command>:<ms>\n");
+    printf("                                Set the built-in emulator latency of one command, command is the code in hex.\n");
+    printf("  --seed=<num>                  Set the fault random seed.([default: 1])\n");
+    printf("  --drop=<percent>              Drop the received bytes.([default: 0])\n");
+    printf("  --flip=<percent>              Flip one bit of the received bytes.([default: 0])\n");
+    printf("  --tx-flip=<percent>           Flip one bit of the sent bytes.([default: 0])\n");
+    printf("  --split=<len>                 Split every read to 1 - len bytes.([default: 0])\n");
+    printf("  --coalesce=<reads>            Merge the reads while the bytes keep coming.([default: 0])\n");
+    printf("  --reorder=<percent>           Swap a read chunk with the next one.([default: 0])\n");
+    printf("  --latency=<ms>                Add the latency to every response.([default: 0])\n");
+    printf("  --stall=<percent>             Stall the responses.([default: 0])\n");
+    printf("  --stall-time=<ms>             Set the stall time.([default: 1000])\n");
+    printf("  --trace=<path>                Record every sent and received frame to a binary trace.\n");
+    printf("  --replay=<path>               Replay a trace instead of the uart, run with the same apis and times.\n");
+    printf("  --verbose                     Print the driver messages and the failed calls.\n");
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int master = -1;
+    int slave = -1;
+    uint8_t res;
+    uint8_t emulator = 0;
+    uint8_t json = 0;
+    uint32_t i;
+    uint32_t j;
+    uint32_t l;
+    uint32_t times = 100;
+    uint32_t retry = 3;
+    char *p;
+    char *output = NULL;
+    char *trace = NULL;
+    char *replay = NULL;
+    uint8_t *replay_buf = NULL;
+    uint32_t replay_size = 0;
+    FILE *fp = stdout;
+    FILE *trace_fp = NULL;
+    pthread_t thread;
+    as608_status_t status;
+    as608_fault_config_t config;
+    raspberrypi4b_as608_uart_ctx_t uart;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"device", required_argument, NULL, 1},
+        {"baud", required_argument, NULL, 2},
+        {"addr", required_argument, NULL, 3},
+        {"times", required_argument, NULL, 4},
+        {"retry", required_argument, NULL, 5},
+        {"seed", required_argument, NULL, 6},
+        {"drop", required_argument, NULL, 7},
+        {"flip", required_argument, NULL, 8},
+        {"tx-flip", required_argument, NULL, 9},
+        {"split", required_argument, NULL, 10},
+        {"coalesce", required_argument, NULL, 11},
+        {"reorder", required_argument, NULL, 12},
+        {"latency", required_argument, NULL, 13},
+        {"stall", required_argument, NULL, 14},
+        {"stall-time", required_argument, NULL, 15},
+        {"verbose", no_argument, NULL, 16},
+        {"emulator", no_argument, NULL, 17},
+        {"emulator-latency", required_argument, NULL, 18},
+        {"api", required_argument, NULL, 19},
+        {"format", required_argument, NULL, 20},
+        {"output", required_argument, NULL, 21},
+        {"trace", required_argument, NULL, 22},
+        {"replay", required_argument, NULL, 23},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* set the defaults */
+    memset(&config, 0, sizeof(as608_fault_config_t));
+    config.seed = 1;
+    config.stall_ms = 1000;
+    memset(&uart, 0, sizeof(raspberrypi4b_as608_uart_ctx_t));
+    uart.name = getenv("AS608_UART");
+    uart.name = (uart.name != NULL) ? uart.name : "/dev/ttyS0";
+    uart.baud_rate = 57600;
+    uart.fd = -1;
+    uart.poll_ms = 10;
+    (void)as608_emulator_init(&gs_emu, 0xFFFFFFFF);
+    
+    /* parse the args */
+    while ((c = getopt_long(argc, argv, short_options, long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 1 :
+            {
+                uart.name = optarg;
+                
+                break;
+            }
+            case 2 :
+            {
+                uart.baud_rate = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 3 :
+            {
+                gs_addr = (uint32_t)strtoul(optarg, NULL, 16);
+                
+                break;
+            }
+            case 4 :
+            {
+                times = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 5 :
+            {
+                retry = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 6 :
+            {
+                config.seed = (uint32_t)strtoul(optarg, NULL, 0);
+                
+                break;
+            }
+            case 7 :
+            {
+                config.drop_ppm = a_ppm(optarg);
+                
+                break;
+            }
+            case 8 :
+            {
+                config.flip_ppm = a_ppm(optarg);
+                
+                break;
+            }
+            case 9 :
+            {
+                config.tx_flip_ppm = a_ppm(optarg);
+                
+                break;
+            }
+            case 10 :
+            {
+                config.split_max = (uint16_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 11 :
+            {
+                config.coalesce = (uint8_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 12 :
+            {
+                config.reorder_ppm = a_ppm(optarg);
+                
+                break;
+            }
+            case 13 :
+            {
+                config.latency_ms = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 14 :
+            {
+                config.stall_ppm = a_ppm(optarg);
+                
+                break;
+            }
+            case 15 :
+            {
+                config.stall_ms = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 16 :
+            {
+                gs_verbose = 1;
+                
+                break;
+            }
+            case 17 :
+            {
+                emulator = 1;
+                
+                break;
+            }
+            case 18 :
+            {
+                l = (uint32_t)strtoul(optarg, &p, 16);
+                if ((*p != ':') || (l > 0xFF))
+                {
+                    a_help();
+                    
+                    return 1;
+                }
+                (void)as608_emulator_set_latency(&gs_emu, (uint8_t)l, (uint32_t)strtoul(p + 1, NULL, 10));
+                
+                break;
+            }
+            case 19 :
+            {
+                if (a_select(optarg) != 0)
+                {
+                    return 1;
+                }
+                
+                break;
+            }
+            case 20 :
+            {
+                if (strcmp(optarg, "json") == 0)
+                {
+                    json = 1;
+                }
+                else if (strcmp(optarg, "csv") == 0)
+                {
+                    json = 0;
+                }
+                else
+                {
+                    a_help();
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            case 21 :
+            {
+                output = optarg;
+                
+                break;
+            }
+            case 22 :
+            {
+                trace = optarg;
+                
+                break;
+            }
+            case 23 :
+            {
+                replay = optarg;
+                
+                break;
+            }
+            default :
+            {
+                a_help();
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    
+    /* load the trace to replay */
+    if (replay != NULL)
+    {
+        if ((emulator != 0) || (a_load(replay, &replay_buf, &replay_size) != 0) || 
+            (as608_trace_replay_init(&gs_replay, replay_buf, replay_size) != 0))
+        {
+            fprintf(stderr, "bench: replay %s failed.\n", replay);
+            free(replay_buf);
+            
+            return 1;
+        }
+        uart.name = replay;
+        gs_replaying = 1;
+    }
+    
+    /* open the trace to record */
+    if (trace != NULL)
+    {
+        trace_fp = fopen(trace, "wb");
+        if ((trace_fp == NULL) || (as608_trace_recorder_init(&gs_recorder, trace_fp) != 0))
+        {
+            fprintf(stderr, "bench: trace %s failed.\n", trace);
+            if (trace_fp != NULL)
+            {
+                (void)fclose(trace_fp);
+            }
+            free(replay_buf);
+            
+            return 1;
+        }
+        gs_tracing = 1;
+    }
+    
+    /* start the built-in emulator */
+    if (emulator != 0)
+    {
+        if (a_emulator_start(&master, &slave, &thread) != 0)
+        {
+            return 1;
+        }
+        uart.name = ptsname(master);
+    }
+    
+    /* link the probe over the fault transport over the uart or the replay */
+    if (gs_replaying != 0)
+    {
+        (void)as608_fault_init(&gs_fault, as608_trace_replay_transport(), &gs_replay, &config);
+    }
+    else
+    {
+        (void)as608_fault_init(&gs_fault, &gs_transport, &uart, &config);
+    }
+    (void)as608_probe_init(&gs_probe, as608_fault_transport(), &gs_fault);
+    DRIVER_AS608_LINK_INIT(&gs_handle, as608_handle_t);
+    DRIVER_AS608_LINK_DEBUG_PRINT(&gs_handle, a_bench_debug_print);
+    DRIVER_AS608_LINK_TRANSPORT(&gs_handle, as608_probe_transport(), &gs_probe);
+    (void)as608_set_stats(&gs_handle, &gs_stats);
+    if (gs_tracing != 0)
+    {
+        (void)as608_set_trace(&gs_handle, as608_trace_record, &gs_recorder);
+    }
+    
+    /* allocate the samples */
+    res = 0;
+    for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+    {
+        for (j = 0; j < BENCH_PHASE_NUM; j++)
+        {
+            gs_api[i].sample[j] = (uint32_t *)malloc(sizeof(uint32_t) * ((times != 0) ? times : 1));
+            res |= (gs_api[i].sample[j] == NULL);
+        }
+    }
+    
+    /* the best identify learns from the start */
+    (void)as608_best_identify_init(&gs_best);
+    
+    /* as608 init, it may also meet the faults */
+    for (j = 0; (j <= retry) && (res == 0); j++)
+    {
+        if (as608_init(&gs_handle, gs_addr) == 0)
+        {
+            break;
+        }
+    }
+    if ((res != 0) || (j > retry))
+    {
+        fprintf(stderr, "bench: init failed.\n");
+        res = 1;
+    }
+    else
+    {
+        /* prepare a feature and an image */
+        (void)as608_get_image(&gs_handle, gs_addr, &status);
+        (void)as608_generate_feature(&gs_handle, gs_addr, AS608_BUFFER_NUMBER_1, &status);
+        (void)a_run_upload_image();
+        (void)as608_reset_stats(&gs_handle);
+        
+        /* run the apis */
+        for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+        {
+            if (gs_api[i].enable != 0)
+            {
+                fprintf(stderr, "bench: run %s.\n", gs_api[i].name);
+                a_run(&gs_api[i], times, retry);
+                res |= (gs_api[i].count != times);
+            }
+        }
+        (void)as608_get_stats(&gs_handle, &gs_snapshot);
+        (void)as608_deinit(&gs_handle);
+        
+        /* output the result */
+        if (output != NULL)
+        {
+            fp = fopen(output, "w");
+            if (fp == NULL)
+            {
+                perror("bench: open output failed.\n");
+                fp = stdout;
+            }
+        }
+        if (json != 0)
+        {
+            a_output_json(fp, &uart, times, retry);
+        }
+        else
+        {
+            a_output_csv(fp);
+        }
+        if (fp != stdout)
+        {
+            (void)fclose(fp);
+        }
+    }
+    
+    /* stop the built-in emulator */
+    if (emulator != 0)
+    {
+        gs_emu_stop = 1;
+        (void)pthread_join(thread, NULL);
+        (void)close(slave);
+        (void)close(master);
+    }
+    if (trace_fp != NULL)
+    {
+        res |= gs_recorder.error;
+        (void)fclose(trace_fp);
+    }
+    if (gs_replaying != 0)
+    {
+        fprintf(stderr, "bench: replay sent %u, received %u, mismatched %u.\n", 
+                gs_replay.sent, gs_replay.received, gs_replay.mismatched);
+    }
+    free(replay_buf);
+    for (i = 0; i < sizeof(gs_api) / sizeof(gs_api[0]); i++)
+    {
+        for (j = 0; j < BENCH_PHASE_NUM; j++)
+        {
+            free(gs_api[i].sample[j]);
+        }
+    }
+    
+    return (res != 0) ? 1 : 0;
+}
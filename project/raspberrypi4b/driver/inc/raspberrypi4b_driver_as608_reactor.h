@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_as608_reactor.h
+ * @brief     raspberrypi4b driver as608 reactor header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_AS608_REACTOR_H
+#define RASPBERRYPI4B_DRIVER_AS608_REACTOR_H
+
+#include "raspberrypi4b_driver_as608_interface.h"
+#include "reactor.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup as608_reactor_driver as608 reactor driver function
+ * @brief    as608 reactor driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief raspberrypi4b as608 sensor structure definition
+ */
+typedef struct raspberrypi4b_as608_sensor_s
+{
+    as608_handle_t handle;                    /**< as608 handle */
+    raspberrypi4b_as608_uart_ctx_t uart;      /**< uart context */
+    reactor_event_t event;                    /**< reactor event */
+} raspberrypi4b_as608_sensor_t;
+
+/**
+ * @brief     sensor init
+ * @param[in] epfd reactor handle
+ * @param[in] *sensor pointer to a sensor structure
+ * @param[in] *name pointer to a uart device name buffer
+ * @param[in] baud_rate uart baud rate
+ * @param[in] addr chip address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the chip is initialized in blocking mode and then the uart is added to the reactor
+ */
+uint8_t raspberrypi4b_as608_sensor_init(int epfd, raspberrypi4b_as608_sensor_t *sensor, char *name, 
+                                        uint32_t baud_rate, uint32_t addr);
+
+/**
+ * @brief     sensor deinit
+ * @param[in] epfd reactor handle
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the command in flight is cancelled
+ */
+uint8_t raspberrypi4b_as608_sensor_deinit(int epfd, raspberrypi4b_as608_sensor_t *sensor);
+
+/**
+ * @brief     reactor wait and drive all sensors
+ * @param[in] epfd reactor handle
+ * @param[in] *sensor pointer to a sensor array
+ * @param[in] num sensor number
+ * @param[in] max_wait_ms max wait time in ms, -1 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the wait ends at the nearest command deadline, so every timeout fires on time,
+ *            a command is submitted with as608_async_submit(&sensor->handle, ...)
+ */
+uint8_t raspberrypi4b_as608_reactor_run_once(int epfd, raspberrypi4b_as608_sensor_t *sensor, uint32_t num, int max_wait_ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,8 +35,10 @@
  */
 
 #include "driver_as608_interface.h"
+#include "raspberrypi4b_driver_as608_interface.h"
 #include "uart.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief uart device name definition
@@ -44,20 +46,50 @@
 #define UART_DEVICE_NAME "/dev/ttyS0"        /**< uart device name */
 
 /**
- * @brief uart device handle definition
+ * @brief uart device environment definition
  */
-static int gs_fd;                           /**< uart handle */
+#define UART_DEVICE_ENV "AS608_UART"         /**< uart device environment name */
+
+/**
+ * @brief uart poll time definition
+ */
+#define UART_POLL_MS 10                      /**< 10ms */
+
+/**
+ * @brief uart io vector max count definition
+ */
+#define UART_IOV_MAX 4                       /**< 4 buffers */
+
+/**
+ * @brief uart device context definition
+ */
+static raspberrypi4b_as608_uart_ctx_t gs_ctx =
+{
+    .name = UART_DEVICE_NAME,
+    .baud_rate = 57600,
+    .fd = -1,
+    .poll_ms = UART_POLL_MS,
+};                                          /**< uart context */
 
 /**
  * @brief  interface uart init
  * @return status code
  *         - 0 success
  *         - 1 uart init failed
- * @note   none
+ * @note   the AS608_UART environment overrides the device name
  */
 uint8_t as608_interface_uart_init(void)
 {
-    return uart_init(UART_DEVICE_NAME, &gs_fd, 57600, 8, 'N', 1);
+    char *name;
+    
+    /* the device can be changed by the environment, e.g. to an emulator pty */
+    name = getenv(UART_DEVICE_ENV);
+    if (name != NULL)
+    {
+        gs_ctx.name = name;
+    }
+    
+    return as608_interface_transport_uart_init(&gs_ctx);
 }
 
 /**
@@ -69,7 +101,7 @@ uint8_t as608_interface_uart_init(void)
  */
 uint8_t as608_interface_uart_deinit(void)
 {
-    return uart_deinit(gs_fd);
+    return as608_interface_transport_uart_deinit(&gs_ctx);
 }
 
 /**
@@ -83,16 +115,7 @@ uint8_t as608_interface_uart_deinit(void)
  */
 uint16_t as608_interface_uart_read(uint8_t *buf, uint16_t len)
 {
-    uint32_t l = len;
-
-    if (uart_read(gs_fd, buf, (uint32_t *)&l))
-    {
-        return 0;
-    }
-    else
-    {
-        return l;
-    }
+    return as608_interface_transport_uart_read(&gs_ctx, buf, len);
 }
 
 /**
@@ -104,7 +127,32 @@ uint16_t as608_interface_uart_read(uint8_t *buf, uint16_t len)
  */
 uint8_t as608_interface_uart_flush(void)
 {
-    return uart_flush(gs_fd);
+    return as608_interface_transport_uart_flush(&gs_ctx);
+}
+
+/**
+ * @brief     interface uart set the baud rate
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+uint8_t as608_interface_uart_set_baud_rate(uint32_t baud_rate)
+{
+    return as608_interface_transport_uart_set_baud_rate(&gs_ctx, baud_rate);
+}
+
+/**
+ * @brief  interface uart drain
+ * @return status code
+ *         - 0 success
+ *         - 1 uart drain failed
+ * @note   none
+ */
+uint8_t as608_interface_uart_drain(void)
+{
+    return as608_interface_transport_uart_drain(&gs_ctx);
 }
 
 /**
@@ -118,7 +166,7 @@ uint8_t as608_interface_uart_flush(void)
  */
 uint8_t as608_interface_uart_write(uint8_t *buf, uint16_t len)
 {
-    return uart_write(gs_fd, buf, len);
+    return as608_interface_transport_uart_write(&gs_ctx, buf, len);
 }
 
 /**
@@ -131,6 +179,20 @@ void as608_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief  interface timestamp ms
+ * @return monotonic time in ms
+ * @note   none
+ */
+uint32_t as608_interface_timestamp_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -148,3 +210,189 @@ void as608_interface_debug_print(const char *const fmt, ...)
     
     (void)printf((uint8_t *)str);
 }
+
+/**
+ * @brief     interface transport uart init
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_init(void *ctx)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    
+    if (uart_init(uart->name, &uart->fd, uart->baud_rate, 8, 'N', 1) != 0)
+    {
+        return 1;
+    }
+    uart_reader_init(&uart->reader, uart->fd);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart deinit
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_deinit(void *ctx)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    
+    return uart_deinit(uart->fd);
+}
+
+/**
+ * @brief      interface transport uart read
+ * @param[in]  *ctx pointer to a transport context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       the bytes come from the buffered reader, which waits up to poll_ms by poll when it is empty
+ *             and drains the whole burst with one read
+ */
+uint16_t as608_interface_transport_uart_read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    uint32_t l = len;
+    
+    if (uart_reader_read(&uart->reader, buf, &l, uart->poll_ms))
+    {
+        return 0;
+    }
+    else
+    {
+        return l;
+    }
+}
+
+/**
+ * @brief     interface transport uart write
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_write(void *ctx, uint8_t *buf, uint16_t len)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    
+    return uart_write(uart->fd, buf, len);
+}
+
+/**
+ * @brief     interface transport uart flush
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_flush(void *ctx)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    
+    uart_reader_clear(&uart->reader);
+    
+    return uart_flush(uart->fd);
+}
+
+/**
+ * @brief     interface transport delay ms
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] ms time
+ * @note      none
+ */
+void as608_interface_transport_delay_ms(void *ctx, uint32_t ms)
+{
+    (void)ctx;
+    
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     interface transport timestamp ms
+ * @param[in] *ctx pointer to a transport context
+ * @return    monotonic time in ms
+ * @note      none
+ */
+uint32_t as608_interface_transport_timestamp_ms(void *ctx)
+{
+    (void)ctx;
+    
+    return as608_interface_timestamp_ms();
+}
+
+/**
+ * @brief     interface transport uart set the baud rate
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_set_baud_rate(void *ctx, uint32_t baud_rate)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    
+    if (uart_set_baud_rate(uart->fd, baud_rate) != 0)
+    {
+        return 1;
+    }
+    uart->baud_rate = baud_rate;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface transport uart writev
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are sent by one writev without being copied
+ */
+uint8_t as608_interface_transport_uart_writev(void *ctx, as608_iovec_t *iov, uint8_t count)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    struct iovec vec[UART_IOV_MAX];
+    uint8_t i;
+    
+    if (count > UART_IOV_MAX)
+    {
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        vec[i].iov_base = iov[i].buf;
+        vec[i].iov_len = iov[i].len;
+    }
+    
+    return uart_writev(uart->fd, vec, count);
+}
+
+/**
+ * @brief     interface transport uart drain
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart drain failed
+ * @note      it returns when the output queue is on the wire
+ */
+uint8_t as608_interface_transport_uart_drain(void *ctx)
+{
+    raspberrypi4b_as608_uart_ctx_t *uart = (raspberrypi4b_as608_uart_ctx_t *)ctx;
+    
+    return uart_drain(uart->fd);
+}
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_as608_reactor.c
+ * @brief     raspberrypi4b driver as608 reactor source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_as608_reactor.h"
+
+/**
+ * @brief uart transport definition
+ */
+static const as608_transport_t gs_transport =
+{
+    .uart_init = as608_interface_transport_uart_init,
+    .uart_deinit = as608_interface_transport_uart_deinit,
+    .uart_read = as608_interface_transport_uart_read,
+    .uart_flush = as608_interface_transport_uart_flush,
+    .uart_write = as608_interface_transport_uart_write,
+    .delay_ms = as608_interface_transport_delay_ms,
+    .timestamp_ms = as608_interface_transport_timestamp_ms,
+    .uart_set_baud_rate = as608_interface_transport_uart_set_baud_rate,
+    .uart_writev = as608_interface_transport_uart_writev,
+    .uart_drain = as608_interface_transport_uart_drain,
+};
+
+/**
+ * @brief     sensor event callback
+ * @param[in] *arg pointer to a sensor structure
+ * @param[in] events epoll events
+ * @note      none
+ */
+static void a_sensor_event(void *arg, uint32_t events)
+{
+    raspberrypi4b_as608_sensor_t *sensor = (raspberrypi4b_as608_sensor_t *)arg;
+    
+    (void)events;
+    
+    /* drive the command in flight */
+    if (sensor->handle.async_busy != 0)
+    {
+        (void)as608_async_poll(&sensor->handle, NULL);
+    }
+    else
+    {
+        /* drop the unexpected bytes, otherwise the level triggered event never stops */
+        (void)as608_interface_transport_uart_flush(&sensor->uart);
+    }
+}
+
+/**
+ * @brief     sensor init
+ * @param[in] epfd reactor handle
+ * @param[in] *sensor pointer to a sensor structure
+ * @param[in] *name pointer to a uart device name buffer
+ * @param[in] baud_rate uart baud rate
+ * @param[in] addr chip address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the chip is initialized in blocking mode and then the uart is added to the reactor
+ */
+uint8_t raspberrypi4b_as608_sensor_init(int epfd, raspberrypi4b_as608_sensor_t *sensor, char *name, 
+                                        uint32_t baud_rate, uint32_t addr)
+{
+    /* link the transport */
+    DRIVER_AS608_LINK_INIT(&sensor->handle, as608_handle_t);
+    DRIVER_AS608_LINK_DEBUG_PRINT(&sensor->handle, as608_interface_debug_print);
+    DRIVER_AS608_LINK_TRANSPORT(&sensor->handle, &gs_transport, &sensor->uart);
+    sensor->uart.name = name;
+    sensor->uart.baud_rate = baud_rate;
+    sensor->uart.fd = -1;
+    sensor->uart.poll_ms = 10;
+    
+    /* as608 init */
+    if (as608_init(&sensor->handle, addr) != 0)
+    {
+        return 1;
+    }
+    
+    /* add the uart to the reactor */
+    sensor->event.fd = sensor->uart.fd;
+    sensor->event.callback = a_sensor_event;
+    sensor->event.arg = sensor;
+    if (reactor_add(epfd, &sensor->event) != 0)
+    {
+        (void)as608_deinit(&sensor->handle);
+        
+        return 1;
+    }
+    
+    /* the reactor waits for the uart, so the reads never block */
+    sensor->uart.poll_ms = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     sensor deinit
+ * @param[in] epfd reactor handle
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the command in flight is cancelled
+ */
+uint8_t raspberrypi4b_as608_sensor_deinit(int epfd, raspberrypi4b_as608_sensor_t *sensor)
+{
+    uint8_t res;
+    
+    /* cancel the command in flight */
+    (void)as608_async_cancel(&sensor->handle);
+    
+    /* remove the uart from the reactor */
+    res = reactor_remove(epfd, &sensor->event);
+    
+    /* as608 deinit */
+    if (as608_deinit(&sensor->handle) != 0)
+    {
+        return 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     reactor wait and drive all sensors
+ * @param[in] epfd reactor handle
+ * @param[in] *sensor pointer to a sensor array
+ * @param[in] num sensor number
+ * @param[in] max_wait_ms max wait time in ms, -1 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the wait ends at the nearest command deadline, so every timeout fires on time,
+ *            a command is submitted with as608_async_submit(&sensor->handle, ...)
+ */
+uint8_t raspberrypi4b_as608_reactor_run_once(int epfd, raspberrypi4b_as608_sensor_t *sensor, uint32_t num, int max_wait_ms)
+{
+    uint32_t i;
+    uint32_t now;
+    uint32_t elapsed;
+    uint32_t count;
+    int wait;
+    
+    /* wait until the nearest deadline */
+    wait = max_wait_ms;
+    now = as608_interface_timestamp_ms();
+    for (i = 0; i < num; i++)
+    {
+        if (sensor[i].handle.async_busy != 0)
+        {
+            elapsed = now - sensor[i].handle.async_start;
+            if (elapsed >= sensor[i].handle.async_timeout_ms)
+            {
+                wait = 0;
+            }
+            else if ((wait < 0) || ((uint32_t)wait > (sensor[i].handle.async_timeout_ms - elapsed)))
+            {
+                wait = (int)(sensor[i].handle.async_timeout_ms - elapsed);
+            }
+            else
+            {
+                /* keep the nearer deadline */
+            }
+        }
+    }
+    
+    /* dispatch the readable uarts */
+    if (reactor_run_once(epfd, wait, &count) != 0)
+    {
+        return 1;
+    }
+    
+    /* fire the expired timeouts */
+    for (i = 0; i < num; i++)
+    {
+        if (sensor[i].handle.async_busy != 0)
+        {
+            (void)as608_async_poll(&sensor[i].handle, NULL);
+        }
+    }
+    
+    return 0;
+}
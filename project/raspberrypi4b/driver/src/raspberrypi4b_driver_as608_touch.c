@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_as608_touch.c
+ * @brief     raspberrypi4b driver as608 touch source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_as608_interface.h"
+#include "gpio.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief touch device name definition
+ */
+#define TOUCH_DEVICE_NAME "gpiochip0"        /**< touch gpio chip name */
+
+/**
+ * @brief touch device line definition
+ */
+#define TOUCH_DEVICE_LINE 17                 /**< touch gpio line */
+
+/**
+ * @brief touch device environment definition
+ */
+#define TOUCH_DEVICE_ENV "AS608_TOUCH"       /**< touch device environment name */
+
+/**
+ * @brief touch var definition
+ */
+static gpio_event_t gs_touch;                /**< touch gpio event */
+static uint8_t gs_touch_inited;              /**< touch inited flag */
+
+/**
+ * @brief  interface touch init
+ * @return status code
+ *         - 0 success
+ *         - 1 touch init failed
+ * @note   the touch output of the module is active high and wired to GPIO17 by default,
+ *         AS608_TOUCH=<chip>:<line> changes it and AS608_TOUCH=none disables it
+ */
+uint8_t as608_interface_touch_init(void)
+{
+    char name[32];
+    char *env;
+    char *p;
+    uint32_t line;
+    
+    /* the line can be changed by the environment */
+    strncpy(name, TOUCH_DEVICE_NAME, sizeof(name) - 1);
+    name[sizeof(name) - 1] = 0;
+    line = TOUCH_DEVICE_LINE;
+    env = getenv(TOUCH_DEVICE_ENV);
+    if (env != NULL)
+    {
+        if (strcmp(env, "none") == 0)
+        {
+            return 1;
+        }
+        p = strchr(env, ':');
+        if ((p == NULL) || ((size_t)(p - env) >= sizeof(name)))
+        {
+            return 1;
+        }
+        memcpy(name, env, (size_t)(p - env));
+        name[p - env] = 0;
+        line = (uint32_t)strtoul(p + 1, NULL, 10);
+    }
+    
+    /* a finger raises the touch output */
+    if (gpio_event_init(&gs_touch, name, line, 1) != 0)
+    {
+        return 1;
+    }
+    gs_touch_inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  interface touch deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 touch deinit failed
+ * @note   none
+ */
+uint8_t as608_interface_touch_deinit(void)
+{
+    if (gs_touch_inited == 0)
+    {
+        return 0;
+    }
+    gs_touch_inited = 0;
+    
+    return gpio_event_deinit(&gs_touch);
+}
+
+/**
+ * @brief     interface touch wait
+ * @param[in] ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      it returns at the touch edge, without the touch line it delays ms and returns 2
+ */
+uint8_t as608_interface_touch_wait(uint32_t ms)
+{
+    uint8_t res;
+    
+    if (gs_touch_inited == 0)
+    {
+        as608_interface_delay_ms(ms);
+        
+        return 2;
+    }
+    res = gpio_event_wait(&gs_touch, ms);
+    if (res == 1)
+    {
+        /* never spin on a broken line */
+        as608_interface_delay_ms(ms);
+    }
+    
+    return res;
+}
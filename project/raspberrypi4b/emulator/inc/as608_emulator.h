@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_emulator.h
+ * @brief     as608 emulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef AS608_EMULATOR_H
+#define AS608_EMULATOR_H
+
+#include "driver_as608.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup as608_emulator as608 emulator function
+ * @brief    as608 emulator function modules
+ * @{
+ */
+
+/**
+ * @brief as608 emulator library size definition
+ */
+#define AS608_EMULATOR_LIBRARY_SIZE    300
+
+/**
+ * @brief as608 emulator feature size definition
+ */
+#define AS608_EMULATOR_FEATURE_SIZE    512
+
+/**
+ * @brief as608 emulator image size definition
+ */
+#define AS608_EMULATOR_IMAGE_SIZE      (256 * 288 / 2)
+
+/**
+ * @brief as608 emulator output buffer size definition
+ */
+#define AS608_EMULATOR_OUTPUT_SIZE     (64 * 1024)
+
+/**
+ * @brief as608 emulator structure definition
+ */
+typedef struct as608_emulator_s
+{
+    uint32_t addr;                                                                      /**< chip address */
+    uint32_t password;                                                                  /**< password */
+    uint16_t level;                                                                     /**< level */
+    uint16_t packet_size;                                                               /**< packet size */
+    uint16_t n_9600;                                                                    /**< n times of 9600 */
+    uint8_t finger;                                                                     /**< finger present flag */
+    uint32_t finger_id;                                                                 /**< current finger id */
+    uint8_t image[AS608_EMULATOR_IMAGE_SIZE];                                           /**< image buffer */
+    uint8_t image_valid;                                                                /**< image valid flag */
+    uint8_t feature[2][AS608_EMULATOR_FEATURE_SIZE];                                    /**< feature buffers */
+    uint8_t library[AS608_EMULATOR_LIBRARY_SIZE][AS608_EMULATOR_FEATURE_SIZE];          /**< flash library */
+    uint8_t library_valid[AS608_EMULATOR_LIBRARY_SIZE];                                 /**< library valid flags */
+    uint8_t notepad[16][32];                                                            /**< notepad pages */
+    uint8_t info_page[512];                                                             /**< flash information page */
+    uint32_t latency_ms[256];                                                           /**< per command latency */
+    uint8_t frame[384];                                                                 /**< input frame buffer */
+    as608_parser_t parser;                                                              /**< input parser */
+    uint8_t *download_buf;                                                              /**< download destination */
+    uint32_t download_size;                                                             /**< download size */
+    uint32_t download_point;                                                            /**< download point */
+    uint8_t output[AS608_EMULATOR_OUTPUT_SIZE];                                         /**< output buffer */
+    uint32_t output_head;                                                               /**< output head */
+    uint32_t output_tail;                                                               /**< output tail */
+    uint32_t commands;                                                                  /**< executed commands */
+} as608_emulator_t;
+
+/**
+ * @brief     as608 emulator init
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] addr chip address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the library, the notepad and the image start empty and all latencies are 0
+ */
+uint8_t as608_emulator_init(as608_emulator_t *emu, uint32_t addr);
+
+/**
+ * @brief     as608 emulator set the command latency
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] command command code
+ * @param[in] ms processing latency in ms
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t as608_emulator_set_latency(as608_emulator_t *emu, uint8_t command, uint32_t ms);
+
+/**
+ * @brief     as608 emulator set the finger
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] present finger present flag
+ * @param[in] id finger id
+ * @return    status code
+ *            - 0 success
+ * @note      the same id always produces the same image and feature
+ */
+uint8_t as608_emulator_set_finger(as608_emulator_t *emu, uint8_t present, uint32_t id);
+
+/**
+ * @brief      as608 emulator input the received bytes
+ * @param[in]  *emu pointer to an as608 emulator structure
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] *delay_ms pointer to a response delay buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 output buffer is full
+ * @note       every complete command is executed and its response is queued,
+ *             delay_ms is the largest latency of the executed commands or 0 if none is executed
+ */
+uint8_t as608_emulator_input(as608_emulator_t *emu, uint8_t *buf, uint32_t len, uint32_t *delay_ms);
+
+/**
+ * @brief     as608 emulator take the queued output bytes
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    taken length
+ * @note      none
+ */
+uint32_t as608_emulator_output(as608_emulator_t *emu, uint8_t *buf, uint32_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
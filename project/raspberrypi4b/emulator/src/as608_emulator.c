@@ -0,0 +1,895 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      as608_emulator.c
+ * @brief     as608 emulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "as608_emulator.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief command code definition
+ */
+#define COMMAND_GET_IMAGE             0x01        /**< get image command */
+#define COMMAND_GEN_CHAR              0x02        /**< generate char command */
+#define COMMAND_MATCH                 0x03        /**< match command */
+#define COMMAND_SEARCH                0x04        /**< search command */
+#define COMMAND_REG_MODEL             0x05        /**< reg model command */
+#define COMMAND_STORE_CHAR            0x06        /**< store char command */
+#define COMMAND_LOAD_CHAR             0x07        /**< load char command */
+#define COMMAND_UP_CHAR               0x08        /**< up char command */
+#define COMMAND_DOWN_CHAR             0x09        /**< down char command */
+#define COMMAND_UP_IMAGE              0x0A        /**< up image command */
+#define COMMAND_DOWN_IMAGE            0x0B        /**< down image command */
+#define COMMAND_DELETE_CHAR           0x0C        /**< delete char command */
+#define COMMAND_EMPTY                 0x0D        /**< empty command */
+#define COMMAND_WRITE_REG             0x0E        /**< write reg command */
+#define COMMAND_READ_SYS_PARA         0x0F        /**< read sys para command */
+#define COMMAND_ENROLL                0x10        /**< enroll command */
+#define COMMAND_IDENTIFY              0x11        /**< identify command */
+#define COMMAND_SET_PWD               0x12        /**< set password command */
+#define COMMAND_VFY_PWD               0x13        /**< verify password command */
+#define COMMAND_GET_RANDOM_CODE       0x14        /**< get random code command */
+#define COMMAND_SET_CHIP_ADDR         0x15        /**< set chip addr command */
+#define COMMAND_READ_INFO_PAGE        0x16        /**< read info page command */
+#define COMMAND_PORT_CONTROL          0x17        /**< port control command */
+#define COMMAND_WRITE_NOTEPAD         0x18        /**< write notepad command */
+#define COMMAND_READ_NOTEPAD          0x19        /**< read notepad command */
+#define COMMAND_BURN_CODE             0x1A        /**< burn code command */
+#define COMMAND_HIGH_SPEED_SEARCH     0x1B        /**< high speed search command */
+#define COMMAND_GEN_BIN_IMAGE         0x1C        /**< generate bin image command */
+#define COMMAND_VALID_TEMPLATE_NUM    0x1D        /**< valid template num command */
+#define COMMAND_USER_GPIO             0x1E        /**< user gpio command */
+#define COMMAND_READ_INDEX_TABLE      0x1F        /**< read index table command */
+
+/**
+ * @brief frame type definition
+ */
+#define TYPE_COMMAND         0x01        /**< command type */
+#define TYPE_DATA            0x02        /**< data type */
+#define TYPE_RESPONSE        0x07        /**< response type */
+#define TYPE_END             0x08        /**< end type */
+
+/**
+ * @brief burn code buffer definition
+ */
+static uint8_t gs_burn_buf[AS608_EMULATOR_IMAGE_SIZE];        /**< burn code sink */
+
+/**
+ * @brief     emulator queue one frame
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] type frame type
+ * @param[in] *buf pointer to a payload buffer
+ * @param[in] len payload length
+ * @return    status code
+ *            - 0 success
+ *            - 1 output buffer is full
+ * @note      none
+ */
+static uint8_t a_emulator_queue(as608_emulator_t *emu, uint8_t type, uint8_t *buf, uint16_t len)
+{
+    uint8_t *p;
+    uint16_t i;
+    uint16_t sum;
+    uint16_t l;
+    
+    /* make room at the tail */
+    if ((emu->output_tail + len + 11) > AS608_EMULATOR_OUTPUT_SIZE)
+    {
+        memmove(emu->output, &emu->output[emu->output_head], emu->output_tail - emu->output_head);
+        emu->output_tail -= emu->output_head;
+        emu->output_head = 0;
+        if ((emu->output_tail + len + 11) > AS608_EMULATOR_OUTPUT_SIZE)
+        {
+            return 1;
+        }
+    }
+    
+    /* build the frame */
+    p = &emu->output[emu->output_tail];
+    l = len + 2;
+    p[0] = 0xEF;
+    p[1] = 0x01;
+    p[2] = (emu->addr >> 24) & 0xFF;
+    p[3] = (emu->addr >> 16) & 0xFF;
+    p[4] = (emu->addr >> 8) & 0xFF;
+    p[5] = (emu->addr >> 0) & 0xFF;
+    p[6] = type;
+    p[7] = (l >> 8) & 0xFF;
+    p[8] = (l >> 0) & 0xFF;
+    memcpy(&p[9], buf, len);
+    sum = 0;
+    for (i = 6; i < (len + 9); i++)
+    {
+        sum += p[i];
+    }
+    p[len + 9] = (sum >> 8) & 0xFF;
+    p[len + 10] = (sum >> 0) & 0xFF;
+    emu->output_tail += len + 11;
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator queue a data stream
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 output buffer is full
+ * @note      the data is split by the packet size and the last packet is an end packet
+ */
+static uint8_t a_emulator_queue_stream(as608_emulator_t *emu, uint8_t *buf, uint32_t len)
+{
+    uint32_t size;
+    uint32_t point;
+    uint32_t l;
+    
+    size = 32U << emu->packet_size;
+    point = 0;
+    while (point < len)
+    {
+        l = ((len - point) > size) ? size : (len - point);
+        if (a_emulator_queue(emu, ((point + l) < len) ? TYPE_DATA : TYPE_END, 
+                             buf + point, (uint16_t)l) != 0)
+        {
+            return 1;
+        }
+        point += l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator queue a response
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] status response status
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 output buffer is full
+ * @note      none
+ */
+static uint8_t a_emulator_respond(as608_emulator_t *emu, uint8_t status, uint8_t *buf, uint16_t len)
+{
+    uint8_t payload[64];
+    
+    payload[0] = status;
+    if (len != 0)
+    {
+        memcpy(&payload[1], buf, len);
+    }
+    
+    return a_emulator_queue(emu, TYPE_RESPONSE, payload, len + 1);
+}
+
+/**
+ * @brief      emulator fill a pseudo random buffer
+ * @param[in]  seed random seed
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @note       the same seed always gives the same data
+ */
+static void a_emulator_fill(uint32_t seed, uint8_t *buf, uint32_t len)
+{
+    uint32_t x;
+    uint32_t i;
+    
+    x = seed * 2654435761U + 1;
+    for (i = 0; i < len; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (uint8_t)(x >> 24);
+    }
+}
+
+/**
+ * @brief     emulator get the finger id of an image or a feature
+ * @param[in] *buf pointer to a data buffer
+ * @return    finger id
+ * @note      the id is saved in the first 4 bytes
+ */
+static uint32_t a_emulator_id(uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+/**
+ * @brief     emulator capture the image of the current finger
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @return    response status
+ * @note      none
+ */
+static uint8_t a_emulator_capture(as608_emulator_t *emu)
+{
+    if (emu->finger == 0)
+    {
+        return AS608_STATUS_NO_FINGERPRINT;
+    }
+    a_emulator_fill(emu->finger_id, emu->image, AS608_EMULATOR_IMAGE_SIZE);
+    emu->image[0] = (emu->finger_id >> 24) & 0xFF;
+    emu->image[1] = (emu->finger_id >> 16) & 0xFF;
+    emu->image[2] = (emu->finger_id >> 8) & 0xFF;
+    emu->image[3] = (emu->finger_id >> 0) & 0xFF;
+    emu->image_valid = 1;
+    
+    return AS608_STATUS_OK;
+}
+
+/**
+ * @brief     emulator generate the feature of the image
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] num buffer number
+ * @return    response status
+ * @note      none
+ */
+static uint8_t a_emulator_generate(as608_emulator_t *emu, uint8_t num)
+{
+    uint32_t id;
+    
+    if ((num != 1) && (num != 2))
+    {
+        return AS608_STATUS_BUFFER_INVALID;
+    }
+    if (emu->image_valid == 0)
+    {
+        return AS608_STATUS_IMAGE_TOO_FEW_FEATURE;
+    }
+    id = a_emulator_id(emu->image);
+    a_emulator_fill(~id, emu->feature[num - 1], AS608_EMULATOR_FEATURE_SIZE);
+    memcpy(emu->feature[num - 1], emu->image, 4);
+    
+    return AS608_STATUS_OK;
+}
+
+/**
+ * @brief     emulator get the match score of two features
+ * @param[in] *a pointer to a feature
+ * @param[in] *b pointer to a feature
+ * @return    score, 0 means not match
+ * @note      none
+ */
+static uint16_t a_emulator_score(uint8_t *a, uint8_t *b)
+{
+    if (a_emulator_id(a) != a_emulator_id(b))
+    {
+        return 0;
+    }
+    
+    return 100 + (uint16_t)(a_emulator_id(a) % 100);
+}
+
+/**
+ * @brief      emulator search the library
+ * @param[in]  *emu pointer to an as608 emulator structure
+ * @param[in]  *feature pointer to a feature
+ * @param[in]  start start page
+ * @param[in]  num page number
+ * @param[out] *out pointer to a 4 bytes page and score buffer
+ * @return     response status
+ * @note       none
+ */
+static uint8_t a_emulator_search(as608_emulator_t *emu, uint8_t *feature, uint32_t start, uint32_t num, uint8_t *out)
+{
+    uint32_t i;
+    uint16_t score;
+    
+    memset(out, 0, 4);
+    for (i = start; (i < (start + num)) && (i < AS608_EMULATOR_LIBRARY_SIZE); i++)
+    {
+        if (emu->library_valid[i] == 0)
+        {
+            continue;
+        }
+        score = a_emulator_score(feature, emu->library[i]);
+        if (score != 0)
+        {
+            out[0] = (i >> 8) & 0xFF;
+            out[1] = (i >> 0) & 0xFF;
+            out[2] = (score >> 8) & 0xFF;
+            out[3] = (score >> 0) & 0xFF;
+            
+            return AS608_STATUS_OK;
+        }
+    }
+    
+    return AS608_STATUS_NOT_FOUND;
+}
+
+/**
+ * @brief     emulator start a download
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] *buf pointer to a destination buffer
+ * @param[in] size destination size
+ * @note      the following data packets are saved in the buffer
+ */
+static void a_emulator_download(as608_emulator_t *emu, uint8_t *buf, uint32_t size)
+{
+    emu->download_buf = buf;
+    emu->download_size = size;
+    emu->download_point = 0;
+}
+
+/**
+ * @brief     emulator execute a command
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] *cmd pointer to a command payload
+ * @param[in] len payload length
+ * @return    status code
+ *            - 0 success
+ *            - 1 output buffer is full
+ * @note      none
+ */
+static uint8_t a_emulator_execute(as608_emulator_t *emu, uint8_t *cmd, uint16_t len)
+{
+    uint8_t out[33];
+    uint8_t status;
+    uint32_t i;
+    uint32_t page;
+    uint32_t num;
+    uint32_t value;
+    
+    memset(out, 0, sizeof(out));
+    switch (cmd[0])
+    {
+        case COMMAND_GET_IMAGE :
+        {
+            return a_emulator_respond(emu, a_emulator_capture(emu), NULL, 0);
+        }
+        case COMMAND_GEN_CHAR :
+        {
+            return a_emulator_respond(emu, (len < 2) ? AS608_STATUS_FRAME_ERROR : a_emulator_generate(emu, cmd[1]), NULL, 0);
+        }
+        case COMMAND_MATCH :
+        {
+            value = a_emulator_score(emu->feature[0], emu->feature[1]);
+            out[0] = (value >> 8) & 0xFF;
+            out[1] = (value >> 0) & 0xFF;
+            
+            return a_emulator_respond(emu, (value != 0) ? AS608_STATUS_OK : AS608_STATUS_NOT_MATCH, out, 2);
+        }
+        case COMMAND_SEARCH :
+        case COMMAND_HIGH_SPEED_SEARCH :
+        {
+            if ((len < 6) || ((cmd[1] != 1) && (cmd[1] != 2)))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_BUFFER_INVALID, out, 4);
+            }
+            page = ((uint32_t)cmd[2] << 8) | cmd[3];
+            num = ((uint32_t)cmd[4] << 8) | cmd[5];
+            status = a_emulator_search(emu, emu->feature[cmd[1] - 1], page, num, out);
+            
+            return a_emulator_respond(emu, status, out, 4);
+        }
+        case COMMAND_REG_MODEL :
+        {
+            if (a_emulator_score(emu->feature[0], emu->feature[1]) == 0)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_FEATURE_COMBINE_ERROR, NULL, 0);
+            }
+            memcpy(emu->feature[1], emu->feature[0], AS608_EMULATOR_FEATURE_SIZE);
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_STORE_CHAR :
+        case COMMAND_LOAD_CHAR :
+        {
+            if ((len < 4) || ((cmd[1] != 1) && (cmd[1] != 2)))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_BUFFER_INVALID, NULL, 0);
+            }
+            page = ((uint32_t)cmd[2] << 8) | cmd[3];
+            if (page >= AS608_EMULATOR_LIBRARY_SIZE)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_LIB_ADDR_OVER, NULL, 0);
+            }
+            if (cmd[0] == COMMAND_STORE_CHAR)
+            {
+                memcpy(emu->library[page], emu->feature[cmd[1] - 1], AS608_EMULATOR_FEATURE_SIZE);
+                emu->library_valid[page] = 1;
+            }
+            else
+            {
+                if (emu->library_valid[page] == 0)
+                {
+                    return a_emulator_respond(emu, AS608_STATUS_LIB_READ_ERROR, NULL, 0);
+                }
+                memcpy(emu->feature[cmd[1] - 1], emu->library[page], AS608_EMULATOR_FEATURE_SIZE);
+            }
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_UP_CHAR :
+        {
+            if ((len < 2) || ((cmd[1] != 1) && (cmd[1] != 2)))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_BUFFER_INVALID, NULL, 0);
+            }
+            if (a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0) != 0)
+            {
+                return 1;
+            }
+            
+            return a_emulator_queue_stream(emu, emu->feature[cmd[1] - 1], AS608_EMULATOR_FEATURE_SIZE);
+        }
+        case COMMAND_DOWN_CHAR :
+        {
+            if ((len < 2) || ((cmd[1] != 1) && (cmd[1] != 2)))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_BUFFER_INVALID, NULL, 0);
+            }
+            a_emulator_download(emu, emu->feature[cmd[1] - 1], AS608_EMULATOR_FEATURE_SIZE);
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_UP_IMAGE :
+        {
+            if (emu->image_valid == 0)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_UPLOAD_IMAGE_ERROR, NULL, 0);
+            }
+            if (a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0) != 0)
+            {
+                return 1;
+            }
+            
+            return a_emulator_queue_stream(emu, emu->image, AS608_EMULATOR_IMAGE_SIZE);
+        }
+        case COMMAND_DOWN_IMAGE :
+        {
+            a_emulator_download(emu, emu->image, AS608_EMULATOR_IMAGE_SIZE);
+            emu->image_valid = 1;
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_DELETE_CHAR :
+        {
+            if (len < 5)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_FRAME_ERROR, NULL, 0);
+            }
+            page = ((uint32_t)cmd[1] << 8) | cmd[2];
+            num = ((uint32_t)cmd[3] << 8) | cmd[4];
+            if ((page + num) > AS608_EMULATOR_LIBRARY_SIZE)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_LIB_DELETE_ERROR, NULL, 0);
+            }
+            memset(&emu->library_valid[page], 0, num);
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_EMPTY :
+        {
+            memset(emu->library_valid, 0, sizeof(emu->library_valid));
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_WRITE_REG :
+        {
+            if (len < 3)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_FRAME_ERROR, NULL, 0);
+            }
+            if ((cmd[1] == 4) && (cmd[2] >= 1) && (cmd[2] <= 12))
+            {
+                emu->n_9600 = cmd[2];
+            }
+            else if ((cmd[1] == 5) && (cmd[2] >= 1) && (cmd[2] <= 5))
+            {
+                emu->level = cmd[2];
+            }
+            else if ((cmd[1] == 6) && (cmd[2] <= 3))
+            {
+                emu->packet_size = cmd[2];
+            }
+            else
+            {
+                return a_emulator_respond(emu, AS608_STATUS_REG_INVALID, NULL, 0);
+            }
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_READ_SYS_PARA :
+        {
+            out[0] = 0x00;
+            out[1] = emu->image_valid;
+            out[2] = (AS608_SENSOR_TYPE_CUSTOM >> 8) & 0xFF;
+            out[3] = (AS608_SENSOR_TYPE_CUSTOM >> 0) & 0xFF;
+            out[4] = (AS608_EMULATOR_LIBRARY_SIZE >> 8) & 0xFF;
+            out[5] = (AS608_EMULATOR_LIBRARY_SIZE >> 0) & 0xFF;
+            out[6] = (emu->level >> 8) & 0xFF;
+            out[7] = (emu->level >> 0) & 0xFF;
+            out[8] = (emu->addr >> 24) & 0xFF;
+            out[9] = (emu->addr >> 16) & 0xFF;
+            out[10] = (emu->addr >> 8) & 0xFF;
+            out[11] = (emu->addr >> 0) & 0xFF;
+            out[12] = (emu->packet_size >> 8) & 0xFF;
+            out[13] = (emu->packet_size >> 0) & 0xFF;
+            out[14] = (emu->n_9600 >> 8) & 0xFF;
+            out[15] = (emu->n_9600 >> 0) & 0xFF;
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, out, 16);
+        }
+        case COMMAND_ENROLL :
+        {
+            status = a_emulator_capture(emu);
+            if (status == AS608_STATUS_OK)
+            {
+                status = a_emulator_generate(emu, 1);
+            }
+            if (status == AS608_STATUS_OK)
+            {
+                i = 0;
+                while ((i < AS608_EMULATOR_LIBRARY_SIZE) && (emu->library_valid[i] != 0))
+                {
+                    i++;
+                }
+                if (i == AS608_EMULATOR_LIBRARY_SIZE)
+                {
+                    status = AS608_STATUS_LIB_FULL;
+                }
+                else
+                {
+                    memcpy(emu->library[i], emu->feature[0], AS608_EMULATOR_FEATURE_SIZE);
+                    emu->library_valid[i] = 1;
+                    out[0] = (i >> 8) & 0xFF;
+                    out[1] = (i >> 0) & 0xFF;
+                }
+            }
+            
+            return a_emulator_respond(emu, status, out, 2);
+        }
+        case COMMAND_IDENTIFY :
+        {
+            status = a_emulator_capture(emu);
+            if (status == AS608_STATUS_OK)
+            {
+                status = a_emulator_generate(emu, 1);
+            }
+            if (status == AS608_STATUS_OK)
+            {
+                status = a_emulator_search(emu, emu->feature[0], 0, AS608_EMULATOR_LIBRARY_SIZE, out);
+            }
+            
+            return a_emulator_respond(emu, status, out, 4);
+        }
+        case COMMAND_SET_PWD :
+        case COMMAND_VFY_PWD :
+        {
+            if (len < 5)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_FRAME_ERROR, NULL, 0);
+            }
+            value = ((uint32_t)cmd[1] << 24) | ((uint32_t)cmd[2] << 16) | ((uint32_t)cmd[3] << 8) | cmd[4];
+            if (cmd[0] == COMMAND_SET_PWD)
+            {
+                emu->password = value;
+            }
+            else if (value != emu->password)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_COMMAND_INVALID, NULL, 0);
+            }
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_GET_RANDOM_CODE :
+        {
+            value = (uint32_t)rand();
+            out[0] = (value >> 24) & 0xFF;
+            out[1] = (value >> 16) & 0xFF;
+            out[2] = (value >> 8) & 0xFF;
+            out[3] = (value >> 0) & 0xFF;
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, out, 4);
+        }
+        case COMMAND_SET_CHIP_ADDR :
+        {
+            if (len < 5)
+            {
+                return a_emulator_respond(emu, AS608_STATUS_FRAME_ERROR, NULL, 0);
+            }
+            emu->addr = ((uint32_t)cmd[1] << 24) | ((uint32_t)cmd[2] << 16) | ((uint32_t)cmd[3] << 8) | cmd[4];
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_READ_INFO_PAGE :
+        {
+            if (a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0) != 0)
+            {
+                return 1;
+            }
+            
+            return a_emulator_queue_stream(emu, emu->info_page, sizeof(emu->info_page));
+        }
+        case COMMAND_PORT_CONTROL :
+        {
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_WRITE_NOTEPAD :
+        case COMMAND_READ_NOTEPAD :
+        {
+            if ((len < 2) || (cmd[1] >= 16) || ((cmd[0] == COMMAND_WRITE_NOTEPAD) && (len < 34)))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_NOTE_PAGE_INVALID, out, 
+                                          (cmd[0] == COMMAND_READ_NOTEPAD) ? 32 : 0);
+            }
+            if (cmd[0] == COMMAND_WRITE_NOTEPAD)
+            {
+                memcpy(emu->notepad[cmd[1]], &cmd[2], 32);
+                
+                return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+            }
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, emu->notepad[cmd[1]], 32);
+        }
+        case COMMAND_BURN_CODE :
+        {
+            a_emulator_download(emu, gs_burn_buf, sizeof(gs_burn_buf));
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, NULL, 0);
+        }
+        case COMMAND_GEN_BIN_IMAGE :
+        {
+            return a_emulator_respond(emu, (emu->image_valid != 0) ? AS608_STATUS_OK : AS608_STATUS_NO_FRAME, NULL, 0);
+        }
+        case COMMAND_VALID_TEMPLATE_NUM :
+        {
+            value = 0;
+            for (i = 0; i < AS608_EMULATOR_LIBRARY_SIZE; i++)
+            {
+                value += emu->library_valid[i];
+            }
+            out[0] = (value >> 8) & 0xFF;
+            out[1] = (value >> 0) & 0xFF;
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, out, 2);
+        }
+        case COMMAND_USER_GPIO :
+        {
+            if ((len < 3) || (cmd[1] > 1))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_PORT_INVALID, out, 1);
+            }
+            out[0] = cmd[2];
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, out, 1);
+        }
+        case COMMAND_READ_INDEX_TABLE :
+        {
+            if ((len < 2) || (cmd[1] > 3))
+            {
+                return a_emulator_respond(emu, AS608_STATUS_DATA_INVALID, out, 32);
+            }
+            for (i = 0; i < 256; i++)
+            {
+                page = (uint32_t)cmd[1] * 256 + i;
+                if ((page < AS608_EMULATOR_LIBRARY_SIZE) && (emu->library_valid[page] != 0))
+                {
+                    out[i / 8] |= (uint8_t)(1 << (i % 8));
+                }
+            }
+            
+            return a_emulator_respond(emu, AS608_STATUS_OK, out, 32);
+        }
+        default :
+        {
+            return a_emulator_respond(emu, AS608_STATUS_COMMAND_INVALID, NULL, 0);
+        }
+    }
+}
+
+/**
+ * @brief     as608 emulator init
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] addr chip address
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the library, the notepad and the image start empty and all latencies are 0
+ */
+uint8_t as608_emulator_init(as608_emulator_t *emu, uint32_t addr)
+{
+    memset(emu, 0, sizeof(as608_emulator_t));
+    emu->addr = addr;
+    emu->level = AS608_LEVEL_3;
+    emu->packet_size = AS608_PACKET_SIZE_128_BYTES;
+    emu->n_9600 = 6;
+    emu->finger = 1;
+    emu->finger_id = 1;
+    a_emulator_fill(addr, emu->info_page, sizeof(emu->info_page));
+    if (as608_parser_init(&emu->parser, emu->frame, sizeof(emu->frame)) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     as608 emulator set the command latency
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] command command code
+ * @param[in] ms processing latency in ms
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t as608_emulator_set_latency(as608_emulator_t *emu, uint8_t command, uint32_t ms)
+{
+    emu->latency_ms[command] = ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     as608 emulator set the finger
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] present finger present flag
+ * @param[in] id finger id
+ * @return    status code
+ *            - 0 success
+ * @note      the same id always produces the same image and feature
+ */
+uint8_t as608_emulator_set_finger(as608_emulator_t *emu, uint8_t present, uint32_t id)
+{
+    emu->finger = present;
+    emu->finger_id = id;
+    
+    return 0;
+}
+
+/**
+ * @brief      as608 emulator input the received bytes
+ * @param[in]  *emu pointer to an as608 emulator structure
+ * @param[in]  *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] *delay_ms pointer to a response delay buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 output buffer is full
+ * @note       every complete command is executed and its response is queued,
+ *             delay_ms is the largest latency of the executed commands or 0 if none is executed
+ */
+uint8_t as608_emulator_input(as608_emulator_t *emu, uint8_t *buf, uint32_t len, uint32_t *delay_ms)
+{
+    uint16_t used;
+    uint16_t l;
+    uint16_t n;
+    uint16_t i;
+    uint16_t sum;
+    uint32_t addr;
+    uint32_t size;
+    
+    *delay_ms = 0;
+    while (len != 0)
+    {
+        /* parse one frame */
+        if (as608_parser_feed(&emu->parser, buf, (len > 0xFFFF) ? 0xFFFF : (uint16_t)len, &used, &l) != 0)
+        {
+            return 0;
+        }
+        buf += used;
+        len -= used;
+        
+        /* check the address */
+        addr = a_emulator_id(&emu->frame[2]);
+        if (addr != emu->addr)
+        {
+            continue;
+        }
+        
+        /* check the sum */
+        sum = 0;
+        for (i = 6; i < (l - 2); i++)
+        {
+            sum += emu->frame[i];
+        }
+        if (sum != (((uint16_t)emu->frame[l - 2] << 8) | emu->frame[l - 1]))
+        {
+            if (a_emulator_respond(emu, AS608_STATUS_FRAME_ERROR, NULL, 0) != 0)
+            {
+                return 1;
+            }
+            
+            continue;
+        }
+        n = l - 11;
+        
+        /* save the data packets */
+        if ((emu->frame[6] == TYPE_DATA) || (emu->frame[6] == TYPE_END))
+        {
+            if (emu->download_buf != NULL)
+            {
+                size = emu->download_size - emu->download_point;
+                size = (n < size) ? n : size;
+                memcpy(emu->download_buf + emu->download_point, &emu->frame[9], size);
+                emu->download_point += size;
+                if (emu->frame[6] == TYPE_END)
+                {
+                    emu->download_buf = NULL;
+                }
+            }
+            
+            continue;
+        }
+        
+        /* run the command */
+        if ((emu->frame[6] != TYPE_COMMAND) || (n == 0))
+        {
+            continue;
+        }
+        emu->download_buf = NULL;
+        if (a_emulator_execute(emu, &emu->frame[9], n) != 0)
+        {
+            return 1;
+        }
+        emu->commands++;
+        if (emu->latency_ms[emu->frame[9]] > *delay_ms)
+        {
+            *delay_ms = emu->latency_ms[emu->frame[9]];
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     as608 emulator take the queued output bytes
+ * @param[in] *emu pointer to an as608 emulator structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    taken length
+ * @note      none
+ */
+uint32_t as608_emulator_output(as608_emulator_t *emu, uint8_t *buf, uint32_t len)
+{
+    uint32_t l;
+    
+    l = emu->output_tail - emu->output_head;
+    l = (len < l) ? len : l;
+    memcpy(buf, &emu->output[emu->output_head], l);
+    emu->output_head += l;
+    if (emu->output_head == emu->output_tail)
+    {
+        emu->output_head = 0;
+        emu->output_tail = 0;
+    }
+    
+    return l;
+}
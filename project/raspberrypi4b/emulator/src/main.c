@@ -0,0 +1,419 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     as608 emulator main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+#include "as608_emulator.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief global var definition
+ */
+static as608_emulator_t gs_emu;                  /**< emulator */
+static volatile sig_atomic_t gs_stop = 0;        /**< stop flag */
+static volatile sig_atomic_t gs_toggle = 0;      /**< toggle finger flag */
+static volatile sig_atomic_t gs_next = 0;        /**< next finger flag */
+
+/**
+ * @brief     signal handler
+ * @param[in] sig signal number
+ * @note      SIGUSR1 puts or removes the finger, SIGUSR2 changes the finger
+ */
+static void a_signal(int sig)
+{
+    if (sig == SIGUSR1)
+    {
+        gs_toggle = 1;
+    }
+    else if (sig == SIGUSR2)
+    {
+        gs_next = 1;
+    }
+    else
+    {
+        gs_stop = 1;
+    }
+}
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ms
+ * @note   none
+ */
+static uint64_t a_now_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief      open the pseudo terminal
+ * @param[out] *master pointer to a master handle buffer
+ * @param[out] *slave pointer to a slave handle buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       the slave is kept open, so the master does not fail when the driver closes the port
+ */
+static uint8_t a_open_pty(int *master, int *slave)
+{
+    struct termios cfg;
+    
+    /* open the master */
+    *master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((*master) < 0)
+    {
+        perror("emulator: open pty failed.\n");
+        
+        return 1;
+    }
+    if ((grantpt(*master) != 0) || (unlockpt(*master) != 0))
+    {
+        perror("emulator: unlock pty failed.\n");
+        (void)close(*master);
+        
+        return 1;
+    }
+    
+    /* open the slave in raw mode */
+    *slave = open(ptsname(*master), O_RDWR | O_NOCTTY);
+    if ((*slave) < 0)
+    {
+        perror("emulator: open slave failed.\n");
+        (void)close(*master);
+        
+        return 1;
+    }
+    if (tcgetattr(*slave, &cfg) == 0)
+    {
+        cfmakeraw(&cfg);
+        (void)tcsetattr(*slave, TCSANOW, &cfg);
+    }
+    (void)fcntl(*master, F_SETFL, fcntl(*master, F_GETFL, 0) | O_NONBLOCK);
+    
+    return 0;
+}
+
+/**
+ * @brief     print the help
+ * @note      none
+ */
+static void a_help(void)
+{
+    printf("Usage:\n");
+    printf("  as608_emulator [--addr=<address>] [--latency=<command>:<ms>] [--delay=<ms>]\n");
+    printf("                 [--finger=<id>] [--no-finger] [--wire] [--link=<path>]\n");
+    printf("  as608_emulator (-h | --help)\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  --addr=<address>              Set the chip address in hex.([default: 0xFFFFFFFF])\n");
+    printf("  --latency=<command>:<ms>      Set the processing latency of one command, command is the code in hex,\n");
+    printf("                                e.g. --latency=0x01:300 makes the get image command take 300ms.\n");
+    printf("  --delay=<ms>                  Set the processing latency of all commands.([default: 0])\n");
+    printf("  --finger=<id>                 Set the finger id, the same id gives the same feature.([default: 1])\n");
+    printf("  --no-finger                   Start without the finger on the sensor.\n");
+    printf("  --wire                        Send the responses at the wire speed of the current baud rate.\n");
+    printf("  --link=<path>                 Create a symbolic link to the pty.\n");
+    printf("\n");
+    printf("Signals:\n");
+    printf("  SIGUSR1                       Put or remove the finger.\n");
+    printf("  SIGUSR2                       Change to the next finger id.\n");
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int master;
+    int slave;
+    int timeout;
+    char *p;
+    char *link = NULL;
+    uint8_t wire = 0;
+    uint8_t buf[4096];
+    uint8_t tx[4096];
+    uint32_t tx_len = 0;
+    uint32_t tx_point = 0;
+    uint32_t i;
+    uint32_t l;
+    uint32_t delay;
+    uint32_t addr = 0xFFFFFFFF;
+    uint64_t now;
+    uint64_t last;
+    uint64_t credit;
+    uint64_t release;
+    struct pollfd pfd;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"addr", required_argument, NULL, 1},
+        {"latency", required_argument, NULL, 2},
+        {"delay", required_argument, NULL, 3},
+        {"finger", required_argument, NULL, 4},
+        {"no-finger", no_argument, NULL, 5},
+        {"wire", no_argument, NULL, 6},
+        {"link", required_argument, NULL, 7},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse the address first, it clears the emulator */
+    for (i = 1; i < (uint32_t)argc; i++)
+    {
+        if (strncmp(argv[i], "--addr=", 7) == 0)
+        {
+            addr = (uint32_t)strtoul(argv[i] + 7, NULL, 16);
+        }
+    }
+    if (as608_emulator_init(&gs_emu, addr) != 0)
+    {
+        return 1;
+    }
+    
+    /* parse the args */
+    while ((c = getopt_long(argc, argv, short_options, long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 1 :
+            {
+                break;
+            }
+            case 2 :
+            {
+                l = (uint32_t)strtoul(optarg, &p, 16);
+                if ((*p != ':') || (l > 0xFF))
+                {
+                    a_help();
+                    
+                    return 1;
+                }
+                (void)as608_emulator_set_latency(&gs_emu, (uint8_t)l, (uint32_t)strtoul(p + 1, NULL, 10));
+                
+                break;
+            }
+            case 3 :
+            {
+                delay = (uint32_t)strtoul(optarg, NULL, 10);
+                for (i = 0; i < 256; i++)
+                {
+                    (void)as608_emulator_set_latency(&gs_emu, (uint8_t)i, delay);
+                }
+                
+                break;
+            }
+            case 4 :
+            {
+                (void)as608_emulator_set_finger(&gs_emu, gs_emu.finger, (uint32_t)strtoul(optarg, NULL, 0));
+                
+                break;
+            }
+            case 5 :
+            {
+                (void)as608_emulator_set_finger(&gs_emu, 0, gs_emu.finger_id);
+                
+                break;
+            }
+            case 6 :
+            {
+                wire = 1;
+                
+                break;
+            }
+            case 7 :
+            {
+                link = optarg;
+                
+                break;
+            }
+            default :
+            {
+                a_help();
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    
+    /* open the pty */
+    if (a_open_pty(&master, &slave) != 0)
+    {
+        return 1;
+    }
+    if (link != NULL)
+    {
+        (void)unlink(link);
+        if (symlink(ptsname(master), link) != 0)
+        {
+            perror("emulator: link failed.\n");
+        }
+    }
+    printf("emulator: %s\n", ptsname(master));
+    (void)fflush(stdout);
+    
+    /* set the signals */
+    (void)signal(SIGINT, a_signal);
+    (void)signal(SIGTERM, a_signal);
+    (void)signal(SIGUSR1, a_signal);
+    (void)signal(SIGUSR2, a_signal);
+    
+    /* run */
+    release = 0;
+    credit = 0;
+    last = a_now_ms();
+    pfd.fd = master;
+    while (gs_stop == 0)
+    {
+        /* update the finger */
+        if (gs_toggle != 0)
+        {
+            gs_toggle = 0;
+            (void)as608_emulator_set_finger(&gs_emu, !gs_emu.finger, gs_emu.finger_id);
+            printf("emulator: finger %s.\n", (gs_emu.finger != 0) ? "on" : "off");
+        }
+        if (gs_next != 0)
+        {
+            gs_next = 0;
+            (void)as608_emulator_set_finger(&gs_emu, gs_emu.finger, gs_emu.finger_id + 1);
+            printf("emulator: finger id %u.\n", gs_emu.finger_id);
+        }
+        
+        /* wait for the input or the next output */
+        now = a_now_ms();
+        timeout = -1;
+        pfd.events = POLLIN;
+        if ((tx_point == tx_len) && (gs_emu.output_tail != gs_emu.output_head))
+        {
+            timeout = (release > now) ? (int)(release - now) : 0;
+        }
+        else if ((tx_point != tx_len) && (wire != 0))
+        {
+            timeout = 1;
+        }
+        else if (tx_point != tx_len)
+        {
+            pfd.events = POLLIN | POLLOUT;
+        }
+        if ((poll(&pfd, 1, timeout) < 0) && (errno != EINTR))
+        {
+            perror("emulator: poll failed.\n");
+            
+            break;
+        }
+        
+        /* read the commands */
+        if ((pfd.revents & POLLIN) != 0)
+        {
+            ssize_t n;
+            
+            n = read(master, buf, sizeof(buf));
+            if (n > 0)
+            {
+                if (as608_emulator_input(&gs_emu, buf, (uint32_t)n, &delay) != 0)
+                {
+                    printf("emulator: output buffer is full.\n");
+                }
+                if (delay != 0)
+                {
+                    release = a_now_ms() + delay;
+                }
+            }
+        }
+        
+        /* send the responses */
+        now = a_now_ms();
+        if (wire != 0)
+        {
+            credit += (now - last) * gs_emu.n_9600 * 9600 / 10;
+            credit = (credit > (sizeof(tx) * 1000)) ? (sizeof(tx) * 1000) : credit;
+        }
+        last = now;
+        if ((tx_point == tx_len) && (now >= release))
+        {
+            tx_point = 0;
+            tx_len = as608_emulator_output(&gs_emu, tx, sizeof(tx));
+        }
+        if (tx_point != tx_len)
+        {
+            ssize_t n;
+            
+            l = tx_len - tx_point;
+            if (wire != 0)
+            {
+                l = ((credit / 1000) < l) ? (uint32_t)(credit / 1000) : l;
+            }
+            n = write(master, &tx[tx_point], l);
+            if (n > 0)
+            {
+                tx_point += (uint32_t)n;
+                if (wire != 0)
+                {
+                    credit -= (uint64_t)n * 1000;
+                }
+            }
+        }
+    }
+    
+    /* close */
+    if (link != NULL)
+    {
+        (void)unlink(link);
+    }
+    (void)close(slave);
+    (void)close(master);
+    
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.h
+ * @brief     gpio header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup gpio gpio function
+ * @brief    gpio function modules
+ * @{
+ */
+
+/**
+ * @brief gpio chip and line declaration
+ */
+struct gpiod_chip;
+struct gpiod_line;
+
+/**
+ * @brief gpio event structure definition
+ */
+typedef struct gpio_event_s
+{
+    struct gpiod_chip *chip;        /**< gpio chip */
+    struct gpiod_line *line;        /**< gpio line */
+    int fd;                         /**< event file handle */
+} gpio_event_t;
+
+/**
+ * @brief      gpio event init
+ * @param[out] *event pointer to a gpio event structure
+ * @param[in]  *name pointer to a gpio chip name, path or number buffer
+ * @param[in]  line gpio line offset
+ * @param[in]  rising 1 waits for the rising edge with the pull down bias, 0 for the falling edge with the pull up bias
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       the event file handle can be added to a poll or epoll set
+ */
+uint8_t gpio_event_init(gpio_event_t *event, const char *name, uint32_t line, uint8_t rising);
+
+/**
+ * @brief     gpio event deinit
+ * @param[in] *event pointer to a gpio event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t gpio_event_deinit(gpio_event_t *event);
+
+/**
+ * @brief     gpio event wait for an edge
+ * @param[in] *event pointer to a gpio event structure
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      all queued edges are consumed, so one burst of edges returns once
+ */
+uint8_t gpio_event_wait(gpio_event_t *event, uint32_t timeout_ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      reactor.h
+ * @brief     reactor header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup reactor reactor function
+ * @brief    reactor function modules
+ * @{
+ */
+
+/**
+ * @brief reactor event structure definition
+ */
+typedef struct reactor_event_s
+{
+    int fd;                                                /**< file handle */
+    void (*callback)(void *arg, uint32_t events);          /**< point to an event callback function address */
+    void *arg;                                             /**< callback argument */
+} reactor_event_t;
+
+/**
+ * @brief      reactor init
+ * @param[out] *epfd pointer to a reactor handler buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       none
+ */
+uint8_t reactor_init(int *epfd);
+
+/**
+ * @brief     reactor deinit
+ * @param[in] epfd reactor handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t reactor_deinit(int epfd);
+
+/**
+ * @brief     reactor add an event
+ * @param[in] epfd reactor handle
+ * @param[in] *event pointer to a reactor event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the event is level triggered on readable data and must be valid until it is removed
+ */
+uint8_t reactor_add(int epfd, reactor_event_t *event);
+
+/**
+ * @brief     reactor remove an event
+ * @param[in] epfd reactor handle
+ * @param[in] *event pointer to a reactor event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 remove failed
+ * @note      none
+ */
+uint8_t reactor_remove(int epfd, reactor_event_t *event);
+
+/**
+ * @brief      reactor wait and dispatch the ready events
+ * @param[in]  epfd reactor handle
+ * @param[in]  timeout_ms max wait time in ms, -1 means forever
+ * @param[out] *count pointer to a dispatched event number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ * @note       the function returns after one wait, an interrupted wait dispatches nothing
+ */
+uint8_t reactor_run_once(int epfd, int timeout_ms, uint32_t *count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <sys/uio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +53,24 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief uart reader buffer size definition
+ */
+#define UART_READER_SIZE    4096        /**< 4096 bytes */
+
+/**
+ * @brief uart reader structure definition
+ */
+typedef struct uart_reader_s
+{
+    int fd;                                /**< uart handle */
+    uint8_t buf[UART_READER_SIZE];         /**< received bytes */
+    uint32_t head;                         /**< read point */
+    uint32_t tail;                         /**< end of the received bytes */
+    uint32_t polls;                        /**< poll syscalls */
+    uint32_t reads;                        /**< read syscalls */
+} uart_reader_t;
+
 /**
  * @brief      uart init
  * @param[in]  *name pointer to a device name buffer
@@ -85,10 +104,22 @@ uint8_t uart_deinit(int fd);
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      a full output queue is waited for in non-blocking mode
  */
 uint8_t uart_write(int fd, uint8_t *buf, uint32_t len);
 
+/**
+ * @brief     uart write data from several buffers
+ * @param[in] fd uart handle
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are written by writev and a short write is continued
+ */
+uint8_t uart_writev(int fd, const struct iovec *iov, int count);
+
 /**
  * @brief          uart read data
  * @param[in]      fd uart handle
@@ -97,7 +128,7 @@ uint8_t uart_write(int fd, uint8_t *buf, uint32_t len);
  * @return         status code
  *                 - 0 success
  *                 - 1 read failed
- * @note           none
+ * @note           the uart is non-blocking and no data returns success with *len = 0
  */
 uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len);
 
@@ -107,10 +138,71 @@ uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len);
  * @return    status code
  *            - 0 success
  *            - 1 flush failed
- * @note      none
+ * @note      only the received data is dropped
  */
 uint8_t uart_flush(int fd);
 
+/**
+ * @brief     uart drain
+ * @param[in] fd uart handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 drain failed
+ * @note      it waits until all the written bytes are sent
+ */
+uint8_t uart_drain(int fd);
+
+/**
+ * @brief     uart set the baud rate
+ * @param[in] fd uart handle
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      the pending output is sent before the rate changes
+ */
+uint8_t uart_set_baud_rate(int fd, uint32_t baud_rate);
+
+/**
+ * @brief     uart set an arbitrary baud rate by termios2
+ * @param[in] fd uart handle
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      it is built in its own source file, because asm/termbits.h conflicts with termios.h
+ */
+uint8_t uart_termios2_set_baud_rate(int fd, uint32_t baud_rate);
+
+/**
+ * @brief     uart reader init
+ * @param[in] *reader pointer to a uart reader structure
+ * @param[in] fd uart handle
+ * @note      none
+ */
+void uart_reader_init(uart_reader_t *reader, int fd);
+
+/**
+ * @brief          uart reader read data
+ * @param[in]      *reader pointer to a uart reader structure
+ * @param[out]     *buf pointer to a data buffer
+ * @param[in, out] *len pointer to a length of the data buffer
+ * @param[in]      timeout_ms max wait time in ms when no byte is buffered
+ * @return         status code
+ *                 - 0 success
+ *                 - 1 read failed
+ * @note           the buffered bytes are served first, when the buffer is empty it waits for the uart by poll and
+ *                 drains all available bytes with one read, no data returns success with *len = 0
+ */
+uint8_t uart_reader_read(uart_reader_t *reader, uint8_t *buf, uint32_t *len, uint32_t timeout_ms);
+
+/**
+ * @brief     uart reader clear the buffered bytes
+ * @param[in] *reader pointer to a uart reader structure
+ * @note      none
+ */
+void uart_reader_clear(uart_reader_t *reader);
+
 /**
  * @}
  */
@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.c
+ * @brief     gpio source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include <gpiod.h>
+#include <time.h>
+
+/**
+ * @brief gpio consumer name definition
+ */
+#define GPIO_CONSUMER "gpio_event"        /**< consumer name */
+
+/**
+ * @brief      gpio event init
+ * @param[out] *event pointer to a gpio event structure
+ * @param[in]  *name pointer to a gpio chip name, path or number buffer
+ * @param[in]  line gpio line offset
+ * @param[in]  rising 1 waits for the rising edge with the pull down bias, 0 for the falling edge with the pull up bias
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       the event file handle can be added to a poll or epoll set
+ */
+uint8_t gpio_event_init(gpio_event_t *event, const char *name, uint32_t line, uint8_t rising)
+{
+    struct gpiod_line_request_config config;
+    
+    /* open the chip */
+    event->chip = gpiod_chip_open_lookup(name);
+    if (event->chip == NULL)
+    {
+        perror("gpio: open chip failed.\n");
+        
+        return 1;
+    }
+    
+    /* get the line */
+    event->line = gpiod_chip_get_line(event->chip, line);
+    if (event->line == NULL)
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_chip_close(event->chip);
+        
+        return 1;
+    }
+    
+    /* request the edge events */
+    config.consumer = GPIO_CONSUMER;
+    if (rising != 0)
+    {
+        config.request_type = GPIOD_LINE_REQUEST_EVENT_RISING_EDGE;
+        config.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_DOWN;
+    }
+    else
+    {
+        config.request_type = GPIOD_LINE_REQUEST_EVENT_FALLING_EDGE;
+        config.flags = GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP;
+    }
+    if (gpiod_line_request(event->line, &config, 0) < 0)
+    {
+        perror("gpio: request line failed.\n");
+        gpiod_chip_close(event->chip);
+        
+        return 1;
+    }
+    
+    /* get the event file handle */
+    event->fd = gpiod_line_event_get_fd(event->line);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio event deinit
+ * @param[in] *event pointer to a gpio event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t gpio_event_deinit(gpio_event_t *event)
+{
+    /* release the line and close the chip */
+    gpiod_line_release(event->line);
+    gpiod_chip_close(event->chip);
+    event->fd = -1;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio event wait for an edge
+ * @param[in] *event pointer to a gpio event structure
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      all queued edges are consumed, so one burst of edges returns once
+ */
+uint8_t gpio_event_wait(gpio_event_t *event, uint32_t timeout_ms)
+{
+    struct timespec ts;
+    struct gpiod_line_event e;
+    int res;
+    
+    /* wait for an edge */
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+    res = gpiod_line_event_wait(event->line, &ts);
+    if (res < 0)
+    {
+        perror("gpio: wait failed.\n");
+        
+        return 1;
+    }
+    if (res == 0)
+    {
+        return 2;
+    }
+    
+    /* consume the queued edges */
+    ts.tv_sec = 0;
+    ts.tv_nsec = 0;
+    do
+    {
+        if (gpiod_line_event_read(event->line, &e) < 0)
+        {
+            perror("gpio: read failed.\n");
+            
+            return 1;
+        }
+        res = gpiod_line_event_wait(event->line, &ts);
+    } while (res > 0);
+    
+    return 0;
+}
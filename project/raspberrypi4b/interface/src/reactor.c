@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      reactor.c
+ * @brief     reactor source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "reactor.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+/**
+ * @brief reactor max events definition
+ */
+#define REACTOR_MAX_EVENTS 16        /**< 16 events per wait */
+
+/**
+ * @brief      reactor init
+ * @param[out] *epfd pointer to a reactor handler buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       none
+ */
+uint8_t reactor_init(int *epfd)
+{
+    /* create the epoll instance */
+    *epfd = epoll_create1(EPOLL_CLOEXEC);
+    if ((*epfd) < 0)
+    {
+        perror("reactor: create failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reactor deinit
+ * @param[in] epfd reactor handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t reactor_deinit(int epfd)
+{
+    /* close the epoll instance */
+    if (close(epfd) < 0)
+    {
+        perror("reactor: close failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reactor add an event
+ * @param[in] epfd reactor handle
+ * @param[in] *event pointer to a reactor event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the event is level triggered on readable data and must be valid until it is removed
+ */
+uint8_t reactor_add(int epfd, reactor_event_t *event)
+{
+    struct epoll_event ev;
+    
+    /* watch readable data */
+    ev.events = EPOLLIN;
+    ev.data.ptr = event;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, event->fd, &ev) < 0)
+    {
+        perror("reactor: add failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reactor remove an event
+ * @param[in] epfd reactor handle
+ * @param[in] *event pointer to a reactor event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 remove failed
+ * @note      none
+ */
+uint8_t reactor_remove(int epfd, reactor_event_t *event)
+{
+    struct epoll_event ev;
+    
+    /* stop watching */
+    if (epoll_ctl(epfd, EPOLL_CTL_DEL, event->fd, &ev) < 0)
+    {
+        perror("reactor: remove failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      reactor wait and dispatch the ready events
+ * @param[in]  epfd reactor handle
+ * @param[in]  timeout_ms max wait time in ms, -1 means forever
+ * @param[out] *count pointer to a dispatched event number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ * @note       the function returns after one wait, an interrupted wait dispatches nothing
+ */
+uint8_t reactor_run_once(int epfd, int timeout_ms, uint32_t *count)
+{
+    struct epoll_event evs[REACTOR_MAX_EVENTS];
+    reactor_event_t *event;
+    int n;
+    int i;
+    
+    /* wait for the events */
+    *count = 0;
+    n = epoll_wait(epfd, evs, REACTOR_MAX_EVENTS, timeout_ms);
+    if (n < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        perror("reactor: wait failed.\n");
+        
+        return 1;
+    }
+    
+    /* dispatch the events */
+    for (i = 0; i < n; i++)
+    {
+        event = (reactor_event_t *)evs[i].data.ptr;
+        if (event->callback != NULL)
+        {
+            event->callback(event->arg, evs[i].events);
+        }
+    }
+    *count = (uint32_t)n;
+    
+    return 0;
+}
@@ -35,105 +35,163 @@
  */
 
 #include "uart.h"
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <string.h>
 #include <termios.h>
 
 /**
- * @brief     uart config
- * @param[in] fd uart handler
- * @param[in] baud_rate baud rate
- * @param[in] data_bits data bits
- * @param[in] parity data parity
- * @param[in] stop_bits stop bits
+ * @brief uart write definition
+ */
+#define UART_WRITE_TIMEOUT_MS 1000        /**< 1000ms */
+#define UART_WRITEV_MAX       8           /**< 8 buffers */
+
+/**
+ * @brief     uart wait for the output room
+ * @param[in] fd uart handle
  * @return    status code
  *            - 0 success
- *            - 1 set config failed
+ *            - 1 wait failed
  * @note      none
  */
-static uint8_t a_uart_config(int fd, uint32_t baud_rate, uint8_t data_bits, char parity, uint8_t stop_bits)
+static uint8_t a_uart_wait_writable(int fd)
 {
-    struct termios cfg;
-    int speed;
+    int res;
+    struct pollfd pfd;
     
-    /* get cfg */
-    if (tcgetattr(fd, &cfg) != 0)
+    /* wait for the room */
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    res = poll(&pfd, 1, UART_WRITE_TIMEOUT_MS);
+    if ((res < 0) && (errno == EINTR))
     {
-        perror("uart: get cfg failed.\n");
+        return 0;
+    }
+    if (res <= 0)
+    {
+        perror("uart: wait output failed.\n");
         
         return 1;
     }
     
-    /* set raw mode */
-    cfmakeraw(&cfg);
-    
-    /* set the baud rate */
+    return 0;
+}
+
+/**
+ * @brief      uart get the speed of a baud rate
+ * @param[in]  baud_rate baud rate
+ * @param[out] *speed pointer to a speed buffer
+ * @return     0 if the baud rate is standard, 1 if it must be set by termios2
+ * @note       a non-standard rate returns B38400 as the placeholder speed
+ */
+static uint8_t a_uart_speed(uint32_t baud_rate, speed_t *speed)
+{
     switch (baud_rate)
     {
-        /* 2400bps */
         case 2400 :
         {
-            speed = B2400;
+            *speed = B2400;
             
-            break;
+            return 0;
         }
-        
-        /* 4800bps */
         case 4800 :
         {
-            speed = B4800;
+            *speed = B4800;
             
-            break;
+            return 0;
         }
-        
-        /* 9600bps */
         case 9600 :
         {
-            speed = B9600;
+            *speed = B9600;
             
-            break;
+            return 0;
         }
-        
-        /* 19200bps */
         case 19200 :
         {
-            speed = B19200;
+            *speed = B19200;
             
-            break;
+            return 0;
         }
-        
-        /* 38400bps */
         case 38400 :
         {
-            speed = B38400;
+            *speed = B38400;
             
-            break;
+            return 0;
         }
-        
-        /* 57600bps */
         case 57600 :
         {
-            speed = B57600;
+            *speed = B57600;
             
-            break;
+            return 0;
         }
-
-        /* 115200bps */
         case 115200 :
         {
-            speed = B115200;
+            *speed = B115200;
             
-            break;
+            return 0;
+        }
+        case 230400 :
+        {
+            *speed = B230400;
+            
+            return 0;
+        }
+        case 460800 :
+        {
+            *speed = B460800;
+            
+            return 0;
+        }
+        case 921600 :
+        {
+            *speed = B921600;
+            
+            return 0;
         }
         
-        /* invalid param */
+        /* 28800bps, 48000bps, 67200bps ... and other rates */
         default :
         {
-            perror("uart: baud rate is invalid.\n");
+            *speed = B38400;
             
             return 1;
         }
     }
+}
+
+/**
+ * @brief     uart config
+ * @param[in] fd uart handler
+ * @param[in] baud_rate baud rate
+ * @param[in] data_bits data bits
+ * @param[in] parity data parity
+ * @param[in] stop_bits stop bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 set config failed
+ * @note      none
+ */
+static uint8_t a_uart_config(int fd, uint32_t baud_rate, uint8_t data_bits, char parity, uint8_t stop_bits)
+{
+    struct termios cfg;
+    speed_t speed;
+    uint8_t custom;
+    
+    /* get cfg */
+    if (tcgetattr(fd, &cfg) != 0)
+    {
+        perror("uart: get cfg failed.\n");
+        
+        return 1;
+    }
+    
+    /* set raw mode */
+    cfmakeraw(&cfg);
+    
+    /* set the baud rate, a non-standard rate is set by termios2 after the config */
+    custom = a_uart_speed(baud_rate, &speed);
     
     /* set input speed */
     if (cfsetispeed(&cfg, speed) != 0)
@@ -292,6 +350,12 @@ static uint8_t a_uart_config(int fd, uint32_t baud_rate, uint8_t data_bits, char
         return 1;
     }
     
+    /* set the non-standard rate */
+    if (custom != 0)
+    {
+        return uart_termios2_set_baud_rate(fd, baud_rate);
+    }
+    
     return 0;
 }
 
@@ -361,21 +425,98 @@ uint8_t uart_deinit(int fd)
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      a full output queue is waited for in non-blocking mode
  */
 uint8_t uart_write(int fd, uint8_t *buf, uint32_t len)
 {
-    /* write data */
-    if (write(fd, buf, len) < 0)
+    ssize_t l;
+    
+    /* write until all data is queued */
+    while (len != 0)
+    {
+        l = write(fd, buf, len);
+        if ((l < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)))
+        {
+            /* the output queue is full in non-blocking mode */
+            if (a_uart_wait_writable(fd) != 0)
+            {
+                return 1;
+            }
+            
+            continue;
+        }
+        else if (l < 0)
+        {
+            perror("uart: write failed.\n");
+            
+            return 1;
+        }
+        buf += l;
+        len -= (uint32_t)l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     uart write data from several buffers
+ * @param[in] fd uart handle
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are written by writev and a short write is continued
+ */
+uint8_t uart_writev(int fd, const struct iovec *iov, int count)
+{
+    struct iovec vec[UART_WRITEV_MAX];
+    ssize_t l;
+    int i;
+    
+    /* copy the vector */
+    if ((count < 0) || (count > UART_WRITEV_MAX))
     {
-        perror("uart: write failed.\n");
-        
         return 1;
     }
-    else
+    memcpy(vec, iov, sizeof(struct iovec) * count);
+    
+    /* write until all buffers are queued */
+    i = 0;
+    while (i < count)
     {
-        return 0;
+        l = writev(fd, &vec[i], count - i);
+        if ((l < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)))
+        {
+            /* the output queue is full in non-blocking mode */
+            if (a_uart_wait_writable(fd) != 0)
+            {
+                return 1;
+            }
+            
+            continue;
+        }
+        else if (l < 0)
+        {
+            perror("uart: writev failed.\n");
+            
+            return 1;
+        }
+        
+        /* skip the written bytes */
+        while ((i < count) && ((size_t)l >= vec[i].iov_len))
+        {
+            l -= (ssize_t)vec[i].iov_len;
+            i++;
+        }
+        if (i < count)
+        {
+            vec[i].iov_base = (uint8_t *)vec[i].iov_base + l;
+            vec[i].iov_len -= (size_t)l;
+        }
     }
+    
+    return 0;
 }
 
 /**
@@ -386,7 +527,7 @@ uint8_t uart_write(int fd, uint8_t *buf, uint32_t len)
  * @return         status code
  *                 - 0 success
  *                 - 1 read failed
- * @note           none
+ * @note           the uart is non-blocking and no data returns success with *len = 0
  */
 uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len)
 {
@@ -394,7 +535,14 @@ uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len)
     
     /* read data */
     l = read(fd, buf, *len);
-    if (l < 0) 
+    if ((l < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    {
+        /* no data in non-blocking mode */
+        *len = 0;
+        
+        return 0;
+    }
+    else if (l < 0) 
     {
         perror("uart: read failed.\n");
         
@@ -415,12 +563,12 @@ uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len)
  * @return    status code
  *            - 0 success
  *            - 1 flush failed
- * @note      none
+ * @note      only the received data is dropped
  */
 uint8_t uart_flush(int fd)
 {
-    /* flush data */
-    if (tcflush(fd, TCIOFLUSH) < 0)
+    /* flush the received data and keep the pending output */
+    if (tcflush(fd, TCIFLUSH) < 0)
     {
         perror("uart: flush failed.\n");
         
@@ -431,3 +579,182 @@ uint8_t uart_flush(int fd)
         return 0;
     }
 }
+
+/**
+ * @brief     uart drain
+ * @param[in] fd uart handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 drain failed
+ * @note      it waits until all the written bytes are sent
+ */
+uint8_t uart_drain(int fd)
+{
+    /* wait for the output */
+    if (tcdrain(fd) != 0)
+    {
+        perror("uart: drain failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     uart set the baud rate
+ * @param[in] fd uart handle
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      the pending output is sent before the rate changes
+ */
+uint8_t uart_set_baud_rate(int fd, uint32_t baud_rate)
+{
+    struct termios cfg;
+    speed_t speed;
+    
+    /* get cfg */
+    if (tcgetattr(fd, &cfg) != 0)
+    {
+        perror("uart: get cfg failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the non-standard rate */
+    if (a_uart_speed(baud_rate, &speed) != 0)
+    {
+        if (tcdrain(fd) != 0)
+        {
+            perror("uart: drain failed.\n");
+            
+            return 1;
+        }
+        
+        return uart_termios2_set_baud_rate(fd, baud_rate);
+    }
+    
+    /* set speed */
+    if ((cfsetispeed(&cfg, speed) != 0) || (cfsetospeed(&cfg, speed) != 0))
+    {
+        perror("uart: set speed failed.\n");
+        
+        return 1;
+    }
+    
+    /* write cfg after the output is sent */
+    if (tcsetattr(fd, TCSADRAIN, &cfg) != 0)
+    {
+        perror("uart: write cfg failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     uart reader init
+ * @param[in] *reader pointer to a uart reader structure
+ * @param[in] fd uart handle
+ * @note      none
+ */
+void uart_reader_init(uart_reader_t *reader, int fd)
+{
+    reader->fd = fd;
+    reader->head = 0;
+    reader->tail = 0;
+    reader->polls = 0;
+    reader->reads = 0;
+}
+
+/**
+ * @brief          uart reader read data
+ * @param[in]      *reader pointer to a uart reader structure
+ * @param[out]     *buf pointer to a data buffer
+ * @param[in, out] *len pointer to a length of the data buffer
+ * @param[in]      timeout_ms max wait time in ms when no byte is buffered
+ * @return         status code
+ *                 - 0 success
+ *                 - 1 read failed
+ * @note           the buffered bytes are served first, when the buffer is empty it waits for the uart by poll and
+ *                 drains all available bytes with one read, no data returns success with *len = 0
+ */
+uint8_t uart_reader_read(uart_reader_t *reader, uint8_t *buf, uint32_t *len, uint32_t timeout_ms)
+{
+    int res;
+    ssize_t l;
+    uint32_t n;
+    struct pollfd pfd;
+    
+    /* refill the empty buffer */
+    if (reader->head == reader->tail)
+    {
+        reader->head = 0;
+        reader->tail = 0;
+        
+        /* wait for the uart, the wait ends as soon as a byte arrives */
+        pfd.fd = reader->fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        reader->polls++;
+        res = poll(&pfd, 1, (int)timeout_ms);
+        if ((res < 0) && (errno != EINTR))
+        {
+            perror("uart: poll failed.\n");
+            
+            return 1;
+        }
+        if (res <= 0)
+        {
+            /* timeout or interrupted */
+            *len = 0;
+            
+            return 0;
+        }
+        
+        /* drain all available bytes */
+        reader->reads++;
+        l = read(reader->fd, reader->buf, UART_READER_SIZE);
+        if ((l < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)))
+        {
+            *len = 0;
+            
+            return 0;
+        }
+        else if (l < 0)
+        {
+            perror("uart: read failed.\n");
+            
+            return 1;
+        }
+        else
+        {
+            reader->tail = (uint32_t)l;
+        }
+    }
+    
+    /* serve the buffered bytes */
+    n = reader->tail - reader->head;
+    n = (n < *len) ? n : *len;
+    memcpy(buf, &reader->buf[reader->head], n);
+    reader->head += n;
+    *len = n;
+    
+    return 0;
+}
+
+/**
+ * @brief     uart reader clear the buffered bytes
+ * @param[in] *reader pointer to a uart reader structure
+ * @note      none
+ */
+void uart_reader_clear(uart_reader_t *reader)
+{
+    reader->head = 0;
+    reader->tail = 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      uart_termios2.c
+ * @brief     uart termios2 source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "uart.h"
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+/**
+ * @brief     uart set an arbitrary baud rate by termios2
+ * @param[in] fd uart handle
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      it is built in its own source file, because asm/termbits.h conflicts with termios.h
+ */
+uint8_t uart_termios2_set_baud_rate(int fd, uint32_t baud_rate)
+{
+    struct termios2 cfg;
+    
+    /* get cfg */
+    if (ioctl(fd, TCGETS2, &cfg) < 0)
+    {
+        perror("uart: get cfg failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the output and input rate */
+    cfg.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    cfg.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    cfg.c_ospeed = baud_rate;
+    cfg.c_ispeed = baud_rate;
+    
+    /* write cfg after the output is sent */
+    if (ioctl(fd, TCSETSW2, &cfg) < 0)
+    {
+        perror("uart: write cfg failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -36,6 +36,7 @@
 
 #include "driver_as608_basic.h"
 #include "driver_as608_advance.h"
+#include "driver_as608_emulator_test.h"
 #include "driver_as608_fingerprint_test.h"
 #include "driver_as608_register_test.h"
 #include <getopt.h>
@@ -50,6 +51,27 @@
  */
 uint8_t g_rx_buffer[36 * 1024];        /**< rx uart buffer length */
 
+/**
+ * @brief     file sink
+ * @param[in] *arg pointer to a file
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_file_sink(void *arg, uint8_t *buf, uint16_t len)
+{
+    /* write the packet */
+    if (fwrite(buf, 1, len, (FILE *)arg) != len)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
 /**
  * @brief     input fingerprint callback
  * @param[in] status current status
@@ -60,6 +82,14 @@ static void a_callback(int8_t status, const char *const fmt, ...)
 {
     switch (status)
     {
+        case 3 :
+        case 4 :
+        {
+            /* output */
+            as608_interface_debug_print("%s", fmt);
+
+            break;
+        }
         case -1 :
         {
             /* output */
@@ -377,6 +407,16 @@ uint8_t as608(uint8_t argc, char **argv)
 
         return 0;
     }
+    else if (strcmp("t_emulator", type) == 0)
+    {
+        /* run emulator test */
+        if (as608_emulator_test() != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
     else if (strcmp("e_basic-fingerprint", type) == 0)
     {
         uint8_t res;
@@ -1239,8 +1279,8 @@ uint8_t as608(uint8_t argc, char **argv)
     else if (strcmp("e_advance-upload-image", type) == 0)
     {
         uint8_t res;
-        uint16_t output_len;
         as608_status_t status;
+        FILE *fp;
 
         /* advance init */
         res = as608_advance_init(addr);
@@ -1249,44 +1289,36 @@ uint8_t as608(uint8_t argc, char **argv)
             return 1;
         }
 
-        /* upload image */
-        output_len = 36 * 1024;
-        res = as608_advance_upload_image(g_rx_buffer, &output_len, &status);
-        if (res != 0)
+        /* open */
+        fp = fopen(path, "w+");
+        if (fp == NULL)
         {
             (void)as608_advance_deinit();
 
             return 1;
         }
 
-        if (status == AS608_STATUS_OK)
+        /* upload image to the file */
+        res = as608_advance_upload_image_to_sink(a_file_sink, fp, &status);
+        if (res != 0)
         {
-            FILE *fp;
-            size_t ret;
-
-            /* open */
-            fp = fopen(path, "w+");
-            if (fp == NULL)
-            {
-                return 1;
-            }
+            (void)fclose(fp);
+            (void)remove(path);
+            (void)as608_advance_deinit();
 
-            /* write */
-            ret = fwrite(g_rx_buffer, 1, output_len, fp);
-            if (ret < 0)
-            {
-                (void)fclose(fp);
+            return 1;
+        }
 
-                return 1;
-            }
+        /* close */
+        if (fclose(fp) != 0)
+        {
+            (void)as608_advance_deinit();
 
-            /* close */
-            ret = fclose(fp);
-            if (ret < 0)
-            {
-                return 1;
-            }
+            return 1;
+        }
 
+        if (status == AS608_STATUS_OK)
+        {
             /* output */
             as608_interface_debug_print("upload image ok.\n");
         }
@@ -1375,6 +1407,7 @@ uint8_t as608(uint8_t argc, char **argv)
         as608_interface_debug_print("  as608 (-p | --port)\n");
         as608_interface_debug_print("  as608 (-t reg | --test=reg)\n");
         as608_interface_debug_print("  as608 (-t fingerprint | --test=fingerprint)\n");
+        as608_interface_debug_print("  as608 (-t emulator | --test=emulator)\n");
         as608_interface_debug_print("  as608 (-e basic-fingerprint | --example=basic-fingerprint) [--addr=<address>]\n");
         as608_interface_debug_print("  as608 (-e basic-verify | --example=basic-verify) [--addr=<address>]\n");
         as608_interface_debug_print("  as608 (-e basic-fast-verify | --example=basic-fast-verify) [--addr=<address>]\n");
@@ -1417,7 +1450,7 @@ uint8_t as608(uint8_t argc, char **argv)
         as608_interface_debug_print("      --num=<page>        Set flash page.([default: 0])\n");
         as608_interface_debug_print("  -p, --port              Display the pin connections of the current board.\n");
         as608_interface_debug_print("      --path=<path>       Set file path.([default: \"tmp.data\"])\n");
-        as608_interface_debug_print("  -t <reg | fingerprint>, --test=<reg | fingerprint>\n");
+        as608_interface_debug_print("  -t <reg | fingerprint | emulator>, --test=<reg | fingerprint | emulator>\n");
         as608_interface_debug_print("                          Run the driver test.\n");
 
         return 0;
@@ -89,6 +89,36 @@ uint8_t as608_interface_uart_flush(void)
     return uart2_flush();
 }
 
+/**
+ * @brief     interface uart set the baud rate
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+uint8_t as608_interface_uart_set_baud_rate(uint32_t baud_rate)
+{
+    if (uart2_deinit() != 0)
+    {
+        return 1;
+    }
+    
+    return uart2_init(baud_rate);
+}
+
+/**
+ * @brief  interface uart drain
+ * @return status code
+ *         - 0 success
+ *         - 1 uart drain failed
+ * @note   it waits for the uart2 tx complete
+ */
+uint8_t as608_interface_uart_drain(void)
+{
+    return uart2_wait_tx_done(1000);
+}
+
 /**
  * @brief     interface uart write
  * @param[in] *buf pointer to a data buffer
@@ -113,6 +143,16 @@ void as608_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief  interface timestamp ms
+ * @return monotonic time in ms
+ * @note   none
+ */
+uint32_t as608_interface_timestamp_ms(void)
+{
+    return HAL_GetTick();
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -132,3 +172,208 @@ void as608_interface_debug_print(const char *const fmt, ...)
     len = strlen((char *)str);
     (void)uart_write((uint8_t *)str, len);
 }
+
+/**
+ * @brief  interface touch init
+ * @return status code
+ *         - 0 success
+ *         - 1 touch init failed
+ * @note   the touch line is optional
+ */
+uint8_t as608_interface_touch_init(void)
+{
+    /* the touch line isn't wired on this board */
+    return 1;
+}
+
+/**
+ * @brief  interface touch deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 touch deinit failed
+ * @note   none
+ */
+uint8_t as608_interface_touch_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface touch wait
+ * @param[in] ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      it returns at the touch edge, without the touch line it delays ms and returns 2
+ */
+uint8_t as608_interface_touch_wait(uint32_t ms)
+{
+    as608_interface_delay_ms(ms);
+    
+    return 2;
+}
+
+/**
+ * @brief     interface transport uart init
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_init(void *ctx)
+{
+    (void)ctx;
+    
+    return uart2_init(57600);
+}
+
+/**
+ * @brief     interface transport uart deinit
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_deinit(void *ctx)
+{
+    (void)ctx;
+    
+    return uart2_deinit();
+}
+
+/**
+ * @brief      interface transport uart read
+ * @param[in]  *ctx pointer to a transport context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       none
+ */
+uint16_t as608_interface_transport_uart_read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    (void)ctx;
+    
+    return uart2_read(buf, len);
+}
+
+/**
+ * @brief     interface transport uart write
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_write(void *ctx, uint8_t *buf, uint16_t len)
+{
+    (void)ctx;
+    
+    return uart2_write(buf, len);
+}
+
+/**
+ * @brief     interface transport uart flush
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_flush(void *ctx)
+{
+    (void)ctx;
+    
+    return uart2_flush();
+}
+
+/**
+ * @brief     interface transport delay ms
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] ms time
+ * @note      none
+ */
+void as608_interface_transport_delay_ms(void *ctx, uint32_t ms)
+{
+    (void)ctx;
+    
+    delay_ms(ms);
+}
+
+/**
+ * @brief     interface transport timestamp ms
+ * @param[in] *ctx pointer to a transport context
+ * @return    monotonic time in ms
+ * @note      none
+ */
+uint32_t as608_interface_transport_timestamp_ms(void *ctx)
+{
+    (void)ctx;
+    
+    return HAL_GetTick();
+}
+
+/**
+ * @brief     interface transport uart set the baud rate
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set baud rate failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_set_baud_rate(void *ctx, uint32_t baud_rate)
+{
+    (void)ctx;
+    
+    return as608_interface_uart_set_baud_rate(baud_rate);
+}
+
+/**
+ * @brief     interface transport uart writev
+ * @param[in] *ctx pointer to a transport context
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are gathered to the uart2 dma buffer
+ */
+uint8_t as608_interface_transport_uart_writev(void *ctx, as608_iovec_t *iov, uint8_t count)
+{
+    uart_iovec_t vec[4];
+    uint8_t i;
+    
+    (void)ctx;
+    
+    if (count > 4)
+    {
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        vec[i].buf = iov[i].buf;
+        vec[i].len = iov[i].len;
+    }
+    
+    return uart2_writev(vec, count);
+}
+
+/**
+ * @brief     interface transport uart drain
+ * @param[in] *ctx pointer to a transport context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart drain failed
+ * @note      none
+ */
+uint8_t as608_interface_transport_uart_drain(void *ctx)
+{
+    (void)ctx;
+    
+    return as608_interface_uart_drain();
+}
@@ -55,6 +55,42 @@ extern "C"{
 #define UART_MAX_LEN        256           /**< uart max len */
 #define UART2_MAX_LEN       (48 * 1024)   /**< uart2 max len */
 
+/**
+ * @brief uart2 rx dma mode definition
+ * @note  1 receives by the circular dma with the idle line event, 0 receives one byte per irq
+ */
+#ifndef UART2_RX_DMA
+    #define UART2_RX_DMA    1             /**< uart2 rx dma mode */
+#endif
+
+/**
+ * @brief uart2 rx dma ring length definition
+ * @note  it must be a power of 2
+ */
+#define UART2_DMA_LEN       (16 * 1024)   /**< uart2 dma ring len */
+
+/**
+ * @brief uart2 tx dma mode definition
+ * @note  1 sends by the dma and returns at once, 0 sends by the irq and waits for the end
+ */
+#ifndef UART2_TX_DMA
+    #define UART2_TX_DMA    1             /**< uart2 tx dma mode */
+#endif
+
+/**
+ * @brief uart2 tx dma buffer length definition
+ */
+#define UART2_TX_LEN        512           /**< uart2 tx buffer len */
+
+/**
+ * @brief uart io vector structure definition
+ */
+typedef struct uart_iovec_s
+{
+    uint8_t *buf;        /**< point to a data buffer */
+    uint16_t len;        /**< data length */
+} uart_iovec_t;
+
 /**
  * @brief     uart init with 8 data bits, 1 stop bit and no parity
  * @param[in] baud baud rate
@@ -155,16 +191,39 @@ uint8_t uart2_deinit(void);
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      in the dma mode the data is copied and queued, the function returns before it is on the wire
  */
 uint8_t uart2_write(uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     uart2 write data from several buffers
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      in the dma mode the buffers are gathered to the tx buffer and sent by one dma,
+ *            the whole length can't be over UART2_TX_LEN
+ */
+uint8_t uart2_writev(uart_iovec_t *iov, uint8_t count);
+
+/**
+ * @brief     uart2 wait for the tx done
+ * @param[in] timeout timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      none
+ */
+uint8_t uart2_wait_tx_done(uint32_t timeout);
+
 /**
  * @brief      uart2 read data
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       in the dma mode the received bytes are copied from the ring without waiting
+ *             and the unread bytes stay in the ring
  */
 uint16_t uart2_read(uint8_t *buf, uint16_t len);
 
@@ -183,6 +242,27 @@ uint16_t uart2_flush(void);
  */
 UART_HandleTypeDef* uart2_get_handle(void);
 
+/**
+ * @brief  uart2 get the tx dma handle
+ * @return pointer to a tx dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart2_get_tx_dma_handle(void);
+
+/**
+ * @brief  uart2 get the rx dma handle
+ * @return pointer to a rx dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart2_get_rx_dma_handle(void);
+
+/**
+ * @brief  uart2 get the rx overrun times
+ * @return overrun times
+ * @note   an overrun drops the whole ring, so the ring must hold the bytes received between two reads
+ */
+uint32_t uart2_get_rx_overrun(void);
+
 /**
  * @brief uart2 set tx done
  * @note  none
@@ -195,6 +275,20 @@ void uart2_set_tx_done(void);
  */
 void uart2_irq_handler(void);
 
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] size dma position in the ring
+ * @note      it runs at the idle line and at the half and full transfer
+ */
+void uart2_rx_event_handler(uint16_t size);
+
+/**
+ * @brief uart2 error handler
+ * @note  the hal stops the receive at an error, so it is restarted here
+ *        and a stopped transmit releases the tx wait
+ */
+void uart2_error_handler(void);
+
 /**
  * @}
  */
@@ -64,9 +64,23 @@ volatile uint8_t g_uart_tx_done;               /**< uart tx done flag */
  * @brief uart2 var definition
  */
 UART_HandleTypeDef g_uart2_handle;                               /**< uart2 handle */
+#if (UART2_RX_DMA == 1)
+DMA_HandleTypeDef g_uart2_rx_dma_handle;                         /**< uart2 rx dma handle */
+uint8_t g_uart2_rx_buffer[UART2_DMA_LEN];                        /**< uart2 rx ring, the ccm can't be reached by the dma */
+volatile uint32_t g_uart2_rx_head;                               /**< uart2 rx received length */
+volatile uint16_t g_uart2_rx_pos;                                /**< uart2 rx last dma position */
+uint32_t g_uart2_rx_tail;                                        /**< uart2 rx read length */
+volatile uint32_t g_uart2_rx_overrun;                            /**< uart2 rx overrun times */
+#else
 uint8_t g_uart2_rx_buffer[UART2_MAX_LEN]__AT(0x10000000);        /**< uart2 rx buffer */
 uint8_t g_uart2_buffer;                                          /**< uart2 one buffer */
 volatile uint16_t g_uart2_point;                                 /**< uart2 rx point */
+#endif
+#if (UART2_TX_DMA == 1)
+DMA_HandleTypeDef g_uart2_tx_dma_handle;                         /**< uart2 tx dma handle */
+uint8_t g_uart2_tx_buffer[2][UART2_TX_LEN];                      /**< uart2 tx ping pong buffer */
+uint8_t g_uart2_tx_index;                                        /**< uart2 tx buffer index */
+#endif
 volatile uint8_t g_uart2_tx_done;                                /**< uart2 tx done flag */
 
 /**
@@ -245,6 +259,76 @@ uint16_t uart_print(const char *const fmt, ...)
     }
 }
 
+#if (UART2_RX_DMA == 1)
+/**
+ * @brief     uart2 update the received length from the dma position
+ * @param[in] pos dma position in the ring
+ * @note      the position is sampled at least twice per lap by the half and full transfer events,
+ *            so a lower position always means one wrap
+ */
+static void a_uart2_rx_update(uint16_t pos)
+{
+    /* the ring end is the ring start */
+    if (pos >= UART2_DMA_LEN)
+    {
+        pos = 0;
+    }
+    
+    /* add the new bytes */
+    if (pos < g_uart2_rx_pos)
+    {
+        g_uart2_rx_head += UART2_DMA_LEN - g_uart2_rx_pos + pos;
+    }
+    else
+    {
+        g_uart2_rx_head += pos - g_uart2_rx_pos;
+    }
+    g_uart2_rx_pos = pos;
+}
+
+/**
+ * @brief  uart2 sample the received length
+ * @return received length
+ * @note   none
+ */
+static uint32_t a_uart2_rx_sample(void)
+{
+    uint32_t primask;
+    uint32_t head;
+    
+    /* the irq also updates the length */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    a_uart2_rx_update(UART2_DMA_LEN - __HAL_DMA_GET_COUNTER(&g_uart2_rx_dma_handle));
+    head = g_uart2_rx_head;
+    __set_PRIMASK(primask);
+    
+    return head;
+}
+
+/**
+ * @brief  uart2 start the circular dma receive
+ * @return status code
+ *         - 0 success
+ *         - 1 start failed
+ * @note   the unread bytes are dropped
+ */
+static uint8_t a_uart2_rx_start(void)
+{
+    /* reset the ring */
+    g_uart2_rx_pos = 0;
+    g_uart2_rx_tail = g_uart2_rx_head;
+    
+    /* receive to the ring until idle, the dma is circular */
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&g_uart2_handle, (uint8_t *)g_uart2_rx_buffer, UART2_DMA_LEN) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
+
 /**
  * @brief     uart2 init with 8 data bits, 1 stop bit and no parity
  * @param[in] baud baud rate
@@ -270,11 +354,22 @@ uint8_t uart2_init(uint32_t baud)
         return 1;
     }
     
+    /* nothing is on the wire */
+    g_uart2_tx_done = 1;
+    
+#if (UART2_RX_DMA == 1)
+    /* start the dma receive */
+    if (a_uart2_rx_start() != 0)
+    {
+        return 1;
+    }
+#else
     /* receive one byte */
     if (HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1) != HAL_OK)
     {
         return 1;
     }
+#endif
     
     return 0;
 }
@@ -284,10 +379,13 @@ uint8_t uart2_init(uint32_t baud)
  * @return status code
  *         - 0 success
  *         - 1 deinit
- * @note   none
+ * @note   the frame on the wire is sent before the deinit
  */
 uint8_t uart2_deinit(void)
 {
+    /* wait for the last frame */
+    (void)uart2_wait_tx_done(1000);
+    
     /* uart deinit */
     if (HAL_UART_DeInit(&g_uart2_handle) != HAL_OK)
     {
@@ -297,6 +395,129 @@ uint8_t uart2_deinit(void)
     return 0;
 }
 
+/**
+ * @brief     uart2 wait for the tx done
+ * @param[in] timeout timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the tx done flag is set by the tx complete irq
+ */
+uint8_t uart2_wait_tx_done(uint32_t timeout)
+{
+    uint32_t start;
+    
+    /* wait for events */
+    start = HAL_GetTick();
+    while (g_uart2_tx_done == 0)
+    {
+        if ((HAL_GetTick() - start) >= timeout)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+#if (UART2_TX_DMA == 1)
+/**
+ * @brief     uart2 start the dma transmit
+ * @param[in] len data length in the idle buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      it waits for the last frame and switches the buffer
+ */
+static uint8_t a_uart2_tx_start(uint16_t len)
+{
+    /* wait for the last frame */
+    if (uart2_wait_tx_done(1000) != 0)
+    {
+        return 1;
+    }
+    
+    /* set tx done 0 */
+    g_uart2_tx_done = 0;
+    
+    /* transmit */
+    if (HAL_UART_Transmit_DMA(&g_uart2_handle, g_uart2_tx_buffer[g_uart2_tx_index], len) != HAL_OK)
+    {
+        g_uart2_tx_done = 1;
+        
+        return 1;
+    }
+    
+    /* switch the buffer */
+    g_uart2_tx_index ^= 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     uart2 write data
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the data is copied to the idle ping pong buffer while the last one is still on the wire,
+ *            then the dma is started and the function returns without waiting for the end,
+ *            so the caller can reuse buf at once
+ */
+uint8_t uart2_write(uint8_t *buf, uint16_t len)
+{
+    uint16_t l;
+    
+    while (len != 0)
+    {
+        /* copy to the idle buffer */
+        l = (len > UART2_TX_LEN) ? UART2_TX_LEN : len;
+        memcpy(g_uart2_tx_buffer[g_uart2_tx_index], buf, l);
+        
+        /* start the dma */
+        if (a_uart2_tx_start(l) != 0)
+        {
+            return 1;
+        }
+        buf += l;
+        len -= l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     uart2 write data from several buffers
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are gathered to the idle ping pong buffer and sent by one dma,
+ *            the f4 dma has no descriptor chain, so this is the only copy of the frame
+ */
+uint8_t uart2_writev(uart_iovec_t *iov, uint8_t count)
+{
+    uint16_t l;
+    uint8_t i;
+    
+    /* gather to the idle buffer */
+    l = 0;
+    for (i = 0; i < count; i++)
+    {
+        if ((l + iov[i].len) > UART2_TX_LEN)
+        {
+            return 1;
+        }
+        memcpy(&g_uart2_tx_buffer[g_uart2_tx_index][l], iov[i].buf, iov[i].len);
+        l += iov[i].len;
+    }
+    
+    /* start the dma */
+    return a_uart2_tx_start(l);
+}
+#else
 /**
  * @brief     uart2 write data
  * @param[in] *buf pointer to a data buffer
@@ -337,6 +558,97 @@ uint8_t uart2_write(uint8_t *buf, uint16_t len)
     }
 }
 
+/**
+ * @brief     uart2 write data from several buffers
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffers are sent one by one
+ */
+uint8_t uart2_writev(uart_iovec_t *iov, uint8_t count)
+{
+    uint8_t i;
+    
+    for (i = 0; i < count; i++)
+    {
+        if (uart2_write(iov[i].buf, iov[i].len) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+#endif
+
+#if (UART2_RX_DMA == 1)
+/**
+ * @brief      uart2 read data
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     length of the read data
+ * @note       the received bytes are copied from the dma ring without waiting,
+ *             the unread bytes stay in the ring and an overrun ring is dropped
+ */
+uint16_t uart2_read(uint8_t *buf, uint16_t len)
+{
+    uint32_t head;
+    uint32_t size;
+    uint32_t index;
+    uint32_t first;
+    uint16_t read_len;
+    
+    /* get the received length */
+    head = a_uart2_rx_sample();
+    size = head - g_uart2_rx_tail;
+    
+    /* check the overrun */
+    if (size > UART2_DMA_LEN)
+    {
+        g_uart2_rx_tail = head;
+        g_uart2_rx_overrun++;
+        
+        return 0;
+    }
+    
+    /* calculate the read length */
+    read_len = (len < size) ? len : (uint16_t)size;
+    
+    /* copy the data, twice when it wraps */
+    index = g_uart2_rx_tail % UART2_DMA_LEN;
+    first = UART2_DMA_LEN - index;
+    if (read_len <= first)
+    {
+        memcpy(buf, &g_uart2_rx_buffer[index], read_len);
+    }
+    else
+    {
+        memcpy(buf, &g_uart2_rx_buffer[index], first);
+        memcpy(buf + first, g_uart2_rx_buffer, read_len - first);
+    }
+    
+    /* tail adds the read length */
+    g_uart2_rx_tail += read_len;
+    
+    return read_len;
+}
+
+/**
+ * @brief  uart2 flush data
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint16_t uart2_flush(void)
+{
+    /* drop the received bytes */
+    g_uart2_rx_tail = a_uart2_rx_sample();
+    
+    return 0;
+}
+#else
 /**
  * @brief      uart2 read data
  * @param[out] *buf pointer to a data buffer
@@ -390,6 +702,7 @@ uint16_t uart2_flush(void)
     
     return 0;
 }
+#endif
 
 /**
  * @brief  uart get the handle
@@ -411,6 +724,48 @@ UART_HandleTypeDef* uart2_get_handle(void)
     return &g_uart2_handle;
 }
 
+/**
+ * @brief  uart2 get the tx dma handle
+ * @return pointer to a tx dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart2_get_tx_dma_handle(void)
+{
+#if (UART2_TX_DMA == 1)
+    return &g_uart2_tx_dma_handle;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief  uart2 get the rx dma handle
+ * @return pointer to a rx dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart2_get_rx_dma_handle(void)
+{
+#if (UART2_RX_DMA == 1)
+    return &g_uart2_rx_dma_handle;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief  uart2 get the rx overrun times
+ * @return overrun times
+ * @note   an overrun drops the whole ring, so the ring must hold the bytes received between two reads
+ */
+uint32_t uart2_get_rx_overrun(void)
+{
+#if (UART2_RX_DMA == 1)
+    return g_uart2_rx_overrun;
+#else
+    return 0;
+#endif
+}
+
 /**
  * @brief uart set tx done
  * @note  none
@@ -447,6 +802,50 @@ void uart_irq_handler(void)
     (void)HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1);
 }
 
+#if (UART2_RX_DMA == 1)
+/**
+ * @brief uart2 irq handler
+ * @note  none
+ */
+void uart2_irq_handler(void)
+{
+    /* sample the dma position */
+    a_uart2_rx_update(UART2_DMA_LEN - __HAL_DMA_GET_COUNTER(&g_uart2_rx_dma_handle));
+}
+
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] size dma position in the ring
+ * @note      it runs at the idle line and at the half and full transfer
+ */
+void uart2_rx_event_handler(uint16_t size)
+{
+    /* update the received length */
+    a_uart2_rx_update(size);
+}
+
+/**
+ * @brief uart2 error handler
+ * @note  the hal stops the dma receive at an error, so it is restarted here
+ *        and a stopped transmit releases the tx wait
+ */
+void uart2_error_handler(void)
+{
+    if (g_uart2_handle.gState == HAL_UART_STATE_READY)
+    {
+        /* the transmit is stopped */
+        g_uart2_tx_done = 1;
+    }
+    if (g_uart2_handle.RxState == HAL_UART_STATE_READY)
+    {
+        /* count the received bytes before the stop */
+        a_uart2_rx_update(UART2_DMA_LEN - __HAL_DMA_GET_COUNTER(&g_uart2_rx_dma_handle));
+        
+        /* restart the dma receive */
+        (void)a_uart2_rx_start();
+    }
+}
+#else
 /**
  * @brief uart2 irq handler
  * @note  none
@@ -464,3 +863,32 @@ void uart2_irq_handler(void)
     /* receive one byte */
     (void)HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1);
 }
+
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] size dma position in the ring
+ * @note      none
+ */
+void uart2_rx_event_handler(uint16_t size)
+{
+    (void)size;
+}
+
+/**
+ * @brief uart2 error handler
+ * @note  the byte receive is restarted and a stopped transmit releases the tx wait
+ */
+void uart2_error_handler(void)
+{
+    if (g_uart2_handle.gState == HAL_UART_STATE_READY)
+    {
+        /* the transmit is stopped */
+        g_uart2_tx_done = 1;
+    }
+    if (g_uart2_handle.RxState == HAL_UART_STATE_READY)
+    {
+        /* receive one byte */
+        (void)HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1);
+    }
+}
+#endif
@@ -114,6 +114,18 @@ void USART1_IRQHandler(void);
  */
 void USART2_IRQHandler(void);
 
+/**
+ * @brief dma1 stream5 irq handler
+ * @note  none
+ */
+void DMA1_Stream5_IRQHandler(void);
+
+/**
+ * @brief dma1 stream6 irq handler
+ * @note  none
+ */
+void DMA1_Stream6_IRQHandler(void);
+
 /**
  * @}
  */
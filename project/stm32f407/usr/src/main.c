@@ -71,6 +71,14 @@ static void a_callback(int8_t status, const char *const fmt, ...)
 {
     switch (status)
     {
+        case 3 :
+        case 4 :
+        {
+            /* output */
+            as608_interface_debug_print("%s", fmt);
+
+            break;
+        }
         case -1 :
         {
             /* output */
@@ -36,6 +36,7 @@
 
 #include "stm32f4xx_hal.h"
 #include "sdio.h"
+#include "uart.h"
 
 /** 
  * @defgroup msp HAL_MSP_Private_Functions
@@ -68,6 +69,12 @@ void HAL_MspDeInit(void)
 void HAL_UART_MspInit(UART_HandleTypeDef *huart)
 {
     GPIO_InitTypeDef GPIO_InitStruct;
+#if (UART2_RX_DMA == 1)
+    DMA_HandleTypeDef *uart2_rx_dma_handle;
+#endif
+#if (UART2_TX_DMA == 1)
+    DMA_HandleTypeDef *uart2_tx_dma_handle;
+#endif
     
     if (huart->Instance == USART1)
     {
@@ -111,6 +118,64 @@ void HAL_UART_MspInit(UART_HandleTypeDef *huart)
         GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
         
+#if (UART2_RX_DMA == 1)
+        /* enable dma1 clock */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        
+        /* get rx dma handle */
+        uart2_rx_dma_handle = uart2_get_rx_dma_handle();
+        
+        /* set rx dma */
+        uart2_rx_dma_handle->Instance = DMA1_Stream5;
+        uart2_rx_dma_handle->Init.Channel = DMA_CHANNEL_4;
+        uart2_rx_dma_handle->Init.Direction = DMA_PERIPH_TO_MEMORY;
+        uart2_rx_dma_handle->Init.PeriphInc = DMA_PINC_DISABLE;
+        uart2_rx_dma_handle->Init.MemInc = DMA_MINC_ENABLE;
+        uart2_rx_dma_handle->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        uart2_rx_dma_handle->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        uart2_rx_dma_handle->Init.Mode = DMA_CIRCULAR;
+        uart2_rx_dma_handle->Init.Priority = DMA_PRIORITY_HIGH;
+        uart2_rx_dma_handle->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        
+        /* link rx dma */
+        __HAL_LINKDMA(huart, hdmarx, *uart2_rx_dma_handle);
+        (void)HAL_DMA_DeInit(uart2_rx_dma_handle);
+        (void)HAL_DMA_Init(uart2_rx_dma_handle);
+        
+        /* enable dma interrupt */
+        HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+        
+#endif
+#if (UART2_TX_DMA == 1)
+        /* enable dma1 clock */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        
+        /* get tx dma handle */
+        uart2_tx_dma_handle = uart2_get_tx_dma_handle();
+        
+        /* set tx dma */
+        uart2_tx_dma_handle->Instance = DMA1_Stream6;
+        uart2_tx_dma_handle->Init.Channel = DMA_CHANNEL_4;
+        uart2_tx_dma_handle->Init.Direction = DMA_MEMORY_TO_PERIPH;
+        uart2_tx_dma_handle->Init.PeriphInc = DMA_PINC_DISABLE;
+        uart2_tx_dma_handle->Init.MemInc = DMA_MINC_ENABLE;
+        uart2_tx_dma_handle->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        uart2_tx_dma_handle->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        uart2_tx_dma_handle->Init.Mode = DMA_NORMAL;
+        uart2_tx_dma_handle->Init.Priority = DMA_PRIORITY_MEDIUM;
+        uart2_tx_dma_handle->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        
+        /* link tx dma */
+        __HAL_LINKDMA(huart, hdmatx, *uart2_tx_dma_handle);
+        (void)HAL_DMA_DeInit(uart2_tx_dma_handle);
+        (void)HAL_DMA_Init(uart2_tx_dma_handle);
+        
+        /* enable dma interrupt */
+        HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+        
+#endif
         /* enable nvic */
         HAL_NVIC_SetPriority(USART2_IRQn, 2, 0);
         HAL_NVIC_EnableIRQ(USART2_IRQn);
@@ -143,6 +208,18 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart)
         /* uart gpio deinit */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_2 | GPIO_PIN_3);
         
+#if (UART2_RX_DMA == 1)
+        /* rx dma deinit */
+        (void)HAL_DMA_DeInit(huart->hdmarx);
+        HAL_NVIC_DisableIRQ(DMA1_Stream5_IRQn);
+        
+#endif
+#if (UART2_TX_DMA == 1)
+        /* tx dma deinit */
+        (void)HAL_DMA_DeInit(huart->hdmatx);
+        HAL_NVIC_DisableIRQ(DMA1_Stream6_IRQn);
+        
+#endif
         /* disable nvic */
         HAL_NVIC_DisableIRQ(USART2_IRQn);
     }
@@ -173,6 +173,26 @@ void USART2_IRQHandler(void)
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
     __HAL_UART_CLEAR_FEFLAG(huart);
+    if (huart->Instance == USART2)
+    {
+        /* restart the uart2 receive */
+        uart2_error_handler();
+    }
+}
+
+/**
+ * @brief     uart rx event callback
+ * @param[in] *huart pointer to a uart handle
+ * @param[in] Size dma position in the buffer
+ * @note      none
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart->Instance == USART2)
+    {
+        /* run the uart2 rx event handler */
+        uart2_rx_event_handler(Size);
+    }
 }
 
 /**
@@ -213,6 +233,28 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
     }
 }
 
+#if (UART2_RX_DMA == 1)
+/**
+ * @brief dma1 stream5 irq handler
+ * @note  none
+ */
+void DMA1_Stream5_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(uart2_get_rx_dma_handle());
+}
+#endif
+
+#if (UART2_TX_DMA == 1)
+/**
+ * @brief dma1 stream6 irq handler
+ * @note  none
+ */
+void DMA1_Stream6_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(uart2_get_tx_dma_handle());
+}
+#endif
+
 /**
  * @brief dma2 stream6 irq handler
  * @note  none
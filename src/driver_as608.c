@@ -93,1476 +93,1614 @@
 #define AS608_TYPE_END             0x08        /**< end type */
 
 /**
- * @brief     uart write data
+ * @brief receive poll period definition
+ */
+#define AS608_RECEIVE_POLL_MS      1           /**< 1ms */
+
+/**
+ * @brief stream pacing definition
+ */
+#define AS608_STREAM_LEGACY_GAP_MS         100         /**< 100ms */
+#define AS608_STREAM_DEFAULT_MARGIN_MS     5           /**< 5ms */
+#define AS608_STREAM_DEFAULT_N_9600        6           /**< 57600bps */
+
+/**
+ * @brief upload packet margin definition
+ */
+#define AS608_UPLOAD_PACKET_MARGIN_MS      100         /**< 100ms added to the wire time of one data packet */
+
+/**
+ * @brief switch baud rate settle time definition
+ */
+#define AS608_SWITCH_SETTLE_MS             10          /**< 10ms */
+
+/**
+ * @brief bulk probe rounds definition
+ */
+#define AS608_BULK_PROBE_ROUNDS            3           /**< 3 rounds */
+
+/**
+ * @brief capture default definition
+ */
+#define AS608_CAPTURE_DEFAULT_MIN_GAP_MS   10          /**< 10ms */
+#define AS608_CAPTURE_DEFAULT_MAX_GAP_MS   500         /**< 500ms */
+#define AS608_CAPTURE_DEFAULT_TIMEOUT_MS   10000       /**< 10s */
+#define AS608_CAPTURE_IMAGE_MS             50          /**< get image time counted without timestamp_ms */
+
+/**
+ * @brief enroll transport retry definition
+ */
+#define AS608_ENROLL_ERROR_RETRY           3           /**< 3 times */
+
+/**
+ * @brief best identify definition
+ */
+#define AS608_BEST_PATH_NUM                3           /**< 3 paths */
+#define AS608_BEST_EXPLORE_PERIOD          32          /**< explore every 32 requests */
+
+/**
+ * @brief response frame length definition
+ * @note  header(9) + confirmation code + response data + check sum(2), 0 means unknown
+ */
+static const uint8_t gsc_as608_response_len[0x20] =
+{
+    0,         /**< 0x00 */
+    12,        /**< get image */
+    12,        /**< generate char */
+    14,        /**< match, score */
+    16,        /**< search, page and score */
+    12,        /**< reg model */
+    12,        /**< store char */
+    12,        /**< load char */
+    12,        /**< up char, the data packets follow */
+    12,        /**< down char */
+    12,        /**< up image, the data packets follow */
+    12,        /**< down image */
+    12,        /**< delete char */
+    12,        /**< empty */
+    12,        /**< write reg */
+    28,        /**< read sys para, 16 bytes params */
+    14,        /**< enroll, page */
+    16,        /**< identify, page and score */
+    12,        /**< set password */
+    12,        /**< verify password */
+    16,        /**< get random code, 4 bytes random */
+    12,        /**< set chip addr */
+    12,        /**< read info page, the data packets follow */
+    12,        /**< port control */
+    12,        /**< write notepad */
+    44,        /**< read notepad, 32 bytes page */
+    12,        /**< burn code */
+    16,        /**< high speed search, page and score */
+    12,        /**< generate bin image */
+    14,        /**< valid template num, number */
+    13,        /**< user gpio, level */
+    44,        /**< read index table, 32 bytes table */
+};
+
+/**
+ * @brief     port uart init
  * @param[in] *handle pointer to an as608 handle structure
- * @param[in] addr address
- * @param[in] type command type
- * @param[in] *buf pointer to an input buffer
- * @param[in] len buffer length
  * @return    status code
  *            - 0 success
- *            - 1 write failed
- *            - 2 len is over
- * @note      none
+ *            - 1 uart init failed
+ * @note      the transport is used when it is linked, otherwise the uart callbacks are used
  */
-static uint8_t a_as608_uart_write(as608_handle_t *handle, uint32_t addr, uint8_t type, 
-                                  uint8_t *buf, uint16_t len)
+static uint8_t a_as608_port_uart_init(as608_handle_t *handle)
 {
-    uint16_t i;
-    uint16_t sum;
-    uint16_t l;
-    
-    if ((len + 11) > 384)                                   /* check length */
+    if (handle->transport != NULL)                              /* check transport */
     {
-        return 2;                                           /* return error */
+        return handle->transport->uart_init(handle->ctx);       /* transport uart init */
     }
-    handle->buf[0] = 0xEF;                                  /* header 0 */
-    handle->buf[1] = 0x01;                                  /* header 1 */
-    handle->buf[2] = (addr >> 24) & 0xFF;                   /* set addr 3 */
-    handle->buf[3] = (addr >> 16) & 0xFF;                   /* set addr 2 */
-    handle->buf[4] = (addr >> 8) & 0xFF;                    /* set addr 1 */
-    handle->buf[5] = (addr >> 0) & 0xFF;                    /* set addr 0 */
-    handle->buf[6] = type;                                  /* set type */
-    l = len + 2;                                            /* add check crc */
-    handle->buf[7] = (l >> 8) & 0xFF;                       /* set l msb */
-    handle->buf[8] = (l >> 0) & 0xFF;                       /* set l lsb */
-    memcpy(handle->buf + 9, buf, len);                      /* copy data */
-    l = len + 9;                                            /* add 9 */
-    sum = 0;                                                /* init 0 */
-    for(i = 6; i < l; i++)                                  /* loop */
+    else
     {
-        sum += handle->buf[i];                              /* sum all */
+        return handle->uart_init();                             /* uart init */
     }
-    handle->buf[l] = (sum >> 8) & 0xFF;                     /* set sum msb */
-    handle->buf[l + 1] = (sum >> 0) & 0xFF;                 /* set sum lsb */
-    
-    if (handle->uart_flush() != 0)                          /* uart flush */
+}
+
+/**
+ * @brief     port uart deinit
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+static uint8_t a_as608_port_uart_deinit(as608_handle_t *handle)
+{
+    if (handle->transport != NULL)                              /* check transport */
     {
-        return 1;                                           /* return error */
+        return handle->transport->uart_deinit(handle->ctx);     /* transport uart deinit */
     }
-    if (handle->uart_write(handle->buf, l + 2) != 0)        /* write data */
+    else
     {
-        return 1;                                           /* return error */
+        return handle->uart_deinit();                           /* uart deinit */
     }
-    
-    return 0;                                               /* success return 0 */
 }
 
 /**
- * @brief         uart decode
- * @param[in]     *handle pointer to an as608 handle structure
- * @param[in]     ms delay in ms
- * @param[out]    *addr pointer to an address buffer
- * @param[out]    *buf pointer to an output buffer
- * @param[in,out] *len pointer to a buffer length buffer
- * @return        status code
- *                - 0 success
- *                - 1 decode failed
- *                - 2 no response
- *                - 3 sum check error
- *                - 4 len is invalid
- *                - 5 header is invalid
- *                - 6 type is invalid
- * @note          none
+ * @brief      port uart read
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       none
  */
-static uint8_t a_as608_uart_decode(as608_handle_t *handle, uint32_t ms, uint32_t *addr,
-                                   uint8_t *buf, uint16_t *len)
+static uint16_t a_as608_port_uart_read(as608_handle_t *handle, uint8_t *buf, uint16_t len)
 {
-    uint16_t i;
     uint16_t l;
-    uint16_t ll;
-    uint16_t sum;
-    uint16_t sum_check;
-    uint16_t read_len;
     
-    handle->delay_ms(ms);                                                                      /* delay */
-    l = handle->uart_read(handle->buf, 384);                                                   /* read data */
-    if (l != 0)                                                                                /* check length */
+    if (handle->transport != NULL)                                      /* check transport */
     {
-        if (l < 12)                                                                            /* check min length */
-        {
-            handle->debug_print("as608: decode failed.\n");                                    /* decode failed */
-            
-            return 2;                                                                          /* return error */
-        }
-        ll = l - 2;                                                                            /* no check sum */
-        sum = 0;                                                                               /* init 0 */
-        for(i = 6; i < ll; i++)                                                                /* loop */
-        {
-            sum += handle->buf[i];                                                             /* sum all */
-        }
-        sum_check = (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1];        /* sum check */
-        if (sum != sum_check)                                                                  /* check sum */
-        {
-            handle->debug_print("as608: sum check error.\n");                                  /* sum check error */
-            
-            return 3;                                                                          /* return error */
-        }
-        ll = (uint16_t)((uint16_t)handle->buf[7] << 8) | handle->buf[8];                       /* get length */
-        if (ll + 9 != l)                                                                       /* check length */
-        {
-            handle->debug_print("as608: len is invalid.\n");                                   /* len is invalid */
-            
-            return 4;                                                                          /* return error */
-        }
-        if ((handle->buf[0] != 0xEF) || (handle->buf[1] != 0x01))                              /* check header */
-        {
-            handle->debug_print("as608: header is invalid.\n");                                /* header is invalid */
-            
-            return 5;                                                                          /* return error */
-        }
-        *addr = (uint32_t)((uint32_t)handle->buf[2] << 24) | 
-                (uint32_t)((uint32_t)handle->buf[3] << 16) |
-                (uint32_t)((uint32_t)handle->buf[4] << 8)  |
-                (uint32_t)((uint32_t)handle->buf[5] << 0);                                     /* set address */
-        if (handle->buf[6] != AS608_TYPE_RESPONSE)                                             /* check type */
-        {
-            handle->debug_print("as608: type is invalid.\n");                                  /* type is invalid */
-            
-            return 6;                                                                          /* return error */
-        }
-        read_len = ((*len) < (ll - 2)) ? (*len) : (ll - 2);                                    /* set length */
-        memcpy(buf, &handle->buf[9], read_len);                                                /* copy data */
-        *len = read_len;                                                                       /* set addr */
-        
-        return 0;                                                                              /* success return 0 */
+        l = handle->transport->uart_read(handle->ctx, buf, len);        /* transport uart read */
     }
     else
     {
-        handle->debug_print("as608: no response.\n");                                          /* no response */
-        
-        return 2;                                                                              /* return error */
+        l = handle->uart_read(buf, len);                                /* uart read */
+    }
+    if (handle->stats != NULL)                                          /* check stats */
+    {
+        handle->stats->byte_in += l;                                    /* add received bytes */
     }
+    
+    return l;                                                           /* return length */
 }
 
 /**
- * @brief         uart decode with length
- * @param[in]     *handle pointer to an as608 handle structure
- * @param[in]     input_len input length
- * @param[in]     ms delay in ms
- * @param[out]    *addr pointer to an address buffer
- * @param[out]    *buf pointer to an output buffer
- * @param[in,out] *len pointer to a buffer length buffer
- * @return        status code
- *                - 0 success
- *                - 1 decode failed
- *                - 2 no response
- *                - 3 sum check error
- *                - 4 len is invalid
- *                - 5 header is invalid
- *                - 6 type is invalid
- * @note          none
+ * @brief     port uart write
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
  */
-static uint8_t a_as608_uart_decode_with_length(as608_handle_t *handle, uint16_t input_len,
-                                               uint32_t ms, uint32_t *addr,
-                                               uint8_t *buf, uint16_t *len)
+static uint8_t a_as608_port_uart_write(as608_handle_t *handle, uint8_t *buf, uint16_t len)
 {
-    uint16_t i;
-    uint16_t l;
-    uint16_t ll;
-    uint16_t sum;
-    uint16_t sum_check;
-    uint16_t read_len;
-    
-    handle->delay_ms(ms);                                                                      /* delay */
-    l = handle->uart_read(handle->buf, input_len);                                             /* read data */
-    if (l != 0)                                                                                /* check length */
+    if (handle->stats != NULL)                                          /* check stats */
     {
-        if (l < 12)                                                                            /* check min length */
-        {
-            handle->debug_print("as608: decode failed.\n");                                    /* decode failed */
-            
-            return 2;                                                                          /* return error */
-        }
-        if (l != input_len)                                                                    /* check min length */
-        {
-            handle->debug_print("as608: decode failed.\n");                                    /* decode failed */
-            
-            return 2;                                                                          /* return error */
-        }
-        ll = l - 2;                                                                            /* no check sum */
-        sum = 0;                                                                               /* init 0 */
-        for(i = 6; i < ll; i++)                                                                /* loop */
-        {
-            sum += handle->buf[i];                                                             /* sum all */
-        }
-        sum_check = (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1];        /* sum check */
-        if (sum != sum_check)                                                                  /* check sum */
-        {
-            handle->debug_print("as608: sum check error.\n");                                  /* sum check error */
-            
-            return 3;                                                                          /* return error */
-        }
-        ll = (uint16_t)((uint16_t)handle->buf[7] << 8) | handle->buf[8];                       /* get length */
-        if (ll + 9 != l)                                                                       /* check length */
-        {
-            handle->debug_print("as608: len is invalid.\n");                                   /* len is invalid */
-            
-            return 4;                                                                          /* return error */
-        }
-        if ((handle->buf[0] != 0xEF) || (handle->buf[1] != 0x01))                              /* check header */
-        {
-            handle->debug_print("as608: header is invalid.\n");                                /* header is invalid */
-            
-            return 5;                                                                          /* return error */
-        }
-        *addr = (uint32_t)((uint32_t)handle->buf[2] << 24) | 
-                (uint32_t)((uint32_t)handle->buf[3] << 16) |
-                (uint32_t)((uint32_t)handle->buf[4] << 8)  |
-                (uint32_t)((uint32_t)handle->buf[5] << 0);                                     /* set address */
-        if (handle->buf[6] != AS608_TYPE_RESPONSE)                                             /* check type */
-        {
-            handle->debug_print("as608: type is invalid.\n");                                  /* type is invalid */
-            
-            return 6;                                                                          /* return error */
-        }
-        read_len = ((*len) < (ll - 2)) ? (*len) : (ll - 2);                                    /* set length */
-        memcpy(buf, &handle->buf[9], read_len);                                                /* copy data */
-        *len = read_len;                                                                       /* set addr */
-        
-        return 0;                                                                              /* success return 0 */
+        handle->stats->byte_out += len;                                 /* add sent bytes */
+    }
+    if (handle->transport != NULL)                                      /* check transport */
+    {
+        return handle->transport->uart_write(handle->ctx, buf, len);    /* transport uart write */
     }
     else
     {
-        handle->debug_print("as608: no response.\n");                                          /* no response */
-        
-        return 2;                                                                              /* return error */
+        return handle->uart_write(buf, len);                            /* uart write */
     }
 }
 
 /**
- * @brief         uart parse data
- * @param[in]     *handle pointer to an as608 handle structure
- * @param[in]     ms delay in ms
- * @param[out]    *addr pointer to an address buffer
- * @param[out]    *buf pointer to an output buffer
- * @param[in,out] *len pointer to a buffer length buffer
- * @param[out]    *end_enable pointer to an end bool buffer
- * @param[out]    *full_enable pointer to a full bool buffer
- * @return        status code
- *                - 0 success
- *                - 1 parse data failed
- *                - 2 no response
- *                - 3 sum check error
- *                - 4 len is invalid
- *                - 5 header is invalid
- *                - 6 type is invalid
- * @note          none
+ * @brief     port check the uart writev
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    1 if a uart_writev function is linked, otherwise 0
+ * @note      none
  */
-static uint8_t a_as608_uart_parse_data(as608_handle_t *handle, uint32_t ms,uint32_t *addr, uint8_t *buf, 
-                                       uint16_t *len, as608_bool_t *end_enable, as608_bool_t *full_enable)
+static uint8_t a_as608_port_has_uart_writev(as608_handle_t *handle)
 {
-    uint16_t i;
-    uint16_t l;
-    uint16_t ll;
-    uint16_t sum;
-    uint16_t sum_check;
-    uint16_t read_len;
+    return ((handle->transport != NULL) && (handle->transport->uart_writev != NULL));    /* check transport uart_writev */
+}
+
+/**
+ * @brief     port uart writev
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *iov pointer to an io vector array
+ * @param[in] count io vector count
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a uart_writev function must be linked
+ */
+static uint8_t a_as608_port_uart_writev(as608_handle_t *handle, as608_iovec_t *iov, uint8_t count)
+{
+    uint8_t i;
     
-    handle->delay_ms(ms);                                                                      /* delay */
-    l = handle->uart_read(handle->buf, 9);                                                     /* read data */
-    if (l != 0)                                                                                /* check length */
+    if (handle->stats != NULL)                                                  /* check stats */
     {
-        if (l != 9)                                                                            /* check min length */
-        {
-            handle->debug_print("as608: parse failed.\n");                                     /* parse failed */
-            
-            return 2;                                                                          /* return error */
-        }
-        l = (uint16_t)(((uint16_t)handle->buf[7]) << 8) | handle->buf[8];                      /* get length */
-        if (l > 256)
-        {
-            handle->debug_print("as608: len is invalid.\n");                                   /* len is invalid */
-            
-            return 4;                                                                          /* return error */
-        }
-        ll = handle->uart_read(&handle->buf[9], l);                                            /* read data */
-        if (ll != l)                                                                           /* check the read length */
-        {
-            handle->debug_print("as608: parse failed.\n");                                     /* parse failed */
-            
-            return 2;                                                                          /* return error */
-        }
-        l += 9;                                                                                /* add header length */
-        ll = l - 2;                                                                            /* no check sum */
-        sum = 0;                                                                               /* init 0 */
-        for(i = 6; i < ll; i++)                                                                /* loop */
-        {
-            sum += handle->buf[i];                                                             /* sum all */
-        }
-        sum_check = (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1];        /* sum check */
-        if (sum != sum_check)                                                                  /* check sum */
-        {
-            handle->debug_print("as608: sum check error.\n");                                  /* sum check error */
-            
-            return 3;                                                                          /* return error */
-        }
-        ll = (uint16_t)((uint16_t)handle->buf[7] << 8) | handle->buf[8];                       /* get length */
-        if (ll + 9 != l)                                                                       /* check length */
+        for (i = 0; i < count; i++)                                             /* loop */
         {
-            handle->debug_print("as608: len is invalid.\n");                                   /* len is invalid */
-            
-            return 4;                                                                          /* return error */
-        }
-        if ((handle->buf[0] != 0xEF) || (handle->buf[1] != 0x01))                              /* check header */
-        {
-            handle->debug_print("as608: header is invalid.\n");                                /* header is invalid */
-            
-            return 5;                                                                          /* return error */
-        }
-        *addr = (uint32_t)((uint32_t)handle->buf[2] << 24) | 
-                (uint32_t)((uint32_t)handle->buf[3] << 16) |
-                (uint32_t)((uint32_t)handle->buf[4] << 8)  |
-                (uint32_t)((uint32_t)handle->buf[5] << 0);                                     /* set address */
-        if (handle->buf[6] == AS608_TYPE_DATA)                                                 /* if data type */
-        {
-            *end_enable = AS608_BOOL_FALSE;                                                    /* disable end */
-        }
-        else if (handle->buf[6] == AS608_TYPE_END)                                             /* if end */
-        {
-            *end_enable = AS608_BOOL_TRUE;                                                     /* enable end */
-        }
-        else
-        {
-            handle->debug_print("as608: type is invalid.\n");                                  /* type is invalid */
-            
-            return 6;                                                                          /* return error */
-        }
-        read_len = ((*len) < (ll - 2)) ? (*len) : (ll - 2);                                    /* set length */
-        memcpy(buf, &handle->buf[9], read_len);                                                /* copy data */
-        *len = read_len;                                                                       /* set addr */
-        if ((ll - 2) > (*len))                                                                 /* check buffer full */
-        {
-            *full_enable = AS608_BOOL_TRUE;                                                    /* full */
-        }
-        else
-        {
-            *full_enable = AS608_BOOL_FALSE;                                                   /* not full */
+            handle->stats->byte_out += iov[i].len;                              /* add sent bytes */
         }
-        
-        return 0;                                                                              /* success return 0 */
-    }
-    else
-    {
-        handle->debug_print("as608: no response.\n");                                          /* no response */
-        
-        return 2;                                                                              /* return error */
     }
+    
+    return handle->transport->uart_writev(handle->ctx, iov, count);            /* transport uart writev */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     port uart flush
  * @param[in] *handle pointer to an as608 handle structure
- * @param[in] addr chip address
  * @return    status code
  *            - 0 success
- *            - 1 uart initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 read params failed
+ *            - 1 uart flush failed
  * @note      none
  */
-uint8_t as608_init(as608_handle_t *handle, uint32_t addr)
+static uint8_t a_as608_port_uart_flush(as608_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t buf[17];
-    uint16_t len;
-    uint32_t addr_check;
-    
-    if (handle == NULL)                                              /* check handle */
+    if (handle->transport != NULL)                              /* check transport */
     {
-        return 2;                                                    /* return error */
+        return handle->transport->uart_flush(handle->ctx);      /* transport uart flush */
     }
-    if (handle->debug_print == NULL)                                 /* check debug_print */
+    else
     {
-        return 3;                                                    /* return error */
+        return handle->uart_flush();                            /* uart flush */
     }
-    if (handle->uart_init == NULL)                                   /* check uart_init */
+}
+
+/**
+ * @brief     port check the uart drain
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    1 if a uart_drain function is linked, otherwise 0
+ * @note      none
+ */
+static uint8_t a_as608_port_has_uart_drain(as608_handle_t *handle)
+{
+    if (handle->transport != NULL)                              /* check transport */
     {
-        handle->debug_print("as608: uart_init is null.\n");          /* uart_init is null */
-        
-        return 3;                                                    /* return error */
+        return (handle->transport->uart_drain != NULL);         /* check transport uart_drain */
     }
-    if (handle->uart_deinit == NULL)                                 /* check uart_deinit */
+    else
     {
-        handle->debug_print("as608: uart_deinit is null.\n");        /* uart_deinit is null */
-        
-        return 3;                                                    /* return error */
+        return (handle->uart_drain != NULL);                    /* check uart_drain */
     }
-    if (handle->uart_read == NULL)                                   /* check uart_read */
+}
+
+/**
+ * @brief     port uart drain
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart drain failed
+ * @note      it returns at once if no uart_drain function is linked
+ */
+static uint8_t a_as608_port_uart_drain(as608_handle_t *handle)
+{
+    if (a_as608_port_has_uart_drain(handle) == 0)               /* check uart_drain */
     {
-        handle->debug_print("as608: uart_read is null.\n");          /* uart_read is null */
-        
-        return 3;                                                    /* return error */
+        return 0;                                               /* success return 0 */
     }
-    if (handle->uart_write == NULL)                                  /* check uart_write */
+    if (handle->transport != NULL)                              /* check transport */
     {
-        handle->debug_print("as608: uart_write is null.\n");         /* uart_write is null */
-        
-        return 3;                                                    /* return error */
-    } 
-    if (handle->uart_flush == NULL)                                  /* check uart_flush */
+        return handle->transport->uart_drain(handle->ctx);      /* transport uart drain */
+    }
+    else
     {
-        handle->debug_print("as608: uart_flush is null.\n");         /* uart_flush is null */
-        
-        return 3;                                                    /* return error */
+        return handle->uart_drain();                            /* uart drain */
     }
-    if (handle->delay_ms == NULL)                                    /* check delay_ms */
+}
+
+/**
+ * @brief     port delay ms
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_as608_port_delay_ms(as608_handle_t *handle, uint32_t ms)
+{
+    if (handle->transport != NULL)                              /* check transport */
     {
-        handle->debug_print("as608: delay_ms is null.\n");           /* delay_ms is null */
-        
-        return 3;                                                    /* return error */
+        handle->transport->delay_ms(handle->ctx, ms);           /* transport delay ms */
+    }
+    else
+    {
+        handle->delay_ms(ms);                                   /* delay ms */
     }
+}
 
-    if (handle->uart_init() != 0)                                    /* uart init */
+/**
+ * @brief     port check the timestamp
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    1 if a timestamp function is linked, otherwise 0
+ * @note      none
+ */
+static uint8_t a_as608_port_has_timestamp(as608_handle_t *handle)
+{
+    if (handle->transport != NULL)                              /* check transport */
     {
-        handle->debug_print("as608: uart init failed.\n");           /* uart init failed */
-        
-        return 1;                                                    /* return error */
+        return (handle->transport->timestamp_ms != NULL);       /* check transport timestamp_ms */
     }
-    handle->delay_ms(100);                                           /* delay 100ms */
-    
-    buf[0] = AS608_COMMAND_READ_SYS_PARA;                                      /* read sys para */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
-    if (res != 0)                                                              /* check result */
+    else
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        (void)handle->uart_deinit();                                           /* uart deinit */
-        
-        return 4;                                                              /* return error */
+        return (handle->timestamp_ms != NULL);                  /* check timestamp_ms */
     }
-    len = 17;                                                                  /* len 17 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+}
+
+/**
+ * @brief     port timestamp ms
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    monotonic time in ms
+ * @note      returns 0 if no timestamp function is linked
+ */
+static uint32_t a_as608_port_timestamp_ms(as608_handle_t *handle)
+{
+    if (a_as608_port_has_timestamp(handle) == 0)                /* check timestamp */
     {
-        (void)handle->uart_deinit();                                           /* uart deinit */
-        
-        return 4;                                                              /* return error */
+        return 0;                                               /* return 0 */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    if (handle->transport != NULL)                              /* check transport */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
-        (void)handle->uart_deinit();                                           /* uart deinit */
-        
-        return 4;                                                              /* return error */
+        return handle->transport->timestamp_ms(handle->ctx);    /* transport timestamp ms */
     }
-    if (len != 17)                                                             /* check length */
+    else
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
-        (void)handle->uart_deinit();                                           /* uart deinit */
-        
-        return 4;                                                              /* return error */
+        return handle->timestamp_ms();                          /* timestamp ms */
     }
-    handle->status = buf[0];                                                   /* save status */
-    handle->packet_size = (uint16_t)(32.0f * powf(2.0f, (float)((uint16_t)
-                          ((uint16_t)buf[13] << 8) | buf[14])));               /* packet size */
-    
-    handle->inited = 1;                                                        /* flag finish initialization */
-    
-    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     port check the uart set baud rate
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    1 if a uart_set_baud_rate function is linked, otherwise 0
+ * @note      none
+ */
+static uint8_t a_as608_port_has_set_baud_rate(as608_handle_t *handle)
+{
+    if (handle->transport != NULL)                                    /* check transport */
+    {
+        return (handle->transport->uart_set_baud_rate != NULL);       /* check transport uart_set_baud_rate */
+    }
+    else
+    {
+        return (handle->uart_set_baud_rate != NULL);                  /* check uart_set_baud_rate */
+    }
+}
+
+/**
+ * @brief     port uart set baud rate
  * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] baud_rate baud rate
  * @return    status code
  *            - 0 success
- *            - 1 uart deinit failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 1 set baud rate failed
  * @note      none
  */
-uint8_t as608_deinit(as608_handle_t *handle)
+static uint8_t a_as608_port_uart_set_baud_rate(as608_handle_t *handle, uint32_t baud_rate)
 {
-    if (handle == NULL)                                             /* check handle */
+    if (a_as608_port_has_set_baud_rate(handle) == 0)                              /* check uart_set_baud_rate */
     {
-        return 2;                                                   /* return error */
+        return 1;                                                                 /* return error */
     }
-    if (handle->inited != 1)                                        /* check handle initialization */
+    if (handle->transport != NULL)                                                /* check transport */
     {
-        return 3;                                                   /* return error */
+        return handle->transport->uart_set_baud_rate(handle->ctx, baud_rate);     /* transport uart set baud rate */
     }
-    
-    if (handle->uart_deinit() != 0)                                 /* uart deinit */
+    else
     {
-        handle->debug_print("as608: uart deinit failed.\n");        /* uart deinit failed */
-        
-        return 1;                                                   /* return error */
-    }         
-    handle->inited = 0;                                             /* flag close */
-    
-    return 0;                                                       /* success return 0 */ 
+        return handle->uart_set_baud_rate(baud_rate);                             /* uart set baud rate */
+    }
 }
 
 /**
- * @brief      get the last status
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     stats count an error
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] error stats error
+ * @note      none
  */
-uint8_t as608_get_last_status(as608_handle_t *handle, as608_status_t *status)
+static void a_as608_stats_error(as608_handle_t *handle, as608_stats_error_t error)
 {
-    if (handle == NULL)                              /* check handle */
+    if (handle->stats != NULL)                                    /* check stats */
     {
-        return 2;                                    /* return error */
+        handle->stats->error[error]++;                            /* error++ */
     }
-    if (handle->inited != 1)                         /* check handle initialization */
+}
+
+/**
+ * @brief     stats sync the parser counters
+ * @param[in] *handle pointer to an as608 handle structure
+ * @note      the parser counters are added to the header and len errors
+ */
+static void a_as608_stats_sync(as608_handle_t *handle)
+{
+    if (handle->stats != NULL)                                                                       /* check stats */
     {
-        return 3;                                    /* return error */
+        handle->stats->error[AS608_STATS_ERROR_HEADER] += 
+            handle->parser.dropped - handle->stats_dropped;                                          /* add dropped bytes */
+        handle->stats->error[AS608_STATS_ERROR_LEN] += 
+            handle->parser.invalid - handle->stats_invalid;                                          /* add invalid headers */
     }
+    handle->stats_dropped = handle->parser.dropped;                                                  /* save dropped bytes */
+    handle->stats_invalid = handle->parser.invalid;                                                  /* save invalid headers */
+}
+
+/**
+ * @brief     stats count a received frame
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr frame address
+ * @note      the latency is counted for the first frame after the command only
+ */
+static void a_as608_stats_frame(as608_handle_t *handle, uint32_t addr)
+{
+    uint8_t bucket;
+    uint32_t ms;
     
-    *status = (as608_status_t)handle->status;        /* get status */
+    if (handle->stats == NULL)                                                           /* check stats */
+    {
+        return;                                                                          /* return */
+    }
+    handle->stats->frame_received[handle->stats_command]++;                              /* frame++ */
+    if (addr != handle->stats_addr)                                                      /* check address */
+    {
+        handle->stats->error[AS608_STATS_ERROR_ADDR]++;                                  /* addr error++ */
+    }
+    if (handle->stats_pending != 0)                                                      /* check pending */
+    {
+        ms = a_as608_port_timestamp_ms(handle) - handle->stats_start;                    /* get latency */
+        bucket = 0;                                                                      /* init 0 */
+        while ((ms != 0) && (bucket < (AS608_STATS_BUCKET_MAX - 1)))                     /* find the log2 bucket */
+        {
+            ms >>= 1;                                                                    /* ms / 2 */
+            bucket++;                                                                    /* bucket++ */
+        }
+        handle->stats->latency[handle->stats_command][bucket]++;                         /* count latency */
+        handle->stats_pending = 0;                                                       /* clear pending */
+    }
+}
+
+/**
+ * @brief     trace one frame
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] direction frame direction
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @param[in] sum check sum on the wire
+ * @note      the header is read from handle->buf
+ */
+static void a_as608_trace(as608_handle_t *handle, as608_trace_direction_t direction, 
+                          uint8_t *payload, uint16_t len, uint16_t sum)
+{
+    as608_trace_frame_t frame;
     
-    return 0;                                        /* success return 0 */ 
+    if (handle->trace == NULL)                                                           /* check trace */
+    {
+        return;                                                                          /* return */
+    }
+    frame.timestamp_ms = a_as608_port_timestamp_ms(handle);                              /* set timestamp */
+    frame.direction = direction;                                                         /* set direction */
+    frame.addr = (uint32_t)((uint32_t)handle->buf[2] << 24) | 
+                 (uint32_t)((uint32_t)handle->buf[3] << 16) |
+                 (uint32_t)((uint32_t)handle->buf[4] << 8)  |
+                 (uint32_t)((uint32_t)handle->buf[5] << 0);                              /* set address */
+    frame.type = handle->buf[6];                                                         /* set type */
+    frame.command = handle->last_command;                                                /* set command */
+    frame.payload = payload;                                                             /* set payload */
+    frame.len = len;                                                                     /* set length */
+    frame.sum = sum;                                                                     /* set sum */
+    handle->trace(handle->trace_arg, &frame);                                            /* trace */
 }
 
 /**
- * @brief      get image
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get image failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief     uart reset the receive buffer
+ * @param[in] *handle pointer to an as608 handle structure
+ * @note      none
  */
-uint8_t as608_get_image(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+static void a_as608_uart_rx_reset(as608_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t buf[1];
-    uint16_t len;
-    uint32_t addr_check;
+    a_as608_stats_sync(handle);                                   /* sync the stats */
+    handle->rx_tail = 0;                                          /* reset tail */
+    handle->rx_len = 0;                                           /* reset length */
+    (void)as608_parser_init(&handle->parser, handle->buf, 384);   /* reset the parser */
+    handle->stats_dropped = 0;                                    /* reset dropped bytes */
+    handle->stats_invalid = 0;                                    /* reset invalid headers */
+}
+
+/**
+ * @brief     uart write data
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr address
+ * @param[in] type command type
+ * @param[in] *buf pointer to an input buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 len is over
+ * @note      with a uart_writev function the payload is sent from buf and only the header is built in the handle,
+ *            otherwise the frame is copied to the handle buffer
+ */
+static uint8_t a_as608_uart_write(as608_handle_t *handle, uint32_t addr, uint8_t type, 
+                                  uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint16_t sum;
+    uint16_t l;
+    uint8_t trailer[2];
+    as608_iovec_t iov[3];
     
-    if (handle == NULL)                                                        /* check handle */
+    if ((len + 11) > 384)                                   /* check length */
     {
-        return 2;                                                              /* return error */
+        return 2;                                           /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    handle->buf[0] = 0xEF;                                  /* header 0 */
+    handle->buf[1] = 0x01;                                  /* header 1 */
+    handle->buf[2] = (addr >> 24) & 0xFF;                   /* set addr 3 */
+    handle->buf[3] = (addr >> 16) & 0xFF;                   /* set addr 2 */
+    handle->buf[4] = (addr >> 8) & 0xFF;                    /* set addr 1 */
+    handle->buf[5] = (addr >> 0) & 0xFF;                    /* set addr 0 */
+    handle->buf[6] = type;                                  /* set type */
+    l = len + 2;                                            /* add check crc */
+    handle->buf[7] = (l >> 8) & 0xFF;                       /* set l msb */
+    handle->buf[8] = (l >> 0) & 0xFF;                       /* set l lsb */
+    sum = handle->buf[6] + handle->buf[7] + handle->buf[8]; /* sum the type and the length */
+    for (i = 0; i < len; i++)                               /* loop */
     {
-        return 3;                                                              /* return error */
+        sum += buf[i];                                      /* sum the payload in place */
     }
+    trailer[0] = (sum >> 8) & 0xFF;                         /* set sum msb */
+    trailer[1] = (sum >> 0) & 0xFF;                         /* set sum lsb */
     
-    buf[0] = AS608_COMMAND_GET_IMAGE;                                          /* get image */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
-    if (res != 0)                                                              /* check result */
+    if (type == AS608_TYPE_COMMAND)                         /* flush the stale bytes before a command only */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
+        if (a_as608_port_uart_drain(handle) != 0)          /* send the pending bytes first */
+        {
+            return 1;                                       /* return error */
+        }
+        if (a_as608_port_uart_flush(handle) != 0)          /* uart flush */
+        {
+            return 1;                                       /* return error */
+        }
     }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 500, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    a_as608_uart_rx_reset(handle);                          /* reset the receive buffer */
+    if ((type == AS608_TYPE_COMMAND) && (len != 0))         /* check the command */
     {
-        return 4;                                                              /* return error */
+        handle->last_command = buf[0];                      /* save command */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    a_as608_trace(handle, AS608_TRACE_DIRECTION_TX, buf, len, sum);                /* trace the frame */
+    if ((handle->stats != NULL) && (type == AS608_TYPE_COMMAND) && 
+        (len != 0) && (buf[0] < AS608_STATS_COMMAND_MAX))  /* check the command */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
-        
-        return 5;                                                              /* return error */
+        handle->stats->command_sent[buf[0]]++;              /* command++ */
+        handle->stats_command = buf[0];                     /* save command */
+        handle->stats_addr = addr;                          /* save address */
+        handle->stats_start = a_as608_port_timestamp_ms(handle);    /* save the start time */
+        handle->stats_pending = 1;                          /* set pending */
     }
-    if (len != 1)                                                              /* check length */
+    if (a_as608_port_has_uart_writev(handle) != 0)         /* check writev */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        iov[0].buf = handle->buf;                           /* set the header */
+        iov[0].len = 9;                                     /* set the header length */
+        iov[1].buf = buf;                                   /* set the payload */
+        iov[1].len = len;                                   /* set the payload length */
+        iov[2].buf = trailer;                               /* set the sum */
+        iov[2].len = 2;                                     /* set the sum length */
+        if (a_as608_port_uart_writev(handle, iov, 3) != 0)  /* write data */
+        {
+            return 1;                                       /* return error */
+        }
         
-        return 6;                                                              /* return error */
+        return 0;                                           /* success return 0 */
+    }
+    memcpy(handle->buf + 9, buf, len);                      /* copy data */
+    l = len + 9;                                            /* add 9 */
+    handle->buf[l] = trailer[0];                            /* set sum msb */
+    handle->buf[l + 1] = trailer[1];                        /* set sum lsb */
+    if (a_as608_port_uart_write(handle, handle->buf, l + 2) != 0)    /* write data */
+    {
+        return 1;                                           /* return error */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                               /* success return 0 */
 }
 
 /**
- * @brief      generate feature
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[in]  num buffer number
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 generate feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief     parser push one header byte
+ * @param[in] *parser pointer to an as608 parser structure
+ * @param[in] data input byte
+ * @return    status code
+ *            - 0 success
+ *            - 1 len is invalid
+ * @note      none
  */
-uint8_t as608_generate_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, as608_status_t *status)
+static uint8_t a_as608_parser_push(as608_parser_t *parser, uint8_t data)
 {
-    uint8_t res;
-    uint8_t buf[2];
-    uint16_t len;
-    uint32_t addr_check;
+    uint16_t l;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (parser->point == 0)                                                        /* header 0 */
     {
-        return 2;                                                              /* return error */
+        if (data == 0xEF)                                                          /* check header 0 */
+        {
+            parser->buf[0] = data;                                                 /* save data */
+            parser->point = 1;                                                     /* set point */
+        }
+        else
+        {
+            parser->dropped++;                                                     /* drop the byte */
+        }
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    else if (parser->point == 1)                                                   /* header 1 */
     {
-        return 3;                                                              /* return error */
+        if (data == 0x01)                                                          /* check header 1 */
+        {
+            parser->buf[1] = data;                                                 /* save data */
+            parser->point = 2;                                                     /* set point */
+        }
+        else if (data == 0xEF)                                                     /* a new header 0 */
+        {
+            parser->dropped++;                                                     /* drop the old header 0 */
+        }
+        else
+        {
+            parser->dropped += 2;                                                  /* drop both bytes */
+            parser->point = 0;                                                     /* resync */
+        }
     }
-    
-    buf[0] = AS608_COMMAND_GEN_CHAR;                                           /* generate char */
-    buf[1] = num;                                                              /* set buffer number */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
-    if (res != 0)                                                              /* check result */
+    else
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
+        parser->buf[parser->point] = data;                                         /* save data */
+        parser->point++;                                                           /* point++ */
+        if (parser->point == 9)                                                    /* if the header is received */
+        {
+            l = (uint16_t)((uint16_t)parser->buf[7] << 8) | parser->buf[8];        /* get length */
+            if ((l < 2) || (l > (parser->size - 9)))                               /* check length */
+            {
+                return 1;                                                          /* return error */
+            }
+            parser->need = l + 9;                                                  /* set the frame length */
+        }
     }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 400, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     get the elapsed time
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] start start timestamp
+ * @param[in] polled polled time in ms
+ * @return    elapsed time in ms
+ * @note      if timestamp_ms is not linked, the polled time is used
+ */
+static uint32_t a_as608_elapsed_ms(as608_handle_t *handle, uint32_t start, uint32_t polled)
+{
+    if (a_as608_port_has_timestamp(handle) != 0)                       /* check timestamp */
     {
-        return 4;                                                              /* return error */
+        return a_as608_port_timestamp_ms(handle) - start;              /* return the elapsed time */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    else
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
-        
-        return 5;                                                              /* return error */
+        return polled;                                                 /* return the polled time */
     }
-    if (len != 1)                                                              /* check length */
+}
+
+/**
+ * @brief     get the wire time of a frame
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] len frame payload length
+ * @return    wire time in ms
+ * @note      the whole frame is sent at n_9600 x 9600bps 8N1
+ */
+static uint32_t a_as608_wire_ms(as608_handle_t *handle, uint16_t len)
+{
+    uint32_t bits;
+    uint32_t baud;
+    
+    bits = ((uint32_t)len + 11) * 10;                                    /* frame bits with start and stop bits */
+    baud = (uint32_t)handle->n_9600 * 9600;                              /* get the baud rate */
+    
+    return (bits * 1000 + baud - 1) / baud;                              /* return the wire time */
+}
+
+/**
+ * @brief     get the stream packet gap
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] len data packet payload length
+ * @return    gap in ms
+ * @note      the gap covers the wire time of the whole frame plus the margin
+ */
+static uint32_t a_as608_stream_gap_ms(as608_handle_t *handle, uint16_t len)
+{
+    if (handle->stream_pacing == 0)                                      /* check pacing */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
-        
-        return 6;                                                              /* return error */
+        return AS608_STREAM_LEGACY_GAP_MS;                               /* return the legacy gap */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
     
-    return 0;                                                                  /* success return 0 */
+    return a_as608_wire_ms(handle, len) + handle->stream_margin_ms;      /* return the gap */
 }
 
 /**
- * @brief      match feature
+ * @brief     uart write the data packets
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr chip address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart write failed
+ * @note      the data is split into packet_size data packets and the last one is sent as an end packet,
+ *            with pacing and a uart_drain function the next packet is sent once the last one is on the wire,
+ *            otherwise it is sent after the stream gap since the last one started,
+ *            no gap follows the end packet
+ */
+static uint8_t a_as608_uart_write_stream(as608_handle_t *handle, uint32_t addr, uint8_t *buf, uint16_t len)
+{
+    uint8_t type;
+    uint16_t l;
+    uint16_t point;
+    uint32_t gap;
+    uint32_t start;
+    uint32_t elapsed;
+    
+    point = 0;                                                                  /* init 0 */
+    while (1)                                                                   /* loop */
+    {
+        l = len - point;                                                        /* get the remain length */
+        l = (l > handle->packet_size) ? handle->packet_size : l;                /* get the packet length */
+        type = ((point + l) >= len) ? AS608_TYPE_END : AS608_TYPE_DATA;         /* set the packet type */
+        start = a_as608_port_timestamp_ms(handle);                              /* get the start time */
+        if (a_as608_uart_write(handle, addr, type, buf + point, l) != 0)        /* write data */
+        {
+            return 1;                                                           /* return error */
+        }
+        point += l;                                                             /* point adds l */
+        if (type == AS608_TYPE_END)                                             /* no gap after the end packet */
+        {
+            return 0;                                                           /* success return 0 */
+        }
+        if ((handle->stream_pacing != 0) && 
+            (a_as608_port_has_uart_drain(handle) != 0))                         /* check drain */
+        {
+            if (a_as608_port_uart_drain(handle) != 0)                           /* wait for the wire */
+            {
+                return 1;                                                       /* return error */
+            }
+            continue;                                                           /* next packet */
+        }
+        gap = a_as608_stream_gap_ms(handle, l);                                 /* get the gap */
+        elapsed = a_as608_elapsed_ms(handle, start, 0);                         /* get the elapsed time */
+        if (elapsed < gap)                                                      /* check the elapsed time */
+        {
+            a_as608_port_delay_ms(handle, gap - elapsed);                       /* wait for the rest gap */
+        }
+    }
+}
+
+/**
+ * @brief      uart poll the received bytes
  * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[out] *score pointer to a score buffer
- * @param[out] *status pointer to a status buffer
+ * @param[out] *len pointer to a frame length buffer
  * @return     status code
  *             - 0 success
- *             - 1 match feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ *             - 1 need more data
+ * @note       the function never waits, it parses the bytes which are available now
  */
-uint8_t as608_match_feature(as608_handle_t *handle, uint32_t addr, uint16_t *score, as608_status_t *status)
+static uint8_t a_as608_uart_receive_poll(as608_handle_t *handle, uint16_t *len)
 {
     uint8_t res;
-    uint8_t buf[3];
-    uint16_t len;
-    uint32_t addr_check;
+    uint16_t l;
+    uint16_t used;
     
-    if (handle == NULL)                                                        /* check handle */
-    {
-        return 2;                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    while (1)                                                                                  /* loop */
     {
-        return 3;                                                              /* return error */
+        if (handle->rx_len != 0)                                                               /* parse the received bytes */
+        {
+            res = as608_parser_feed(&handle->parser, &handle->rx_buf[handle->rx_tail], 
+                                    handle->rx_len, &used, len);                               /* feed the parser */
+            handle->rx_tail += used;                                                           /* tail adds used length */
+            handle->rx_len -= used;                                                            /* length - used length */
+            if (res == 0)                                                                      /* if a frame is received */
+            {
+                return 0;                                                                      /* success return 0 */
+            }
+        }
+        handle->rx_tail = 0;                                                                   /* the buffer is empty */
+        l = a_as608_port_uart_read(handle, handle->rx_buf, 384);                               /* read data */
+        handle->rx_len = (l < 384) ? l : 384;                                                  /* set length */
+        if (l == 0)                                                                            /* if no data */
+        {
+            return 1;                                                                          /* need more data */
+        }
     }
+}
+
+/**
+ * @brief      uart receive one frame
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  ms timeout in ms
+ * @param[out] *len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive timeout
+ *             - 2 no response
+ * @note       the frame is saved in handle->buf and the function returns as soon as the whole frame is received,
+ *             the bytes received after the frame are kept in the receive buffer for the next frame
+ */
+static uint8_t a_as608_uart_receive(as608_handle_t *handle, uint32_t ms, uint16_t *len)
+{
+    uint32_t start;
+    uint32_t polled;
+    uint32_t dropped;
     
-    buf[0] = AS608_COMMAND_MATCH;                                              /* match feature */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
-    if (res != 0)                                                              /* check result */
+    polled = 0;                                                                                /* init 0 */
+    dropped = handle->parser.dropped;                                                          /* save the dropped bytes */
+    start = a_as608_port_timestamp_ms(handle);                                                 /* get the start time */
+    while (a_as608_uart_receive_poll(handle, len) != 0)                                        /* poll the frame */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
+        if (a_as608_elapsed_ms(handle, start, polled) >= ms)                                   /* check timeout */
+        {
+            if ((handle->parser.point == 0) && (handle->parser.dropped == dropped))            /* check received bytes */
+            {
+                return 2;                                                                      /* return error */
+            }
+            
+            return 1;                                                                          /* return error */
+        }
+        a_as608_port_delay_ms(handle, AS608_RECEIVE_POLL_MS);                                  /* wait for data */
+        polled += AS608_RECEIVE_POLL_MS;                                                       /* polled time adds poll period */
     }
-    len = 3;                                                                   /* len 3 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief         uart receive the frame bytes until the parser reaches a point
+ * @param[in]     *handle pointer to an as608 handle structure
+ * @param[in]     point parser point to reach
+ * @param[in]     start start timestamp
+ * @param[in,out] *polled pointer to a polled time buffer
+ * @param[in]     ms timeout in ms
+ * @param[out]    *len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 receive timeout
+ * @note          the uart is never read over the point, so the bytes after it stay in the uart,
+ *                len is set when the point completes the frame
+ */
+static uint8_t a_as608_uart_receive_until(as608_handle_t *handle, uint16_t point, uint32_t start, 
+                                          uint32_t *polled, uint32_t ms, uint16_t *len)
+{
+    uint16_t l;
+    uint16_t n;
+    uint16_t used;
+    
+    while (handle->parser.point < point)                                                       /* loop */
     {
-        return 4;                                                              /* return error */
+        n = point - handle->parser.point;                                                      /* one byte moves at most one point */
+        if (handle->rx_len != 0)                                                               /* parse the received bytes */
+        {
+            n = (n < handle->rx_len) ? n : handle->rx_len;                                     /* never parse over the point */
+            if (as608_parser_feed(&handle->parser, &handle->rx_buf[handle->rx_tail], 
+                                  n, &used, len) == 0)                                         /* feed the parser */
+            {
+                handle->rx_tail += used;                                                       /* tail adds used length */
+                handle->rx_len -= used;                                                        /* length - used length */
+                
+                return 0;                                                                      /* the frame is received */
+            }
+            handle->rx_tail += used;                                                           /* tail adds used length */
+            handle->rx_len -= used;                                                            /* length - used length */
+            
+            continue;                                                                          /* continue */
+        }
+        handle->rx_tail = 0;                                                                   /* the buffer is empty */
+        l = a_as608_port_uart_read(handle, handle->rx_buf, n);                                 /* read the needed bytes only */
+        handle->rx_len = (l < n) ? l : n;                                                      /* set length */
+        if (l == 0)                                                                            /* if no data */
+        {
+            if (a_as608_elapsed_ms(handle, start, *polled) >= ms)                              /* check timeout */
+            {
+                return 1;                                                                      /* return error */
+            }
+            a_as608_port_delay_ms(handle, AS608_RECEIVE_POLL_MS);                              /* wait for data */
+            *polled += AS608_RECEIVE_POLL_MS;                                                  /* polled time adds poll period */
+        }
     }
-    if (addr_check != addr)                                                    /* check addr */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      uart receive one frame with exact length reads
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  ms timeout in ms
+ * @param[in]  expect expected frame length
+ * @param[out] *len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive timeout
+ *             - 2 no response
+ * @note       the uart is asked for the expected bytes only, so the receive returns as soon as they arrive,
+ *             a longer frame is completed with the length in its header and a shorter one ends at its own length
+ */
+static uint8_t a_as608_uart_receive_exact(as608_handle_t *handle, uint32_t ms, uint16_t expect, uint16_t *len)
+{
+    uint32_t start;
+    uint32_t polled;
+    uint32_t dropped;
+    
+    polled = 0;                                                                                /* init 0 */
+    dropped = handle->parser.dropped;                                                          /* save the dropped bytes */
+    start = a_as608_port_timestamp_ms(handle);                                                 /* get the start time */
+    if (a_as608_uart_receive_until(handle, expect, start, &polled, ms, len) != 0)              /* receive the expected bytes */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        if ((handle->parser.point == 0) && (handle->parser.dropped == dropped))                /* check received bytes */
+        {
+            return 2;                                                                          /* return error */
+        }
         
-        return 5;                                                              /* return error */
+        return 1;                                                                              /* return error */
     }
-    if (len != 3)                                                              /* check length */
+    if (handle->parser.point != 0)                                                             /* the frame is longer */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
-        
-        return 6;                                                              /* return error */
+        if (a_as608_uart_receive_until(handle, handle->parser.need, start, 
+                                       &polled, ms, len) != 0)                                 /* receive the rest */
+        {
+            return 1;                                                                          /* return error */
+        }
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
-    *score = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                       /* set the score */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      search feature
+ * @brief      check the received response frame
  * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[in]  num buffer num
- * @param[in]  start_page start page
- * @param[in]  page_number page number
- * @param[out] *found_page pointer to a found page buffer
- * @param[out] *score pointer to a score buffer
- * @param[out] *status pointer to a status buffer
+ * @param[in]  l frame length
+ * @param[out] *addr pointer to an address buffer
  * @return     status code
  *             - 0 success
- *             - 1 search feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
+ *             - 2 decode failed
+ *             - 3 sum check error
+ *             - 6 type is invalid
  * @note       none
  */
-uint8_t as608_search_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
-                             uint16_t start_page, uint16_t page_number, uint16_t *found_page, 
-                             uint16_t *score, as608_status_t *status)
+static uint8_t a_as608_uart_check_frame(as608_handle_t *handle, uint16_t l, uint32_t *addr)
 {
-    uint8_t res;
-    uint8_t buf[6];
-    uint16_t len;
-    uint32_t addr_check;
+    uint16_t i;
+    uint16_t sum;
+    uint16_t sum_check;
     
-    if (handle == NULL)                                                        /* check handle */
+    a_as608_trace(handle, AS608_TRACE_DIRECTION_RX, &handle->buf[9], l - 11, 
+                  (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1]);         /* trace the frame */
+    if (l < 12)                                                                                /* check min length */
     {
-        return 2;                                                              /* return error */
+        handle->debug_print("as608: decode failed.\n");                                        /* decode failed */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_LEN);                                    /* len error */
+        
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    sum = 0;                                                                                   /* init 0 */
+    for(i = 6; i < (l - 2); i++)                                                               /* loop */
     {
-        return 3;                                                              /* return error */
+        sum += handle->buf[i];                                                                 /* sum all */
+    }
+    sum_check = (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1];            /* sum check */
+    if (sum != sum_check)                                                                      /* check sum */
+    {
+        handle->debug_print("as608: sum check error.\n");                                      /* sum check error */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_SUM);                                    /* sum error */
+        
+        return 3;                                                                              /* return error */
+    }
+    *addr = (uint32_t)((uint32_t)handle->buf[2] << 24) | 
+            (uint32_t)((uint32_t)handle->buf[3] << 16) |
+            (uint32_t)((uint32_t)handle->buf[4] << 8)  |
+            (uint32_t)((uint32_t)handle->buf[5] << 0);                                         /* set address */
+    if (handle->buf[6] != AS608_TYPE_RESPONSE)                                                 /* check type */
+    {
+        handle->debug_print("as608: type is invalid.\n");                                      /* type is invalid */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_TYPE);                                   /* type error */
+        
+        return 6;                                                                              /* return error */
     }
+    a_as608_stats_frame(handle, *addr);                                                        /* count the frame */
     
-    buf[0] = AS608_COMMAND_SEARCH;                                             /* search char */
-    buf[1] = num;                                                              /* set buffer number */
-    buf[2] = (start_page >> 8) & 0xFF;                                         /* start page msb */
-    buf[3] = (start_page >> 0) & 0xFF;                                         /* start page lsb */
-    buf[4] = (page_number >> 8) & 0xFF;                                        /* page number msb */
-    buf[5] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 6);        /* write data */
-    if (res != 0)                                                              /* check result */
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief         uart decode
+ * @param[in]     *handle pointer to an as608 handle structure
+ * @param[in]     ms timeout in ms
+ * @param[out]    *addr pointer to an address buffer
+ * @param[out]    *buf pointer to an output buffer
+ * @param[in,out] *len pointer to a buffer length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 decode failed
+ *                - 2 no response
+ *                - 3 sum check error
+ *                - 4 len is invalid
+ *                - 5 header is invalid
+ *                - 6 type is invalid
+ * @note          none
+ */
+static uint8_t a_as608_uart_decode(as608_handle_t *handle, uint32_t ms, uint32_t *addr,
+                                   uint8_t *buf, uint16_t *len)
+{
+    uint8_t res;
+    uint16_t l;
+    uint16_t ll;
+    uint16_t read_len;
+    uint16_t expect;
+    
+    expect = (handle->last_command < 0x20) ? gsc_as608_response_len[handle->last_command] : 0; /* get the response length */
+    if ((expect != 0) && (handle->rx_len == 0))                                                /* check the response length */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
+        res = a_as608_uart_receive_exact(handle, ms, expect, &l);                              /* receive the expected bytes */
     }
-    len = 5;                                                                   /* len 5 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    else
     {
-        return 4;                                                              /* return error */
+        res = a_as608_uart_receive(handle, ms, &l);                                            /* receive the frame */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    if (res == 2)                                                                              /* check no response */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        handle->debug_print("as608: no response.\n");                                          /* no response */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_TIMEOUT);                                /* timeout error */
         
-        return 5;                                                              /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (len != 5)                                                              /* check length */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        handle->debug_print("as608: decode failed.\n");                                        /* decode failed */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_TIMEOUT);                                /* timeout error */
         
-        return 6;                                                              /* return error */
+        return 2;                                                                              /* return error */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
-    *found_page = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                  /* set the found page */
-    *score = (uint16_t)((uint16_t)buf[3] << 8) | buf[4];                       /* set the score */
+    res = a_as608_uart_check_frame(handle, l, addr);                                           /* check the frame */
+    if (res != 0)                                                                              /* check result */
+    {
+        return res;                                                                            /* return error */
+    }
+    ll = (uint16_t)((uint16_t)handle->buf[7] << 8) | handle->buf[8];                           /* get length */
+    read_len = ((*len) < (ll - 2)) ? (*len) : (ll - 2);                                        /* set length */
+    memcpy(buf, &handle->buf[9], read_len);                                                    /* copy data */
+    *len = read_len;                                                                           /* set addr */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      combine feature
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 combine feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief         uart decode with length
+ * @param[in]     *handle pointer to an as608 handle structure
+ * @param[in]     input_len input length
+ * @param[in]     ms timeout in ms
+ * @param[out]    *addr pointer to an address buffer
+ * @param[out]    *buf pointer to an output buffer
+ * @param[in,out] *len pointer to a buffer length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 decode failed
+ *                - 2 no response
+ *                - 3 sum check error
+ *                - 4 len is invalid
+ *                - 5 header is invalid
+ *                - 6 type is invalid
+ * @note          none
  */
-uint8_t as608_combine_feature(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+static uint8_t a_as608_uart_decode_with_length(as608_handle_t *handle, uint16_t input_len,
+                                               uint32_t ms, uint32_t *addr,
+                                               uint8_t *buf, uint16_t *len)
 {
     uint8_t res;
-    uint8_t buf[1];
-    uint16_t len;
-    uint32_t addr_check;
+    uint16_t l;
     
-    if (handle == NULL)                                                        /* check handle */
+    res = a_as608_uart_decode(handle, ms, addr, buf, len);                                     /* decode */
+    if (res != 0)                                                                              /* check result */
     {
-        return 2;                                                              /* return error */
+        return res;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    l = (uint16_t)((uint16_t)handle->buf[7] << 8) | handle->buf[8];                            /* get length */
+    if ((l + 9) != input_len)                                                                  /* check frame length */
     {
-        return 3;                                                              /* return error */
+        handle->debug_print("as608: decode failed.\n");                                        /* decode failed */
+        
+        return 2;                                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_REG_MODEL;                                          /* reg model */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
-    if (res != 0)                                                              /* check result */
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      uart receive one data packet directly into a buffer
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  ms timeout in ms
+ * @param[out] *buf pointer to a payload buffer
+ * @param[in]  size payload buffer size
+ * @param[out] *len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive timeout
+ *             - 2 no response
+ *             - 3 payload is larger than the buffer
+ * @note       only the header and the check sum are saved in handle->buf, the payload bytes already in the
+ *             receive buffer are copied and the rest are read from the uart straight into buf,
+ *             if the payload is larger than the buffer, the whole frame is saved in handle->buf and 3 is returned
+ */
+static uint8_t a_as608_uart_receive_direct(as608_handle_t *handle, uint32_t ms, uint8_t *buf, 
+                                           uint16_t size, uint16_t *len)
+{
+    uint16_t l;
+    uint16_t n;
+    uint16_t point;
+    uint32_t start;
+    uint32_t polled;
+    uint32_t dropped;
+    
+    polled = 0;                                                                                /* init 0 */
+    dropped = handle->parser.dropped;                                                          /* save the dropped bytes */
+    start = a_as608_port_timestamp_ms(handle);                                                 /* get the start time */
+    if (a_as608_uart_receive_until(handle, 9, start, &polled, ms, len) != 0)                   /* receive the header */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        if ((handle->parser.point == 0) && (handle->parser.dropped == dropped))                /* check received bytes */
+        {
+            return 2;                                                                          /* return error */
+        }
         
-        return 1;                                                              /* return error */
+        return 1;                                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    n = handle->parser.need - 11;                                                              /* get the payload length */
+    if ((n > size) || (handle->parser.point != 9))                                             /* check the buffer size */
     {
-        return 4;                                                              /* return error */
+        if (a_as608_uart_receive_until(handle, handle->parser.need, start, 
+                                       &polled, ms, len) != 0)                                 /* receive into the frame buffer */
+        {
+            return 1;                                                                          /* return error */
+        }
+        
+        return 3;                                                                              /* return the frame */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    point = 0;                                                                                 /* init 0 */
+    while (point < n)                                                                          /* receive the payload */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
-        
-        return 5;                                                              /* return error */
+        if (handle->rx_len != 0)                                                               /* copy the received bytes */
+        {
+            l = n - point;                                                                     /* get the remain length */
+            l = (l < handle->rx_len) ? l : handle->rx_len;                                     /* get the copy length */
+            memcpy(buf + point, &handle->rx_buf[handle->rx_tail], l);                          /* copy data */
+            handle->rx_tail += l;                                                              /* tail adds length */
+            handle->rx_len -= l;                                                               /* length - length */
+            point += l;                                                                        /* point adds length */
+            
+            continue;                                                                          /* continue */
+        }
+        handle->rx_tail = 0;                                                                   /* the buffer is empty */
+        l = a_as608_port_uart_read(handle, buf + point, n - point);                            /* read into the buffer */
+        l = (l < (n - point)) ? l : (n - point);                                               /* limit length */
+        point += l;                                                                            /* point adds length */
+        if (l == 0)                                                                            /* if no data */
+        {
+            if (a_as608_elapsed_ms(handle, start, polled) >= ms)                               /* check timeout */
+            {
+                handle->parser.point = 0;                                                      /* drop the frame */
+                
+                return 1;                                                                      /* return error */
+            }
+            a_as608_port_delay_ms(handle, AS608_RECEIVE_POLL_MS);                              /* wait for data */
+            polled += AS608_RECEIVE_POLL_MS;                                                   /* polled time adds poll period */
+        }
     }
-    if (len != 1)                                                              /* check length */
+    handle->parser.point = handle->parser.need - 2;                                            /* skip the payload */
+    if (a_as608_uart_receive_until(handle, handle->parser.need, start, 
+                                   &polled, ms, len) != 0)                                     /* receive the check sum */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
-        
-        return 6;                                                              /* return error */
+        return 1;                                                                              /* return error */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      store feature
+ * @brief      uart parse data
  * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[in]  num buffer num
- * @param[in]  page_number page number
- * @param[out] *status pointer to a status buffer
+ * @param[in]  ms timeout in ms
+ * @param[out] *addr pointer to an address buffer
+ * @param[out] *buf pointer to a payload buffer or NULL
+ * @param[in]  size payload buffer size
+ * @param[out] **data pointer to a data pointer buffer
+ * @param[out] *len pointer to a data length buffer
+ * @param[out] *end_enable pointer to an end bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 store feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ *             - 1 parse data failed
+ *             - 2 no response
+ *             - 3 sum check error
+ *             - 4 len is invalid
+ *             - 6 type is invalid
+ * @note       the payload is received straight into buf when it fits and data points to buf,
+ *             otherwise data points to the frame buffer and is valid until the next receive
  */
-uint8_t as608_store_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
-                            uint16_t page_number, as608_status_t *status)
+static uint8_t a_as608_uart_parse_data(as608_handle_t *handle, uint32_t ms, uint32_t *addr, uint8_t *buf, 
+                                       uint16_t size, uint8_t **data, uint16_t *len, as608_bool_t *end_enable)
 {
     uint8_t res;
-    uint8_t buf[4];
-    uint16_t len;
-    uint32_t addr_check;
+    uint16_t i;
+    uint16_t l;
+    uint16_t sum;
+    uint16_t sum_check;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (buf != NULL)                                                                           /* check the buffer */
     {
-        return 2;                                                              /* return error */
+        res = a_as608_uart_receive_direct(handle, ms, buf, size, &l);                          /* receive into the buffer */
+        *data = (res == 0) ? buf : &handle->buf[9];                                            /* set data */
+        res = (res == 3) ? 0 : res;                                                            /* the frame is received */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    else
     {
-        return 3;                                                              /* return error */
+        res = a_as608_uart_receive(handle, ms, &l);                                            /* receive the frame */
+        *data = &handle->buf[9];                                                               /* set data */
     }
-    
-    buf[0] = AS608_COMMAND_STORE_CHAR;                                         /* store char */
-    buf[1] = num;                                                              /* set buffer number */
-    buf[2] = (page_number >> 8) & 0xFF;                                        /* page number msb */
-    buf[3] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 4);        /* write data */
-    if (res != 0)                                                              /* check result */
+    if (res == 2)                                                                              /* check no response */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        handle->debug_print("as608: no response.\n");                                          /* no response */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_TIMEOUT);                                /* timeout error */
         
-        return 1;                                                              /* return error */
+        return 2;                                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    if (res != 0)                                                                              /* check result */
     {
-        return 4;                                                              /* return error */
+        handle->debug_print("as608: parse failed.\n");                                         /* parse failed */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_TIMEOUT);                                /* timeout error */
+        
+        return 2;                                                                              /* return error */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    a_as608_trace(handle, AS608_TRACE_DIRECTION_RX, *data, l - 11, 
+                  (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1]);         /* trace the frame */
+    if (l > (256 + 11))                                                                        /* check length */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_LEN);                                    /* len error */
         
-        return 5;                                                              /* return error */
+        return 4;                                                                              /* return error */
     }
-    if (len != 1)                                                              /* check length */
+    sum = (uint16_t)handle->buf[6] + handle->buf[7] + handle->buf[8];                          /* sum the header */
+    for(i = 0; i < (l - 11); i++)                                                              /* loop */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        sum += (*data)[i];                                                                     /* sum the payload in place */
+    }
+    sum_check = (uint16_t)((uint16_t)handle->buf[l - 2] << 8) | handle->buf[l - 1];            /* sum check */
+    if (sum != sum_check)                                                                      /* check sum */
+    {
+        handle->debug_print("as608: sum check error.\n");                                      /* sum check error */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_SUM);                                    /* sum error */
         
-        return 6;                                                              /* return error */
+        return 3;                                                                              /* return error */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
+    *addr = (uint32_t)((uint32_t)handle->buf[2] << 24) | 
+            (uint32_t)((uint32_t)handle->buf[3] << 16) |
+            (uint32_t)((uint32_t)handle->buf[4] << 8)  |
+            (uint32_t)((uint32_t)handle->buf[5] << 0);                                         /* set address */
+    if (handle->buf[6] == AS608_TYPE_DATA)                                                     /* if data type */
+    {
+        *end_enable = AS608_BOOL_FALSE;                                                        /* disable end */
+    }
+    else if (handle->buf[6] == AS608_TYPE_END)                                                 /* if end */
+    {
+        *end_enable = AS608_BOOL_TRUE;                                                         /* enable end */
+    }
+    else
+    {
+        handle->debug_print("as608: type is invalid.\n");                                      /* type is invalid */
+        a_as608_stats_error(handle, AS608_STATS_ERROR_TYPE);                                   /* type error */
+        
+        return 6;                                                                              /* return error */
+    }
+    a_as608_stats_frame(handle, *addr);                                                        /* count the frame */
+    *len = l - 11;                                                                             /* set length */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      load feature
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[in]  num buffer num
- * @param[in]  page_number page number
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 load feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief     get the upload packet deadline
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    deadline in ms
+ * @note      the deadline covers the wire time of a full data packet at the current rate plus the margin
  */
-uint8_t as608_load_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
-                           uint16_t page_number, as608_status_t *status)
+static uint32_t a_as608_upload_packet_ms(as608_handle_t *handle)
+{
+    return a_as608_wire_ms(handle, handle->packet_size) + AS608_UPLOAD_PACKET_MARGIN_MS;    /* return the deadline */
+}
+
+/**
+ * @brief     uart receive the data packets
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr chip address
+ * @param[in] *sink pointer to a sink function
+ * @param[in] *arg pointer to a sink argument
+ * @return    status code
+ *            - 0 success
+ *            - 4 decode failed
+ *            - 5 addr is invalid
+ *            - 7 sink stopped
+ * @note      every data packet is passed to the sink as soon as it is received,
+ *            each packet is waited for its wire time at the current rate plus the margin
+ */
+static uint8_t a_as608_uart_upload_data(as608_handle_t *handle, uint32_t addr, as608_sink_t sink, void *arg)
 {
     uint8_t res;
-    uint8_t buf[4];
-    uint16_t len;
+    uint8_t *data;
+    uint16_t l;
     uint32_t addr_check;
+    as608_bool_t end_enable;
     
-    if (handle == NULL)                                                        /* check handle */
-    {
-        return 2;                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                   /* check handle initialization */
-    {
-        return 3;                                                              /* return error */
-    }
-    
-    buf[0] = AS608_COMMAND_LOAD_CHAR;                                          /* load char */
-    buf[1] = num;                                                              /* set buffer number */
-    buf[2] = (page_number >> 8) & 0xFF;                                        /* page number msb */
-    buf[3] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 4);        /* write data */
-    if (res != 0)                                                              /* check result */
-    {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
-    }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
-    {
-        return 4;                                                              /* return error */
-    }
-    if (addr_check != addr)                                                    /* check addr */
-    {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
-        
-        return 5;                                                              /* return error */
-    }
-    if (len != 1)                                                              /* check length */
+    while (1)                                                                  /* loop */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
-        
-        return 6;                                                              /* return error */
+        res = a_as608_uart_parse_data(handle, a_as608_upload_packet_ms(handle), 
+                                      &addr_check, NULL, 0,
+                                      &data, &l, &end_enable);                 /* parse the data */
+        if (res != 0)                                                          /* check result */
+        {
+            return 4;                                                          /* return error */
+        }
+        if (addr_check != addr)                                                /* check addr */
+        {
+            handle->debug_print("as608: addr is invalid.\n");                  /* addr is invalid */
+            
+            return 5;                                                          /* return error */
+        }
+        if (sink(arg, data, l) != 0)                                           /* pass to the sink */
+        {
+            return 7;                                                          /* return error */
+        }
+        if (end_enable == AS608_BOOL_TRUE)                                     /* if the last packet */
+        {
+            return 0;                                                          /* success return 0 */
+        }
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
-    
-    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief         upload feature
+ * @brief         uart receive the data packets into a buffer
  * @param[in]     *handle pointer to an as608 handle structure
  * @param[in]     addr chip address
- * @param[in]     num buffer num
- * @param[out]    *output_buffer pointer to an output buffer
- * @param[in,out] *output_len pointer to an output length buffer
- * @param[out]    *status pointer to a status buffer
+ * @param[out]    *buf pointer to an output buffer
+ * @param[in,out] *len pointer to an output length buffer
  * @return        status code
  *                - 0 success
- *                - 1 upload feature failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
  *                - 4 decode failed
  *                - 5 addr is invalid
- *                - 6 len is invalid
  *                - 7 buffer is full
- * @note          none
+ * @note          the payloads are received straight into the buffer,
+ *                each packet is waited for its wire time at the current rate plus the margin
  */
-uint8_t as608_upload_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
-                             uint8_t *output_buffer, uint16_t *output_len, as608_status_t *status)
+static uint8_t a_as608_uart_upload_buffer(as608_handle_t *handle, uint32_t addr, uint8_t *buf, uint16_t *len)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t *data;
     uint16_t l;
     uint16_t point;
-    uint16_t len;
     uint32_t addr_check;
+    as608_bool_t end_enable;
     
-    if (handle == NULL)                                                        /* check handle */
-    {
-        return 2;                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                   /* check handle initialization */
-    {
-        return 3;                                                              /* return error */
-    }
-    
-    buf[0] = AS608_COMMAND_UP_CHAR;                                            /* upload char */
-    buf[1] = num;                                                              /* set buffer number */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
-    if (res != 0)                                                              /* check result */
-    {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
-    }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, 
-                                          buf, &len);                          /* decode */
-    if (res != 0)                                                              /* check result */
-    {
-        return 4;                                                              /* return error */
-    }
-    if (addr_check != addr)                                                    /* check addr */
-    {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
-        
-        return 5;                                                              /* return error */
-    }
-    if (len != 1)                                                              /* check length */
-    {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
-        
-        return 6;                                                              /* return error */
-    }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
     point = 0;                                                                 /* init 0 */
-    len = *output_len;                                                         /* get the length */
-    l = *output_len;                                                           /* get the length */
     while (1)                                                                  /* loop */
     {
-        as608_bool_t end_enable;
-        as608_bool_t full_enable;
-        
-        l = len;                                                               /* set the remain max buffer size */
-        res = a_as608_uart_parse_data(handle, 100, &addr_check, 
-                                      output_buffer + point, 
-                                      &l, &end_enable, &full_enable);          /* parse the data */
-        if (res != 0)
+        res = a_as608_uart_parse_data(handle, a_as608_upload_packet_ms(handle), 
+                                      &addr_check, buf + point, *len - point, 
+                                      &data, &l, &end_enable);                 /* parse the data */
+        if (res != 0)                                                          /* check result */
         {
+            *len = point;                                                      /* save the length */
+            
             return 4;                                                          /* return error */
         }
         if (addr_check != addr)                                                /* check addr */
         {
             handle->debug_print("as608: addr is invalid.\n");                  /* addr is invalid */
+            *len = point;                                                      /* save the length */
             
             return 5;                                                          /* return error */
         }
-        len -= l;                                                              /* remain length - read length */
-        point += l;                                                            /* current point adds read length */
-        if (full_enable == AS608_BOOL_TRUE)                                    /* if buffer is full */
+        if (data != (buf + point))                                             /* if the payload is not received in place */
         {
+            memcpy(buf + point, data, *len - point);                           /* copy the remain size */
             handle->debug_print("as608: buffer is full.\n");                   /* buffer is full */
             
             return 7;                                                          /* return error */
         }
+        point += l;                                                            /* point adds length */
         if (end_enable == AS608_BOOL_TRUE)                                     /* if the last packet */
         {
-            break;                                                             /* break */
+            *len = point;                                                      /* save the length */
+            
+            return 0;                                                          /* success return 0 */
         }
     }
-    *output_len = point;                                                       /* save the length */
-    
-    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      download feature
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[in]  num buffer num
- * @param[in]  *input_buffer pointer to an input buffer
- * @param[in]  input_len input length
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 download feature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr chip address
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 read params failed
+ * @note      none
  */
-uint8_t as608_download_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
-                               uint8_t *input_buffer, uint16_t input_len, as608_status_t *status)
+uint8_t as608_init(as608_handle_t *handle, uint32_t addr)
 {
     uint8_t res;
-    uint8_t buf[2];
-    uint16_t i;
-    uint16_t m;
-    uint16_t n;
+    uint8_t buf[17];
     uint16_t len;
     uint32_t addr_check;
     
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
-    
-    buf[0] = AS608_COMMAND_DOWN_CHAR;                                                          /* download char */
-    buf[1] = num;                                                                              /* set buffer number */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);                        /* write data */
-    if (res != 0)                                                                              /* check result */
+    if (handle == NULL)                                              /* check handle */
     {
-        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
-        
-        return 1;                                                                              /* return error */
+        return 2;                                                    /* return error */
     }
-    len = 1;                                                                                   /* len 1 */
-    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                                              /* check result */
+    if (handle->debug_print == NULL)                                 /* check debug_print */
     {
-        return 4;                                                                              /* return error */
+        return 3;                                                    /* return error */
     }
-    if (addr_check != addr)                                                                    /* check addr */
+    if (handle->transport != NULL)                                   /* check transport */
     {
-        handle->debug_print("as608: addr is invalid.\n");                                      /* addr is invalid */
-        
-        return 5;                                                                              /* return error */
+        if ((handle->transport->uart_init == NULL) || 
+            (handle->transport->uart_deinit == NULL) || 
+            (handle->transport->uart_read == NULL) || 
+            (handle->transport->uart_write == NULL) || 
+            (handle->transport->uart_flush == NULL) || 
+            (handle->transport->delay_ms == NULL))                   /* check transport functions */
+        {
+            handle->debug_print("as608: transport is invalid.\n");   /* transport is invalid */
+            
+            return 3;                                                /* return error */
+        }
     }
-    if (len != 1)                                                                              /* check length */
+    else
     {
-        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
+        if (handle->uart_init == NULL)                               /* check uart_init */
+        {
+            handle->debug_print("as608: uart_init is null.\n");      /* uart_init is null */
         
-        return 6;                                                                              /* return error */
-    }
-    handle->status = buf[0];                                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                                  /* set status */
-    
-    m = input_len / handle->packet_size;                                                       /* set m */
-    n = input_len % handle->packet_size;                                                       /* set n */
-    if (n != 0)                                                                                /* check n */
-    {
-        for (i = 0; i < m; i++)                                                                /* m times */
+            return 3;                                                /* return error */
+        }
+        if (handle->uart_deinit == NULL)                             /* check uart_deinit */
         {
-            res = a_as608_uart_write(handle, addr, AS608_TYPE_DATA, 
-                                     input_buffer + i * handle->packet_size, 
-                                     handle->packet_size);                                     /* write data */
-            if (res != 0)                                                                      /* check result */
-            {
-                handle->debug_print("as608: uart write failed.\n");                            /* uart write failed */
-                
-                return 1;                                                                      /* return error */
-            }
-            handle->delay_ms(100);                                                             /* delay 100ms */
+            handle->debug_print("as608: uart_deinit is null.\n");    /* uart_deinit is null */
+        
+            return 3;                                                /* return error */
         }
-        res = a_as608_uart_write(handle, addr, AS608_TYPE_END, 
-                                 input_buffer + m * handle->packet_size, n);                   /* write data */
-        if (res != 0)                                                                          /* check result */
+        if (handle->uart_read == NULL)                               /* check uart_read */
         {
-            handle->debug_print("as608: uart write failed.\n");                                /* uart write failed */
-            
-            return 1;                                                                          /* return error */
+            handle->debug_print("as608: uart_read is null.\n");      /* uart_read is null */
+        
+            return 3;                                                /* return error */
         }
-        handle->delay_ms(100);                                                                 /* delay 100ms */
-    }
-    else
-    {
-        for (i = 0; i < (m - 1); i++)                                                          /* m - 1 times */
+        if (handle->uart_write == NULL)                              /* check uart_write */
         {
-            res = a_as608_uart_write(handle, addr, AS608_TYPE_DATA, 
-                                     input_buffer + i * handle->packet_size, 
-                                     handle->packet_size);                                     /* write data */
-            if (res != 0)                                                                      /* check result */
-            {
-                handle->debug_print("as608: uart write failed.\n");                            /* uart write failed */
-                
-                return 1;                                                                      /* return error */
-            }
-            handle->delay_ms(100);                                                             /* delay 100ms */
+            handle->debug_print("as608: uart_write is null.\n");     /* uart_write is null */
+        
+            return 3;                                                /* return error */
+        } 
+        if (handle->uart_flush == NULL)                              /* check uart_flush */
+        {
+            handle->debug_print("as608: uart_flush is null.\n");     /* uart_flush is null */
+        
+            return 3;                                                /* return error */
         }
-        res = a_as608_uart_write(handle, addr, AS608_TYPE_END, 
-                                 input_buffer + (m - 1) * handle->packet_size, 
-                                 handle->packet_size);                                         /* write data */
-        if (res != 0)                                                                          /* check result */
+        if (handle->delay_ms == NULL)                                /* check delay_ms */
         {
-            handle->debug_print("as608: uart write failed.\n");                                /* uart write failed */
-            
-            return 1;                                                                          /* return error */
+            handle->debug_print("as608: delay_ms is null.\n");       /* delay_ms is null */
+        
+            return 3;                                                /* return error */
         }
-        handle->delay_ms(100);                                                                 /* delay 100ms */
     }
-    
-    return 0;                                                                                  /* success return 0 */
-}
 
-/**
- * @brief         upload image
- * @param[in]     *handle pointer to an as608 handle structure
- * @param[in]     addr chip address
- * @param[out]    *output_buffer pointer to an output buffer
- * @param[in,out] *output_len pointer to an output length buffer
- * @param[out]    *status pointer to a status buffer
- * @return        status code
- *                - 0 success
- *                - 1 upload image failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
- *                - 4 decode failed
- *                - 5 addr is invalid
- *                - 6 len is invalid
- *                - 7 buffer is full
- * @note          none
- */
-uint8_t as608_upload_image(as608_handle_t *handle, uint32_t addr, uint8_t *output_buffer, 
-                           uint16_t *output_len, as608_status_t *status)
-{
-    uint8_t res;
-    uint8_t buf[1];
-    uint16_t l;
-    uint16_t point;
-    uint16_t len;
-    uint32_t addr_check;
-    
-    if (handle == NULL)                                                        /* check handle */
-    {
-        return 2;                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (a_as608_port_uart_init(handle) != 0)                         /* uart init */
     {
-        return 3;                                                              /* return error */
+        handle->debug_print("as608: uart init failed.\n");           /* uart init failed */
+        
+        return 1;                                                    /* return error */
     }
+    a_as608_uart_rx_reset(handle);                                   /* reset the receive buffer */
+    a_as608_port_delay_ms(handle, 100);                              /* delay 100ms */
     
-    buf[0] = AS608_COMMAND_UP_IMAGE;                                           /* upload image */
+    buf[0] = AS608_COMMAND_READ_SYS_PARA;                                      /* read sys para */
     res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        (void)a_as608_port_uart_deinit(handle);                                /* uart deinit */
         
-        return 1;                                                              /* return error */
+        return 4;                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode_with_length(handle, 12, 100, 
-                                          &addr_check, buf, &len);             /* decode */
+    len = 17;                                                                  /* len 17 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
+        (void)a_as608_port_uart_deinit(handle);                                /* uart deinit */
+        
         return 4;                                                              /* return error */
     }
     if (addr_check != addr)                                                    /* check addr */
     {
         handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        (void)a_as608_port_uart_deinit(handle);                                /* uart deinit */
         
-        return 5;                                                              /* return error */
+        return 4;                                                              /* return error */
     }
-    if (len != 1)                                                              /* check length */
+    if (len != 17)                                                             /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        (void)a_as608_port_uart_deinit(handle);                                /* uart deinit */
         
-        return 6;                                                              /* return error */
+        return 4;                                                              /* return error */
     }
     handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
-    point = 0;                                                                 /* init 0 */
-    len = *output_len;                                                         /* get the length */
-    l = *output_len;                                                           /* get the length */
-    while (1)                                                                  /* loop */
+    handle->packet_size = (uint16_t)(32.0f * powf(2.0f, (float)((uint16_t)
+                          ((uint16_t)buf[13] << 8) | buf[14])));               /* packet size */
+    handle->n_9600 = (uint16_t)((uint16_t)buf[15] << 8) | buf[16];             /* n_9600 */
+    if (handle->n_9600 == 0)                                                   /* check n_9600 */
     {
-        as608_bool_t end_enable;
-        as608_bool_t full_enable;
-        
-        l = len;                                                               /* set the remain max buffer size */
-        res = a_as608_uart_parse_data(handle, 100, &addr_check, 
-                                      output_buffer + point, 
-                                      &l, &end_enable, &full_enable);          /* parse the data */
-        if (res != 0)
-        {
-            return 4;                                                          /* return error */
-        }
-        if (addr_check != addr)                                                /* check addr */
-        {
-            handle->debug_print("as608: addr is invalid.\n");                  /* addr is invalid */
-            
-            return 5;                                                          /* return error */
-        }
-        len -= l;                                                              /* remain length - read length */
-        point += l;                                                            /* current point adds read length */
-        if (full_enable == AS608_BOOL_TRUE)                                    /* if buffer is full */
-        {
-            handle->debug_print("as608: buffer is full.\n");                   /* buffer is full */
-            
-            return 7;                                                          /* return error */
-        }
-        if (end_enable == AS608_BOOL_TRUE)                                     /* if the last packet */
-        {
-            break;                                                             /* break */
-        }
+        handle->n_9600 = AS608_STREAM_DEFAULT_N_9600;                          /* set the default n_9600 */
     }
-    *output_len = point;                                                       /* save the length */
+    handle->stream_pacing = 1;                                                 /* enable pacing */
+    handle->stream_margin_ms = AS608_STREAM_DEFAULT_MARGIN_MS;                 /* set the default margin */
+    
+    handle->inited = 1;                                                        /* flag finish initialization */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      download image
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[in]  *input_buffer pointer to an input buffer
- * @param[in]  input_len input length
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 download image failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief     close the chip
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t as608_download_image(as608_handle_t *handle, uint32_t addr, uint8_t *input_buffer,
-                             uint16_t input_len, as608_status_t *status)
+uint8_t as608_deinit(as608_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t buf[1];
-    uint16_t i;
-    uint16_t m;
-    uint16_t n;
-    uint16_t len;
-    uint32_t addr_check;
-    
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                             /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                   /* return error */
     }
     
-    buf[0] = AS608_COMMAND_DOWN_IMAGE;                                                         /* download char */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);                        /* write data */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
-        
-        return 1;                                                                              /* return error */
-    }
-    len = 1;                                                                                   /* len 1 */
-    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                                              /* check result */
-    {
-        return 4;                                                                              /* return error */
-    }
-    if (addr_check != addr)                                                                    /* check addr */
-    {
-        handle->debug_print("as608: addr is invalid.\n");                                      /* addr is invalid */
-        
-        return 5;                                                                              /* return error */
-    }
-    if (len != 1)                                                                              /* check length */
+    if (a_as608_port_uart_deinit(handle) != 0)                      /* uart deinit */
     {
-        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
+        handle->debug_print("as608: uart deinit failed.\n");        /* uart deinit failed */
         
-        return 6;                                                                              /* return error */
-    }
-    handle->status = buf[0];                                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                                  /* set status */
+        return 1;                                                   /* return error */
+    }         
+    handle->inited = 0;                                             /* flag close */
     
-    m = input_len / handle->packet_size;                                                       /* set m */
-    n = input_len % handle->packet_size;                                                       /* set n */
-    if (n != 0)                                                                                /* check n */
+    return 0;                                                       /* success return 0 */ 
+}
+
+/**
+ * @brief      get the last status
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_last_status(as608_handle_t *handle, as608_status_t *status)
+{
+    if (handle == NULL)                              /* check handle */
     {
-        for (i = 0; i < m; i++)                                                                /* m times */
-        {
-            res = a_as608_uart_write(handle, addr, AS608_TYPE_DATA, 
-                                     input_buffer + i * handle->packet_size, 
-                                     handle->packet_size);                                     /* write data */
-            if (res != 0)                                                                      /* check result */
-            {
-                handle->debug_print("as608: uart write failed.\n");                            /* uart write failed */
-                
-                return 1;                                                                      /* return error */
-            }
-            handle->delay_ms(100);                                                             /* delay 100ms */
-        }
-        res = a_as608_uart_write(handle, addr, AS608_TYPE_END, 
-                                 input_buffer + m * handle->packet_size, n);                   /* write data */
-        if (res != 0)                                                                          /* check result */
-        {
-            handle->debug_print("as608: uart write failed.\n");                                /* uart write failed */
-            
-            return 1;                                                                          /* return error */
-        }
-        handle->delay_ms(100);                                                                 /* delay 100ms */
+        return 2;                                    /* return error */
     }
-    else
+    if (handle->inited != 1)                         /* check handle initialization */
     {
-        for (i = 0; i < (m - 1); i++)                                                          /* m - 1 times */
-        {
-            res = a_as608_uart_write(handle, addr, AS608_TYPE_DATA, 
-                                     input_buffer + i * handle->packet_size, 
-                                     handle->packet_size);                                     /* write data */
-            if (res != 0)                                                                      /* check result */
-            {
-                handle->debug_print("as608: uart write failed.\n");                            /* uart write failed */
-                
-                return 1;                                                                      /* return error */
-            }
-            handle->delay_ms(100);                                                             /* delay 100ms */
-        }
-        res = a_as608_uart_write(handle, addr, AS608_TYPE_END, 
-                                 input_buffer + (m - 1) * handle->packet_size, 
-                                 handle->packet_size);                                         /* write data */
-        if (res != 0)                                                                          /* check result */
-        {
-            handle->debug_print("as608: uart write failed.\n");                                /* uart write failed */
-            
-            return 1;                                                                          /* return error */
-        }
-        handle->delay_ms(100);                                                                 /* delay 100ms */
+        return 3;                                    /* return error */
     }
     
-    return 0;                                                                                  /* success return 0 */
+    *status = (as608_status_t)handle->status;        /* get status */
+    
+    return 0;                                        /* success return 0 */ 
 }
 
 /**
- * @brief      delete feature
+ * @brief      get image
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  page_number page number
- * @param[in]  number deleted number
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 delete feature failed
+ *             - 1 get image failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1570,10 +1708,10 @@ uint8_t as608_download_image(as608_handle_t *handle, uint32_t addr, uint8_t *inp
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_delete_feature(as608_handle_t *handle, uint32_t addr, uint16_t page_number, uint16_t number, as608_status_t *status)
+uint8_t as608_get_image(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[5];
+    uint8_t buf[1];
     uint16_t len;
     uint32_t addr_check;
     
@@ -1586,12 +1724,8 @@ uint8_t as608_delete_feature(as608_handle_t *handle, uint32_t addr, uint16_t pag
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_DELETE_CHAR;                                        /* delete char feature */
-    buf[1] = (page_number >> 8) & 0xFF;                                        /* page number msb */
-    buf[2] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
-    buf[3] = (number >> 8) & 0xFF;                                             /* number msb */
-    buf[4] = (number >> 0) & 0xFF;                                             /* number lsb */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
+    buf[0] = AS608_COMMAND_GET_IMAGE;                                          /* get image */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -1599,7 +1733,7 @@ uint8_t as608_delete_feature(as608_handle_t *handle, uint32_t addr, uint16_t pag
         return 1;                                                              /* return error */
     }
     len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    res = a_as608_uart_decode(handle, 500, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -1623,13 +1757,14 @@ uint8_t as608_delete_feature(as608_handle_t *handle, uint32_t addr, uint16_t pag
 }
 
 /**
- * @brief      empty all feature
+ * @brief      generate feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
+ * @param[in]  num buffer number
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 empty all feature failed
+ *             - 1 generate feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1637,10 +1772,10 @@ uint8_t as608_delete_feature(as608_handle_t *handle, uint32_t addr, uint16_t pag
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+uint8_t as608_generate_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[1];
+    uint8_t buf[2];
     uint16_t len;
     uint32_t addr_check;
     
@@ -1653,8 +1788,9 @@ uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_sta
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_EMPTY;                                              /* empty all char feature */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    buf[0] = AS608_COMMAND_GEN_CHAR;                                           /* generate char */
+    buf[1] = num;                                                              /* set buffer number */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -1662,7 +1798,7 @@ uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_sta
         return 1;                                                              /* return error */
     }
     len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    res = a_as608_uart_decode(handle, 400, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -1686,14 +1822,14 @@ uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_sta
 }
 
 /**
- * @brief      set baud rate
+ * @brief      match feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  n_9600 n times of 9600
+ * @param[out] *score pointer to a score buffer
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set baud rate failed
+ *             - 1 match feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1701,7 +1837,7 @@ uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_sta
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_9600, as608_status_t *status)
+uint8_t as608_match_feature(as608_handle_t *handle, uint32_t addr, uint16_t *score, as608_status_t *status)
 {
     uint8_t res;
     uint8_t buf[3];
@@ -1717,17 +1853,15 @@ uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_960
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_WRITE_REG;                                          /* write reg */
-    buf[1] = 0x04;                                                             /* baud rate */
-    buf[2] = n_9600;                                                           /* n x 9600 */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
+    buf[0] = AS608_COMMAND_MATCH;                                              /* match feature */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
+    len = 3;                                                                   /* len 3 */
     res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
@@ -1739,7 +1873,7 @@ uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_960
         
         return 5;                                                              /* return error */
     }
-    if (len != 1)                                                              /* check length */
+    if (len != 3)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -1747,19 +1881,24 @@ uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_960
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
+    *score = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                       /* set the score */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      set level
+ * @brief      search feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  level input level
+ * @param[in]  num buffer num
+ * @param[in]  start_page start page
+ * @param[in]  page_number page number
+ * @param[out] *found_page pointer to a found page buffer
+ * @param[out] *score pointer to a score buffer
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set level failed
+ *             - 1 search feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1767,10 +1906,12 @@ uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_960
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_set_level(as608_handle_t *handle, uint32_t addr, as608_level_t level, as608_status_t *status)
+uint8_t as608_search_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                             uint16_t start_page, uint16_t page_number, uint16_t *found_page, 
+                             uint16_t *score, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[3];
+    uint8_t buf[6];
     uint16_t len;
     uint32_t addr_check;
     
@@ -1783,17 +1924,20 @@ uint8_t as608_set_level(as608_handle_t *handle, uint32_t addr, as608_level_t lev
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_WRITE_REG;                                          /* write reg */
-    buf[1] = 0x05;                                                             /* level settings */
-    buf[2] = level;                                                            /* set level */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
+    buf[0] = AS608_COMMAND_SEARCH;                                             /* search char */
+    buf[1] = num;                                                              /* set buffer number */
+    buf[2] = (start_page >> 8) & 0xFF;                                         /* start page msb */
+    buf[3] = (start_page >> 0) & 0xFF;                                         /* start page lsb */
+    buf[4] = (page_number >> 8) & 0xFF;                                        /* page number msb */
+    buf[5] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 6);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
+    len = 5;                                                                   /* len 5 */
     res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
@@ -1805,7 +1949,7 @@ uint8_t as608_set_level(as608_handle_t *handle, uint32_t addr, as608_level_t lev
         
         return 5;                                                              /* return error */
     }
-    if (len != 1)                                                              /* check length */
+    if (len != 5)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -1813,19 +1957,20 @@ uint8_t as608_set_level(as608_handle_t *handle, uint32_t addr, as608_level_t lev
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
+    *found_page = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                  /* set the found page */
+    *score = (uint16_t)((uint16_t)buf[3] << 8) | buf[4];                       /* set the score */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      set packet size
+ * @brief      combine feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  size packet size
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set packet size failed
+ *             - 1 combine feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1833,10 +1978,10 @@ uint8_t as608_set_level(as608_handle_t *handle, uint32_t addr, as608_level_t lev
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_set_packet_size(as608_handle_t *handle, uint32_t addr, as608_packet_size_t size, as608_status_t *status)
+uint8_t as608_combine_feature(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[3];
+    uint8_t buf[1];
     uint16_t len;
     uint32_t addr_check;
     
@@ -1849,10 +1994,8 @@ uint8_t as608_set_packet_size(as608_handle_t *handle, uint32_t addr, as608_packe
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_WRITE_REG;                                          /* write reg */
-    buf[1] = 0x06;                                                             /* size settings */
-    buf[2] = size;                                                             /* set size */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
+    buf[0] = AS608_COMMAND_REG_MODEL;                                          /* reg model */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -1879,21 +2022,20 @@ uint8_t as608_set_packet_size(as608_handle_t *handle, uint32_t addr, as608_packe
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    handle->packet_size = (uint16_t)(32.0f * powf(2.0f, 
-                          (float)((uint16_t)size)));                           /* packet size */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get params
+ * @brief      store feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[out] *param pointer to a param structure
+ * @param[in]  num buffer num
+ * @param[in]  page_number page number
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get params failed
+ *             - 1 store feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1901,10 +2043,11 @@ uint8_t as608_set_packet_size(as608_handle_t *handle, uint32_t addr, as608_packe
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_get_params(as608_handle_t *handle, uint32_t addr, as608_params_t *param, as608_status_t *status)
+uint8_t as608_store_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                            uint16_t page_number, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[17];
+    uint8_t buf[4];
     uint16_t len;
     uint32_t addr_check;
     
@@ -1917,15 +2060,18 @@ uint8_t as608_get_params(as608_handle_t *handle, uint32_t addr, as608_params_t *
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_READ_SYS_PARA;                                      /* read sys para */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    buf[0] = AS608_COMMAND_STORE_CHAR;                                         /* store char */
+    buf[1] = num;                                                              /* set buffer number */
+    buf[2] = (page_number >> 8) & 0xFF;                                        /* page number msb */
+    buf[3] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 4);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 17;                                                                  /* len 17 */
+    len = 1;                                                                   /* len 1 */
     res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
@@ -1937,7 +2083,7 @@ uint8_t as608_get_params(as608_handle_t *handle, uint32_t addr, as608_params_t *
         
         return 5;                                                              /* return error */
     }
-    if (len != 17)                                                             /* check length */
+    if (len != 1)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -1945,32 +2091,20 @@ uint8_t as608_get_params(as608_handle_t *handle, uint32_t addr, as608_params_t *
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    param->status = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                /* set current status */
-    param->sensor_type = (as608_sensor_type_t)
-                         ((uint16_t)((uint16_t)buf[3] << 8) | buf[4]);         /* set sensor type */
-    param->fingerprint_size = (uint16_t)((uint16_t)buf[5] << 8) | buf[6];      /* set fingerprint size */
-    param->level = (as608_level_t)
-                   ((uint16_t)((uint16_t)buf[7] << 8) | buf[8]);               /* set level */
-    param->address = (uint32_t)((uint32_t)buf[9] << 24) |
-                     (uint32_t)((uint32_t)buf[10] << 16) |
-                     (uint32_t)((uint32_t)buf[11] << 8) |
-                     (uint32_t)((uint32_t)buf[12] << 0);                       /* set address */
-    param->packet_size = (as608_packet_size_t)
-                         ((uint16_t)((uint16_t)buf[13] << 8) | buf[14]);       /* set packet size */
-    param->n_9600 = (uint16_t)((uint16_t)buf[15] << 8) | buf[16];              /* set n_9600 */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      enroll
+ * @brief      load feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[out] *page_number pointer to a page number buffer
+ * @param[in]  num buffer num
+ * @param[in]  page_number page number
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 enroll failed
+ *             - 1 load feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -1978,10 +2112,11 @@ uint8_t as608_get_params(as608_handle_t *handle, uint32_t addr, as608_params_t *
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_enroll(as608_handle_t *handle, uint32_t addr, uint16_t *page_number, as608_status_t *status)
+uint8_t as608_load_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                           uint16_t page_number, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[3];
+    uint8_t buf[4];
     uint16_t len;
     uint32_t addr_check;
     
@@ -1994,16 +2129,19 @@ uint8_t as608_enroll(as608_handle_t *handle, uint32_t addr, uint16_t *page_numbe
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_ENROLL;                                             /* enroll */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    buf[0] = AS608_COMMAND_LOAD_CHAR;                                          /* load char */
+    buf[1] = num;                                                              /* set buffer number */
+    buf[2] = (page_number >> 8) & 0xFF;                                        /* page number msb */
+    buf[3] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 4);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 3;                                                                   /* len 3 */
-    res = a_as608_uart_decode(handle, 1000, &addr_check, buf, &len);           /* decode */
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -2014,7 +2152,7 @@ uint8_t as608_enroll(as608_handle_t *handle, uint32_t addr, uint16_t *page_numbe
         
         return 5;                                                              /* return error */
     }
-    if (len != 3)                                                              /* check length */
+    if (len != 1)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -2022,32 +2160,34 @@ uint8_t as608_enroll(as608_handle_t *handle, uint32_t addr, uint16_t *page_numbe
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    *page_number = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                 /* set page number */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      identify
- * @param[in]  *handle pointer to an as608 handle structure
- * @param[in]  addr chip address
- * @param[out] *page_number pointer to a page number buffer
- * @param[out] *score pointer to a score buffer
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 identify failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- * @note       none
+ * @brief         upload feature
+ * @param[in]     *handle pointer to an as608 handle structure
+ * @param[in]     addr chip address
+ * @param[in]     num buffer num
+ * @param[out]    *output_buffer pointer to an output buffer
+ * @param[in,out] *output_len pointer to an output length buffer
+ * @param[out]    *status pointer to a status buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 upload feature failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 decode failed
+ *                - 5 addr is invalid
+ *                - 6 len is invalid
+ *                - 7 buffer is full
+ * @note          none
  */
-uint8_t as608_identify(as608_handle_t *handle, uint32_t addr, uint16_t *page_number, uint16_t *score, as608_status_t *status)
+uint8_t as608_upload_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                             uint8_t *output_buffer, uint16_t *output_len, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[5];
+    uint8_t buf[2];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2060,16 +2200,18 @@ uint8_t as608_identify(as608_handle_t *handle, uint32_t addr, uint16_t *page_num
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_IDENTIFY;                                           /* identify */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    buf[0] = AS608_COMMAND_UP_CHAR;                                            /* upload char */
+    buf[1] = num;                                                              /* set buffer number */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 5;                                                                   /* len 5 */
-    res = a_as608_uart_decode(handle, 1000, &addr_check, buf, &len);           /* decode */
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, 
+                                          buf, &len);                          /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -2080,7 +2222,7 @@ uint8_t as608_identify(as608_handle_t *handle, uint32_t addr, uint16_t *page_num
         
         return 5;                                                              /* return error */
     }
-    if (len != 5)                                                              /* check length */
+    if (len != 1)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -2088,32 +2230,34 @@ uint8_t as608_identify(as608_handle_t *handle, uint32_t addr, uint16_t *page_num
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    *page_number = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                 /* set page number */
-    *score = (uint16_t)((uint16_t)buf[3] << 8) | buf[4];                       /* set score */
     
-    return 0;                                                                  /* success return 0 */
+    return a_as608_uart_upload_buffer(handle, addr, output_buffer, output_len); /* upload data */
 }
 
 /**
- * @brief      set password
+ * @brief      upload feature to a sink
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  password set password
+ * @param[in]  num buffer num
+ * @param[in]  sink pointer to a sink function
+ * @param[in]  *arg pointer to a sink argument
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set password failed
+ *             - 1 upload feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
  *             - 5 addr is invalid
  *             - 6 len is invalid
- * @note       none
+ *             - 7 sink stopped
+ * @note       every data packet is passed to the sink when it arrives
  */
-uint8_t as608_set_password(as608_handle_t *handle, uint32_t addr, uint32_t password, as608_status_t *status)
+uint8_t as608_upload_feature_to_sink(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                                     as608_sink_t sink, void *arg, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[5];
+    uint8_t buf[2];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2126,12 +2270,9 @@ uint8_t as608_set_password(as608_handle_t *handle, uint32_t addr, uint32_t passw
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_SET_PWD;                                            /* set password */
-    buf[1] = (password >> 24) & 0xFF;                                          /* set password */
-    buf[2] = (password >> 16) & 0xFF;                                          /* set password */
-    buf[3] = (password >> 8) & 0xFF;                                           /* set password */
-    buf[4] = (password >> 0) & 0xFF;                                           /* set password */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
+    buf[0] = AS608_COMMAND_UP_CHAR;                                            /* upload char */
+    buf[1] = num;                                                              /* set buffer number */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -2139,7 +2280,8 @@ uint8_t as608_set_password(as608_handle_t *handle, uint32_t addr, uint32_t passw
         return 1;                                                              /* return error */
     }
     len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, 
+                                          buf, &len);                          /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -2159,18 +2301,20 @@ uint8_t as608_set_password(as608_handle_t *handle, uint32_t addr, uint32_t passw
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
     
-    return 0;                                                                  /* success return 0 */
+    return a_as608_uart_upload_data(handle, addr, sink, arg);                  /* upload data */
 }
 
 /**
- * @brief      verify password
+ * @brief      download feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  password verify password
+ * @param[in]  num buffer num
+ * @param[in]  *input_buffer pointer to an input buffer
+ * @param[in]  input_len input length
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 verify password failed
+ *             - 1 download feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2178,10 +2322,87 @@ uint8_t as608_set_password(as608_handle_t *handle, uint32_t addr, uint32_t passw
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_verify_password(as608_handle_t *handle, uint32_t addr, uint32_t password, as608_status_t *status)
+uint8_t as608_download_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                               uint8_t *input_buffer, uint16_t input_len, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[5];
+    uint8_t buf[2];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_DOWN_CHAR;                                                          /* download char */
+    buf[1] = num;                                                                              /* set buffer number */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);                        /* write data */
+    if (res != 0)                                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    len = 1;                                                                                   /* len 1 */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                                              /* check result */
+    {
+        return 4;                                                                              /* return error */
+    }
+    if (addr_check != addr)                                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                                      /* addr is invalid */
+        
+        return 5;                                                                              /* return error */
+    }
+    if (len != 1)                                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
+        
+        return 6;                                                                              /* return error */
+    }
+    handle->status = buf[0];                                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                                  /* set status */
+    
+    res = a_as608_uart_write_stream(handle, addr, input_buffer, input_len);                     /* write the data packets */
+    if (res != 0)                                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief         upload image
+ * @param[in]     *handle pointer to an as608 handle structure
+ * @param[in]     addr chip address
+ * @param[out]    *output_buffer pointer to an output buffer
+ * @param[in,out] *output_len pointer to an output length buffer
+ * @param[out]    *status pointer to a status buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 upload image failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 decode failed
+ *                - 5 addr is invalid
+ *                - 6 len is invalid
+ *                - 7 buffer is full
+ * @note          none
+ */
+uint8_t as608_upload_image(as608_handle_t *handle, uint32_t addr, uint8_t *output_buffer, 
+                           uint16_t *output_len, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[1];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2194,12 +2415,8 @@ uint8_t as608_verify_password(as608_handle_t *handle, uint32_t addr, uint32_t pa
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_VFY_PWD;                                            /* verify password */
-    buf[1] = (password >> 24) & 0xFF;                                          /* set password */
-    buf[2] = (password >> 16) & 0xFF;                                          /* set password */
-    buf[3] = (password >> 8) & 0xFF;                                           /* set password */
-    buf[4] = (password >> 0) & 0xFF;                                           /* set password */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
+    buf[0] = AS608_COMMAND_UP_IMAGE;                                           /* upload image */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -2207,7 +2424,8 @@ uint8_t as608_verify_password(as608_handle_t *handle, uint32_t addr, uint32_t pa
         return 1;                                                              /* return error */
     }
     len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, 
+                                          &addr_check, buf, &len);             /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -2227,29 +2445,32 @@ uint8_t as608_verify_password(as608_handle_t *handle, uint32_t addr, uint32_t pa
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
     
-    return 0;                                                                  /* success return 0 */
+    return a_as608_uart_upload_buffer(handle, addr, output_buffer, output_len); /* upload data */
 }
 
 /**
- * @brief      get random
+ * @brief      upload image to a sink
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[out] *randn pointer to a random buffer
+ * @param[in]  sink pointer to a sink function
+ * @param[in]  *arg pointer to a sink argument
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get random failed
+ *             - 1 upload image failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
  *             - 5 addr is invalid
  *             - 6 len is invalid
- * @note       none
+ *             - 7 sink stopped
+ * @note       every data packet is passed to the sink when it arrives
  */
-uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn, as608_status_t *status)
+uint8_t as608_upload_image_to_sink(as608_handle_t *handle, uint32_t addr, as608_sink_t sink, 
+                                   void *arg, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[5];
+    uint8_t buf[1];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2262,7 +2483,7 @@ uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn,
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_GET_RANDOM_CODE;                                    /* get random code */
+    buf[0] = AS608_COMMAND_UP_IMAGE;                                           /* upload image */
     res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
@@ -2270,8 +2491,9 @@ uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn,
         
         return 1;                                                              /* return error */
     }
-    len = 5;                                                                   /* len 5 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, 
+                                          &addr_check, buf, &len);             /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -2282,7 +2504,7 @@ uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn,
         
         return 5;                                                              /* return error */
     }
-    if (len != 5)                                                              /* check length */
+    if (len != 1)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -2290,23 +2512,20 @@ uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn,
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    *randn = (uint32_t)((uint32_t)buf[1] << 24) |
-              (uint32_t)((uint32_t)buf[2] << 16) |
-              (uint32_t)((uint32_t)buf[3] << 8) |
-              (uint32_t)((uint32_t)buf[4] << 0);                               /* get the random */
     
-    return 0;                                                                  /* success return 0 */
+    return a_as608_uart_upload_data(handle, addr, sink, arg);                  /* upload data */
 }
 
 /**
- * @brief      set the chip address
+ * @brief      download image
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in ] new_addr new address
+ * @param[in]  *input_buffer pointer to an input buffer
+ * @param[in]  input_len input length
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set chip address failed
+ *             - 1 download image failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2314,83 +2533,84 @@ uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn,
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_set_chip_address(as608_handle_t *handle, uint32_t addr, uint32_t new_addr, as608_status_t *status)
+uint8_t as608_download_image(as608_handle_t *handle, uint32_t addr, uint8_t *input_buffer,
+                             uint16_t input_len, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[5];
+    uint8_t buf[1];
     uint16_t len;
     uint32_t addr_check;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_SET_CHIP_ADDR;                                      /* set chip addr */
-    buf[1] = (new_addr >> 24) & 0xFF;                                          /* set chip addr */
-    buf[2] = (new_addr >> 16) & 0xFF;                                          /* set chip addr*/
-    buf[3] = (new_addr >> 8) & 0xFF;                                           /* set chip addr */
-    buf[4] = (new_addr >> 0) & 0xFF;                                           /* set chip addr */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
-    if (res != 0)                                                              /* check result */
+    buf[0] = AS608_COMMAND_DOWN_IMAGE;                                                         /* download char */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);                        /* write data */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
         
-        return 1;                                                              /* return error */
+        return 1;                                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    len = 1;                                                                                   /* len 1 */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                                              /* check result */
     {
-        return 4;                                                              /* return error */
+        return 4;                                                                              /* return error */
     }
-    if (addr_check != new_addr)                                                /* check addr */
+    if (addr_check != addr)                                                                    /* check addr */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        handle->debug_print("as608: addr is invalid.\n");                                      /* addr is invalid */
         
-        return 5;                                                              /* return error */
+        return 5;                                                                              /* return error */
     }
-    if (len != 1)                                                              /* check length */
+    if (len != 1)                                                                              /* check length */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
         
-        return 6;                                                              /* return error */
+        return 6;                                                                              /* return error */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
+    handle->status = buf[0];                                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                                  /* set status */
     
-    return 0;                                                                  /* success return 0 */
+    res = a_as608_uart_write_stream(handle, addr, input_buffer, input_len);                     /* write the data packets */
+    if (res != 0)                                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief         get flash information
- * @param[in]     *handle pointer to an as608 handle structure
- * @param[in]     addr chip address
- * @param[out]    *output_buffer pointer to an output buffer
- * @param[in,out] *output_len pointer to an output length buffer
- * @param[out]    *status pointer to a status buffer
- * @return        status code
- *                - 0 success
- *                - 1 get flash information failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
- *                - 4 decode failed
- *                - 5 addr is invalid
- *                - 6 len is invalid
- *                - 7 buffer is full
- * @note          none
+ * @brief      delete feature
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  page_number page number
+ * @param[in]  number deleted number
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 delete feature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
  */
-uint8_t as608_get_flash_information(as608_handle_t *handle, uint32_t addr,
-                                    uint8_t *output_buffer, uint16_t *output_len, as608_status_t *status)
+uint8_t as608_delete_feature(as608_handle_t *handle, uint32_t addr, uint16_t page_number, uint16_t number, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[1];
-    uint16_t l;
-    uint16_t point;
+    uint8_t buf[5];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2403,8 +2623,12 @@ uint8_t as608_get_flash_information(as608_handle_t *handle, uint32_t addr,
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_READ_INFO_PAGE;                                     /* read info page */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    buf[0] = AS608_COMMAND_DELETE_CHAR;                                        /* delete char feature */
+    buf[1] = (page_number >> 8) & 0xFF;                                        /* page number msb */
+    buf[2] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
+    buf[3] = (number >> 8) & 0xFF;                                             /* number msb */
+    buf[4] = (number >> 0) & 0xFF;                                             /* number lsb */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -2412,8 +2636,7 @@ uint8_t as608_get_flash_information(as608_handle_t *handle, uint32_t addr,
         return 1;                                                              /* return error */
     }
     len = 1;                                                                   /* len 1 */
-    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, 
-                                          buf, &len);                          /* decode */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -2432,55 +2655,18 @@ uint8_t as608_get_flash_information(as608_handle_t *handle, uint32_t addr,
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    point = 0;                                                                 /* init 0 */
-    len = *output_len;                                                         /* get the length */
-    l = *output_len;                                                           /* get the length */
-    while (1)                                                                  /* loop */
-    {
-        as608_bool_t end_enable;
-        as608_bool_t full_enable;
-        
-        l = len;                                                               /* set the remain max buffer size */
-        res = a_as608_uart_parse_data(handle, 100, &addr_check, 
-                                      output_buffer + point, 
-                                      &l, &end_enable, &full_enable);          /* parse the data */
-        if (res != 0)
-        {
-            return 4;                                                          /* return error */
-        }
-        if (addr_check != addr)                                                /* check addr */
-        {
-            handle->debug_print("as608: addr is invalid.\n");                  /* addr is invalid */
-            
-            return 5;                                                          /* return error */
-        }
-        len -= l;                                                              /* remain length - read length */
-        point += l;                                                            /* current point adds read length */
-        if (full_enable == AS608_BOOL_TRUE)                                    /* if buffer is full */
-        {
-            handle->debug_print("as608: buffer is full.\n");                   /* buffer is full */
-            
-            return 7;                                                          /* return error */
-        }
-        if (end_enable == AS608_BOOL_TRUE)                                     /* if the last packet */
-        {
-            break;                                                             /* break */
-        }
-    }
-    *output_len = point;                                                       /* save the length */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      enable or disable port
+ * @brief      empty all feature
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in ] enable bool value
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set port failed
+ *             - 1 empty all feature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2488,10 +2674,10 @@ uint8_t as608_get_flash_information(as608_handle_t *handle, uint32_t addr,
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_set_port(as608_handle_t *handle, uint32_t addr, as608_bool_t enable, as608_status_t *status)
+uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t buf[1];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2504,9 +2690,8 @@ uint8_t as608_set_port(as608_handle_t *handle, uint32_t addr, as608_bool_t enabl
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_PORT_CONTROL;                                       /* port control */
-    buf[1] = enable;                                                           /* set chip addr */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    buf[0] = AS608_COMMAND_EMPTY;                                              /* empty all char feature */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -2538,27 +2723,25 @@ uint8_t as608_set_port(as608_handle_t *handle, uint32_t addr, as608_bool_t enabl
 }
 
 /**
- * @brief      write notepad
+ * @brief      set baud rate
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  page_number page number
- * @param[in]  *data pointer to an input buffer
+ * @param[in]  n_9600 n times of 9600
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 write notepad failed
+ *             - 1 set baud rate failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
  *             - 5 addr is invalid
  *             - 6 len is invalid
- *             - 7 page_number > 15
- * @note       0 <= page_number <= 15
+ * @note       none
  */
-uint8_t as608_write_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_number, uint8_t data[32], as608_status_t *status)
+uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_9600, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[34];
+    uint8_t buf[3];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2570,17 +2753,11 @@ uint8_t as608_write_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_
     {
         return 3;                                                              /* return error */
     }
-    if (page_number > 15)                                                      /* check page number */
-    {
-        handle->debug_print("as608: page_number > 15.\n");                     /* page_number > 15 */
-        
-        return 7;                                                              /* return error */
-    }
     
-    buf[0] = AS608_COMMAND_WRITE_NOTEPAD;                                      /* write notepad */
-    buf[1] = page_number;                                                      /* set page number */
-    memcpy(&buf[2], data, 32);                                                 /* copy data */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 34);       /* write data */
+    buf[0] = AS608_COMMAND_WRITE_REG;                                          /* write reg */
+    buf[1] = 0x04;                                                             /* baud rate */
+    buf[2] = n_9600;                                                           /* n x 9600 */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
@@ -2607,95 +2784,122 @@ uint8_t as608_write_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
+    if ((handle->status == AS608_STATUS_OK) && (n_9600 != 0))                  /* check status */
+    {
+        handle->n_9600 = n_9600;                                               /* save n_9600 */
+    }
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      read notepad
+ * @brief      switch the baud rate of the chip and the host uart together
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  page_number page number
- * @param[out] *data pointer to an output buffer
+ * @param[in]  n_9600 n times of 9600
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 read notepad failed
+ *             - 1 set baud rate failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 decode failed
- *             - 5 addr is invalid
- *             - 6 len is invalid
- *             - 7 page_number > 15
- * @note       0 <= page_number <= 15
+ *             - 4 n_9600 is invalid
+ *             - 5 uart_set_baud_rate is null
+ *             - 6 handshake failed and the old rate is restored
+ *             - 7 handshake failed and the old rate can't be restored
+ * @note       1 <= n_9600 <= 12,
+ *             the chip is read back at the new rate and on failure both sides fall back to the old rate,
+ *             the chip is asked back to the old rate at the new rate only after the host has changed,
+ *             then the old rate is checked by a handshake,
+ *             0 means both sides run at the new rate or the chip refused it and status tells which,
+ *             1 means the command failed and the chip rate is unknown,
+ *             6 means both sides run at the old rate and the handshake passed,
+ *             7 means the host can't be set to the new rate while the chip runs there,
+ *             or the chip doesn't answer at the old rate,
+ *             the handle rate is the old rate on every failure
  */
-uint8_t as608_read_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_number, uint8_t data[32], as608_status_t *status)
+uint8_t as608_switch_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_9600, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[33];
-    uint16_t len;
-    uint32_t addr_check;
+    uint16_t old;
+    as608_params_t param;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                           /* return error */
     }
-    if (page_number > 15)                                                      /* check page number */
+    if ((n_9600 < 1) || (n_9600 > 12))                                                      /* check n_9600 */
     {
-        handle->debug_print("as608: page_number > 15.\n");                     /* page_number > 15 */
+        handle->debug_print("as608: n_9600 is invalid.\n");                                 /* n_9600 is invalid */
         
-        return 7;                                                              /* return error */
+        return 4;                                                                           /* return error */
     }
-    
-    buf[0] = AS608_COMMAND_READ_NOTEPAD;                                       /* read notepad */
-    buf[1] = page_number;                                                      /* set page number */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
-    if (res != 0)                                                              /* check result */
+    if (a_as608_port_has_set_baud_rate(handle) == 0)                                        /* check uart_set_baud_rate */
     {
-        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        handle->debug_print("as608: uart_set_baud_rate is null.\n");                        /* uart_set_baud_rate is null */
         
-        return 1;                                                              /* return error */
+        return 5;                                                                           /* return error */
     }
-    len = 33;                                                                  /* len 33 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                              /* check result */
+    
+    old = handle->n_9600;                                                                   /* save the old rate before the chip write */
+    res = as608_set_baud_rate(handle, addr, n_9600, status);                                /* set the chip rate */
+    if (res != 0)                                                                           /* check result */
     {
-        return 4;                                                              /* return error */
+        handle->n_9600 = old;                                                               /* restore n_9600 */
+        
+        return 1;                                                                           /* return error */
     }
-    if (addr_check != addr)                                                    /* check addr */
+    if ((*status) != AS608_STATUS_OK)                                                       /* check status */
     {
-        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        handle->n_9600 = old;                                                               /* restore n_9600 */
         
-        return 5;                                                              /* return error */
+        return 0;                                                                           /* the chip keeps the old rate */
     }
-    if (len != 33)                                                             /* check length */
+    handle->n_9600 = old;                                                                   /* the chip changed, the host is still at the old rate */
+    a_as608_port_delay_ms(handle, AS608_SWITCH_SETTLE_MS);                                  /* wait for the chip */
+    if (a_as608_port_uart_set_baud_rate(handle, (uint32_t)n_9600 * 9600) != 0)              /* set the host rate */
     {
-        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        handle->debug_print("as608: host rate failed, the chip runs at %d.\n", n_9600 * 9600);    /* host rate failed */
         
-        return 6;                                                              /* return error */
+        return 7;                                                                           /* the host can't reach the chip rate */
+    }
+    handle->n_9600 = n_9600;                                                                /* the host changed */
+    res = as608_get_params(handle, addr, &param, status);                                   /* handshake */
+    if ((res == 0) && ((*status) == AS608_STATUS_OK) && (param.n_9600 == n_9600))           /* check the handshake */
+    {
+        return 0;                                                                           /* success return 0 */
     }
-    handle->status = buf[0];                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                  /* set status */
-    memcpy(data, &buf[1], 32);                                                 /* copy data */
     
-    return 0;                                                                  /* success return 0 */
+    handle->debug_print("as608: handshake failed, fall back to %d.\n", old * 9600);         /* handshake failed */
+    (void)as608_set_baud_rate(handle, addr, (uint8_t)old, status);                          /* ask the chip back at the rate it listens on */
+    a_as608_port_delay_ms(handle, AS608_SWITCH_SETTLE_MS);                                  /* wait for the chip */
+    handle->n_9600 = old;                                                                   /* restore n_9600 */
+    if (a_as608_port_uart_set_baud_rate(handle, (uint32_t)old * 9600) != 0)                 /* set the old host rate */
+    {
+        return 7;                                                                           /* return error */
+    }
+    res = as608_get_params(handle, addr, &param, status);                                   /* handshake */
+    if ((res != 0) || ((*status) != AS608_STATUS_OK))                                       /* check the handshake */
+    {
+        return 7;                                                                           /* return error */
+    }
+    
+    return 6;                                                                               /* return error */
 }
 
 /**
- * @brief      burn code
+ * @brief      set level
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  mode burn mode
- * @param[in]  *input_buffer pointer to an input buffer
- * @param[in]  input_len input length
+ * @param[in]  level input level
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 burn code failed
+ *             - 1 set level failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2703,126 +2907,65 @@ uint8_t as608_read_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_n
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_burn_code(as608_handle_t *handle, uint32_t addr, as608_burn_code_mode_t mode, 
-                        uint8_t *input_buffer, uint16_t input_len, as608_status_t *status)
+uint8_t as608_set_level(as608_handle_t *handle, uint32_t addr, as608_level_t level, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[2];
-    uint16_t i;
-    uint16_t m;
-    uint16_t n;
+    uint8_t buf[3];
     uint16_t len;
     uint32_t addr_check;
     
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_BURN_CODE;                                                          /* burn code */
-    buf[1] = mode;                                                                             /* set burn code */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);                        /* write data */
-    if (res != 0)                                                                              /* check result */
+    buf[0] = AS608_COMMAND_WRITE_REG;                                          /* write reg */
+    buf[1] = 0x05;                                                             /* level settings */
+    buf[2] = level;                                                            /* set level */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
-        return 1;                                                                              /* return error */
+        return 1;                                                              /* return error */
     }
-    len = 1;                                                                                   /* len 1 */
-    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, buf, &len);            /* decode */
-    if (res != 0)                                                                              /* check result */
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
     {
-        return 4;                                                                              /* return error */
+        return 4;                                                              /* return error */
     }
-    if (addr_check != addr)                                                                    /* check addr */
+    if (addr_check != addr)                                                    /* check addr */
     {
-        handle->debug_print("as608: addr is invalid.\n");                                      /* addr is invalid */
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
         
-        return 5;                                                                              /* return error */
+        return 5;                                                              /* return error */
     }
-    if (len != 1)                                                                              /* check length */
+    if (len != 1)                                                              /* check length */
     {
-        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
-        return 6;                                                                              /* return error */
-    }
-    handle->status = buf[0];                                                                   /* save status */
-    *status = (as608_status_t)handle->status;                                                  /* set status */
-    
-    m = input_len / handle->packet_size;                                                       /* set m */
-    n = input_len % handle->packet_size;                                                       /* set n */
-    if (n != 0)                                                                                /* check n */
-    {
-        for (i = 0; i < m; i++)                                                                /* m times */
-        {
-            res = a_as608_uart_write(handle, addr, AS608_TYPE_DATA, 
-                                     input_buffer + i * handle->packet_size, 
-                                     handle->packet_size);                                     /* write data */
-            if (res != 0)                                                                      /* check result */
-            {
-                handle->debug_print("as608: uart write failed.\n");                            /* uart write failed */
-                
-                return 1;                                                                      /* return error */
-            }
-            handle->delay_ms(100);                                                             /* delay 100ms */
-        }
-        res = a_as608_uart_write(handle, addr, AS608_TYPE_END, 
-                                 input_buffer + m * handle->packet_size, n);                   /* write data */
-        if (res != 0)                                                                          /* check result */
-        {
-            handle->debug_print("as608: uart write failed.\n");                                /* uart write failed */
-            
-            return 1;                                                                          /* return error */
-        }
-        handle->delay_ms(100);                                                                 /* delay 100ms */
-    }
-    else
-    {
-        for (i = 0; i < (m - 1); i++)                                                          /* m - 1 times */
-        {
-            res = a_as608_uart_write(handle, addr, AS608_TYPE_DATA, 
-                                     input_buffer + i * handle->packet_size, 
-                                     handle->packet_size);                                     /* write data */
-            if (res != 0)                                                                      /* check result */
-            {
-                handle->debug_print("as608: uart write failed.\n");                            /* uart write failed */
-                
-                return 1;                                                                      /* return error */
-            }
-            handle->delay_ms(100);                                                             /* delay 100ms */
-        }
-        res = a_as608_uart_write(handle, addr, AS608_TYPE_END, 
-                                 input_buffer + (m - 1) * handle->packet_size, 
-                                 handle->packet_size);                                         /* write data */
-        if (res != 0)                                                                          /* check result */
-        {
-            handle->debug_print("as608: uart write failed.\n");                                /* uart write failed */
-            
-            return 1;                                                                          /* return error */
-        }
-        handle->delay_ms(100);                                                                 /* delay 100ms */
+        return 6;                                                              /* return error */
     }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
     
-    return 0;                                                                                  /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      high speed search
+ * @brief      set packet size
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  buffer_number buffer number
- * @param[in]  start_page start page
- * @param[in]  page_number page number
- * @param[out] *found_page pointer to a found page buffer
- * @param[out] *score pointer to a score buffer
+ * @param[in]  size packet size
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 high speed search failed
+ *             - 1 set packet size failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2830,13 +2973,10 @@ uint8_t as608_burn_code(as608_handle_t *handle, uint32_t addr, as608_burn_code_m
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_high_speed_search(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t buffer_number, 
-                                uint16_t start_page, uint16_t page_number, 
-                                uint16_t *found_page, uint16_t *score,
-                                as608_status_t *status)
+uint8_t as608_set_packet_size(as608_handle_t *handle, uint32_t addr, as608_packet_size_t size, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[6];
+    uint8_t buf[3];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2849,20 +2989,17 @@ uint8_t as608_high_speed_search(as608_handle_t *handle, uint32_t addr, as608_buf
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_HIGH_SPEED_SEARCH;                                  /* high speed search */
-    buf[1] = buffer_number;                                                    /* set buffer number */
-    buf[2] = (start_page >> 8) & 0xFF;                                         /* start page msb */
-    buf[3] = (start_page >> 0) & 0xFF;                                         /* start page lsb */
-    buf[4] = (page_number >> 8) & 0xFF;                                        /* page number msb */
-    buf[5] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 6);        /* write data */
+    buf[0] = AS608_COMMAND_WRITE_REG;                                          /* write reg */
+    buf[1] = 0x06;                                                             /* size settings */
+    buf[2] = size;                                                             /* set size */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 5;                                                                   /* len 5 */
+    len = 1;                                                                   /* len 1 */
     res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
@@ -2874,7 +3011,7 @@ uint8_t as608_high_speed_search(as608_handle_t *handle, uint32_t addr, as608_buf
         
         return 5;                                                              /* return error */
     }
-    if (len != 5)                                                              /* check length */
+    if (len != 1)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -2882,21 +3019,21 @@ uint8_t as608_high_speed_search(as608_handle_t *handle, uint32_t addr, as608_buf
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    *found_page = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                  /* set found page */
-    *score = (uint16_t)((uint16_t)buf[3] << 8) | buf[4];                       /* set score */
+    handle->packet_size = (uint16_t)(32.0f * powf(2.0f, 
+                          (float)((uint16_t)size)));                           /* packet size */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      generate bin image
+ * @brief      get params
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  image image type
+ * @param[out] *param pointer to a param structure
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 generate bin image failed
+ *             - 1 get params failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2904,10 +3041,10 @@ uint8_t as608_high_speed_search(as608_handle_t *handle, uint32_t addr, as608_buf
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_generate_bin_image(as608_handle_t *handle, uint32_t addr, as608_image_t image, as608_status_t *status)
+uint8_t as608_get_params(as608_handle_t *handle, uint32_t addr, as608_params_t *param, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t buf[17];
     uint16_t len;
     uint32_t addr_check;
     
@@ -2920,16 +3057,15 @@ uint8_t as608_generate_bin_image(as608_handle_t *handle, uint32_t addr, as608_im
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_GEN_BIN_IMAGE;                                      /* generate bin image */
-    buf[1] = image;                                                            /* set image */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    buf[0] = AS608_COMMAND_READ_SYS_PARA;                                      /* read sys para */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 1;                                                                   /* len 1 */
+    len = 17;                                                                  /* len 17 */
     res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
@@ -2941,7 +3077,7 @@ uint8_t as608_generate_bin_image(as608_handle_t *handle, uint32_t addr, as608_im
         
         return 5;                                                              /* return error */
     }
-    if (len != 1)                                                              /* check length */
+    if (len != 17)                                                             /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -2949,19 +3085,36 @@ uint8_t as608_generate_bin_image(as608_handle_t *handle, uint32_t addr, as608_im
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
+    param->status = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                /* set current status */
+    param->sensor_type = (as608_sensor_type_t)
+                         ((uint16_t)((uint16_t)buf[3] << 8) | buf[4]);         /* set sensor type */
+    param->fingerprint_size = (uint16_t)((uint16_t)buf[5] << 8) | buf[6];      /* set fingerprint size */
+    param->level = (as608_level_t)
+                   ((uint16_t)((uint16_t)buf[7] << 8) | buf[8]);               /* set level */
+    param->address = (uint32_t)((uint32_t)buf[9] << 24) |
+                     (uint32_t)((uint32_t)buf[10] << 16) |
+                     (uint32_t)((uint32_t)buf[11] << 8) |
+                     (uint32_t)((uint32_t)buf[12] << 0);                       /* set address */
+    param->packet_size = (as608_packet_size_t)
+                         ((uint16_t)((uint16_t)buf[13] << 8) | buf[14]);       /* set packet size */
+    param->n_9600 = (uint16_t)((uint16_t)buf[15] << 8) | buf[16];              /* set n_9600 */
+    if (param->n_9600 != 0)                                                    /* check n_9600 */
+    {
+        handle->n_9600 = param->n_9600;                                        /* save n_9600 */
+    }
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get valid template number
+ * @brief      enroll
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[out] *num pointer to a number buffer
+ * @param[out] *page_number pointer to a page number buffer
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get valid template number failed
+ *             - 1 enroll failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -2969,7 +3122,7 @@ uint8_t as608_generate_bin_image(as608_handle_t *handle, uint32_t addr, as608_im
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_get_valid_template_number(as608_handle_t *handle, uint32_t addr, uint16_t *num, as608_status_t *status)
+uint8_t as608_enroll(as608_handle_t *handle, uint32_t addr, uint16_t *page_number, as608_status_t *status)
 {
     uint8_t res;
     uint8_t buf[3];
@@ -2985,7 +3138,7 @@ uint8_t as608_get_valid_template_number(as608_handle_t *handle, uint32_t addr, u
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_VALID_TEMPLATE_NUM;                                 /* valid template num */
+    buf[0] = AS608_COMMAND_ENROLL;                                             /* enroll */
     res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
@@ -2994,7 +3147,7 @@ uint8_t as608_get_valid_template_number(as608_handle_t *handle, uint32_t addr, u
         return 1;                                                              /* return error */
     }
     len = 3;                                                                   /* len 3 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    res = a_as608_uart_decode(handle, 1000, &addr_check, buf, &len);           /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -3013,22 +3166,21 @@ uint8_t as608_get_valid_template_number(as608_handle_t *handle, uint32_t addr, u
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    *num = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                         /* get the number */
+    *page_number = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                 /* set page number */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      set gpio level
+ * @brief      identify
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  gpio gpio number
- * @param[in]  input_level input level
- * @param[out] *output_level pointer to an output level buffer
+ * @param[out] *page_number pointer to a page number buffer
+ * @param[out] *score pointer to a score buffer
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 set gpio level failed
+ *             - 1 identify failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
@@ -3036,11 +3188,10 @@ uint8_t as608_get_valid_template_number(as608_handle_t *handle, uint32_t addr, u
  *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_set_gpio_level(as608_handle_t *handle, uint32_t addr, as608_gpio_number_t gpio, 
-                             as608_gpio_level_t input_level, as608_gpio_level_t *output_level, as608_status_t *status)
+uint8_t as608_identify(as608_handle_t *handle, uint32_t addr, uint16_t *page_number, uint16_t *score, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[3];
+    uint8_t buf[5];
     uint16_t len;
     uint32_t addr_check;
     
@@ -3053,18 +3204,16 @@ uint8_t as608_set_gpio_level(as608_handle_t *handle, uint32_t addr, as608_gpio_n
         return 3;                                                              /* return error */
     }
     
-    buf[0] = AS608_COMMAND_USER_GPIO;                                          /* user gpio */
-    buf[1] = gpio;                                                             /* set gpio number */
-    buf[2] = input_level;                                                      /* set gpio input level */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
+    buf[0] = AS608_COMMAND_IDENTIFY;                                           /* identify */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 2;                                                                   /* len 2 */
-    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    len = 5;                                                                   /* len 5 */
+    res = a_as608_uart_decode(handle, 1000, &addr_check, buf, &len);           /* decode */
     if (res != 0)                                                              /* check result */
     {
         return 4;                                                              /* return error */
@@ -3075,7 +3224,7 @@ uint8_t as608_set_gpio_level(as608_handle_t *handle, uint32_t addr, as608_gpio_n
         
         return 5;                                                              /* return error */
     }
-    if (len != 2)                                                              /* check length */
+    if (len != 5)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -3083,34 +3232,32 @@ uint8_t as608_set_gpio_level(as608_handle_t *handle, uint32_t addr, as608_gpio_n
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    *output_level = (as608_gpio_level_t)(buf[1]);                              /* get gpio level */
+    *page_number = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                 /* set page number */
+    *score = (uint16_t)((uint16_t)buf[3] << 8) | buf[4];                       /* set score */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get index table
+ * @brief      set password
  * @param[in]  *handle pointer to an as608 handle structure
  * @param[in]  addr chip address
- * @param[in]  num index number
- * @param[out] *table pointer to a table buffer
+ * @param[in]  password set password
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get index table failed
+ *             - 1 set password failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 decode failed
  *             - 5 addr is invalid
  *             - 6 len is invalid
- *             - 7 num > 3
  * @note       none
  */
-uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num, 
-                              uint8_t table[32], as608_status_t *status)
+uint8_t as608_set_password(as608_handle_t *handle, uint32_t addr, uint32_t password, as608_status_t *status)
 {
     uint8_t res;
-    uint8_t buf[33];
+    uint8_t buf[5];
     uint16_t len;
     uint32_t addr_check;
     
@@ -3122,23 +3269,20 @@ uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num
     {
         return 3;                                                              /* return error */
     }
-    if (num > 3)                                                               /* check num */
-    {
-        handle->debug_print("as608: num > 3.\n");                              /* num > 3 */
-        
-        return 7;                                                              /* return error */
-    }
     
-    buf[0] = AS608_COMMAND_READ_INDEX_TABLE;                                   /* read index table */
-    buf[1] = num;                                                              /* set index table number */
-    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    buf[0] = AS608_COMMAND_SET_PWD;                                            /* set password */
+    buf[1] = (password >> 24) & 0xFF;                                          /* set password */
+    buf[2] = (password >> 16) & 0xFF;                                          /* set password */
+    buf[3] = (password >> 8) & 0xFF;                                           /* set password */
+    buf[4] = (password >> 0) & 0xFF;                                           /* set password */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
         
         return 1;                                                              /* return error */
     }
-    len = 33;                                                                  /* len 33 */
+    len = 1;                                                                   /* len 1 */
     res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
     if (res != 0)                                                              /* check result */
     {
@@ -3150,7 +3294,7 @@ uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num
         
         return 5;                                                              /* return error */
     }
-    if (len != 33)                                                             /* check length */
+    if (len != 1)                                                              /* check length */
     {
         handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
         
@@ -3158,277 +3302,3428 @@ uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num
     }
     handle->status = buf[0];                                                   /* save status */
     *status = (as608_status_t)handle->status;                                  /* set status */
-    memcpy(table, &buf[1], 32);                                                /* copy data */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     print status
- * @param[in] *handle pointer to an as608 handle structure
- * @param[in] status print status
- * @return    status code
+ * @brief      verify password
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  password verify password
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
  *             - 0 success
+ *             - 1 verify password failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
  * @note       none
  */
-uint8_t as608_print_status(as608_handle_t *handle, as608_status_t status)
+uint8_t as608_verify_password(as608_handle_t *handle, uint32_t addr, uint32_t password, as608_status_t *status)
 {
-    if (handle == NULL)                                                          /* check handle */
+    uint8_t res;
+    uint8_t buf[5];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                /* return error */
+        return 3;                                                              /* return error */
     }
     
-    switch (status)                                                              /* switch status */
+    buf[0] = AS608_COMMAND_VFY_PWD;                                            /* verify password */
+    buf[1] = (password >> 24) & 0xFF;                                          /* set password */
+    buf[2] = (password >> 16) & 0xFF;                                          /* set password */
+    buf[3] = (password >> 8) & 0xFF;                                           /* set password */
+    buf[4] = (password >> 0) & 0xFF;                                           /* set password */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
+    if (res != 0)                                                              /* check result */
     {
-        case AS608_STATUS_OK :                                                   /* status case */
-        {
-            handle->debug_print("as608: ok.\n");                                 /* print message */
-            
-            break;                                                               /* break */
-        }
-        case AS608_STATUS_FRAME_ERROR :                                          /* status case */
-        {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 1)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get random
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *randn pointer to a random buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get random failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_get_random(as608_handle_t *handle, uint32_t addr, uint32_t *randn, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[5];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_GET_RANDOM_CODE;                                    /* get random code */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 5;                                                                   /* len 5 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 5)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    *randn = (uint32_t)((uint32_t)buf[1] << 24) |
+              (uint32_t)((uint32_t)buf[2] << 16) |
+              (uint32_t)((uint32_t)buf[3] << 8) |
+              (uint32_t)((uint32_t)buf[4] << 0);                               /* get the random */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      set the chip address
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in ] new_addr new address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 set chip address failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_set_chip_address(as608_handle_t *handle, uint32_t addr, uint32_t new_addr, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[5];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_SET_CHIP_ADDR;                                      /* set chip addr */
+    buf[1] = (new_addr >> 24) & 0xFF;                                          /* set chip addr */
+    buf[2] = (new_addr >> 16) & 0xFF;                                          /* set chip addr*/
+    buf[3] = (new_addr >> 8) & 0xFF;                                           /* set chip addr */
+    buf[4] = (new_addr >> 0) & 0xFF;                                           /* set chip addr */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 5);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != new_addr)                                                /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 1)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief         get flash information
+ * @param[in]     *handle pointer to an as608 handle structure
+ * @param[in]     addr chip address
+ * @param[out]    *output_buffer pointer to an output buffer
+ * @param[in,out] *output_len pointer to an output length buffer
+ * @param[out]    *status pointer to a status buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 get flash information failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 decode failed
+ *                - 5 addr is invalid
+ *                - 6 len is invalid
+ *                - 7 buffer is full
+ * @note          none
+ */
+uint8_t as608_get_flash_information(as608_handle_t *handle, uint32_t addr,
+                                    uint8_t *output_buffer, uint16_t *output_len, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_READ_INFO_PAGE;                                     /* read info page */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, 
+                                          buf, &len);                          /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 1)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    
+    return a_as608_uart_upload_buffer(handle, addr, output_buffer, output_len); /* upload data */
+}
+
+/**
+ * @brief      enable or disable port
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in ] enable bool value
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 set port failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_set_port(as608_handle_t *handle, uint32_t addr, as608_bool_t enable, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_PORT_CONTROL;                                       /* port control */
+    buf[1] = enable;                                                           /* set chip addr */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 1)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      write notepad
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  page_number page number
+ * @param[in]  *data pointer to an input buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write notepad failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ *             - 7 page_number > 15
+ * @note       0 <= page_number <= 15
+ */
+uint8_t as608_write_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_number, uint8_t data[32], as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[34];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (page_number > 15)                                                      /* check page number */
+    {
+        handle->debug_print("as608: page_number > 15.\n");                     /* page_number > 15 */
+        
+        return 7;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_WRITE_NOTEPAD;                                      /* write notepad */
+    buf[1] = page_number;                                                      /* set page number */
+    memcpy(&buf[2], data, 32);                                                 /* copy data */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 34);       /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 1)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      read notepad
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  page_number page number
+ * @param[out] *data pointer to an output buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read notepad failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ *             - 7 page_number > 15
+ * @note       0 <= page_number <= 15
+ */
+uint8_t as608_read_notepad(as608_handle_t *handle, uint32_t addr, uint8_t page_number, uint8_t data[32], as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[33];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (page_number > 15)                                                      /* check page number */
+    {
+        handle->debug_print("as608: page_number > 15.\n");                     /* page_number > 15 */
+        
+        return 7;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_READ_NOTEPAD;                                       /* read notepad */
+    buf[1] = page_number;                                                      /* set page number */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 33;                                                                  /* len 33 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 33)                                                             /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    memcpy(data, &buf[1], 32);                                                 /* copy data */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      burn code
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  mode burn mode
+ * @param[in]  *input_buffer pointer to an input buffer
+ * @param[in]  input_len input length
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 burn code failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_burn_code(as608_handle_t *handle, uint32_t addr, as608_burn_code_mode_t mode, 
+                        uint8_t *input_buffer, uint16_t input_len, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_BURN_CODE;                                                          /* burn code */
+    buf[1] = mode;                                                                             /* set burn code */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);                        /* write data */
+    if (res != 0)                                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    len = 1;                                                                                   /* len 1 */
+    res = a_as608_uart_decode_with_length(handle, 12, 100, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                                              /* check result */
+    {
+        return 4;                                                                              /* return error */
+    }
+    if (addr_check != addr)                                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                                      /* addr is invalid */
+        
+        return 5;                                                                              /* return error */
+    }
+    if (len != 1)                                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                                       /* len is invalid */
+        
+        return 6;                                                                              /* return error */
+    }
+    handle->status = buf[0];                                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                                  /* set status */
+    
+    res = a_as608_uart_write_stream(handle, addr, input_buffer, input_len);                     /* write the data packets */
+    if (res != 0)                                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                                    /* uart write failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      high speed search
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  buffer_number buffer number
+ * @param[in]  start_page start page
+ * @param[in]  page_number page number
+ * @param[out] *found_page pointer to a found page buffer
+ * @param[out] *score pointer to a score buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 high speed search failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_high_speed_search(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t buffer_number, 
+                                uint16_t start_page, uint16_t page_number, 
+                                uint16_t *found_page, uint16_t *score,
+                                as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[6];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_HIGH_SPEED_SEARCH;                                  /* high speed search */
+    buf[1] = buffer_number;                                                    /* set buffer number */
+    buf[2] = (start_page >> 8) & 0xFF;                                         /* start page msb */
+    buf[3] = (start_page >> 0) & 0xFF;                                         /* start page lsb */
+    buf[4] = (page_number >> 8) & 0xFF;                                        /* page number msb */
+    buf[5] = (page_number >> 0) & 0xFF;                                        /* page number lsb */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 6);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 5;                                                                   /* len 5 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 5)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    *found_page = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                  /* set found page */
+    *score = (uint16_t)((uint16_t)buf[3] << 8) | buf[4];                       /* set score */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      generate bin image
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  image image type
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 generate bin image failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_generate_bin_image(as608_handle_t *handle, uint32_t addr, as608_image_t image, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_GEN_BIN_IMAGE;                                      /* generate bin image */
+    buf[1] = image;                                                            /* set image */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 1;                                                                   /* len 1 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 1)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get valid template number
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *num pointer to a number buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get valid template number failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_get_valid_template_number(as608_handle_t *handle, uint32_t addr, uint16_t *num, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[3];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_VALID_TEMPLATE_NUM;                                 /* valid template num */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 1);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 3;                                                                   /* len 3 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 3)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    *num = (uint16_t)((uint16_t)buf[1] << 8) | buf[2];                         /* get the number */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      set gpio level
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  gpio gpio number
+ * @param[in]  input_level input level
+ * @param[out] *output_level pointer to an output level buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 set gpio level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ * @note       none
+ */
+uint8_t as608_set_gpio_level(as608_handle_t *handle, uint32_t addr, as608_gpio_number_t gpio, 
+                             as608_gpio_level_t input_level, as608_gpio_level_t *output_level, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[3];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_USER_GPIO;                                          /* user gpio */
+    buf[1] = gpio;                                                             /* set gpio number */
+    buf[2] = input_level;                                                      /* set gpio input level */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 3);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 2;                                                                   /* len 2 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 2)                                                              /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    *output_level = (as608_gpio_level_t)(buf[1]);                              /* get gpio level */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get index table
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  num index number
+ * @param[out] *table pointer to a table buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get index table failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ *             - 7 num > 3
+ * @note       none
+ */
+uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num, 
+                              uint8_t table[32], as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t buf[33];
+    uint16_t len;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (num > 3)                                                               /* check num */
+    {
+        handle->debug_print("as608: num > 3.\n");                              /* num > 3 */
+        
+        return 7;                                                              /* return error */
+    }
+    
+    buf[0] = AS608_COMMAND_READ_INDEX_TABLE;                                   /* read index table */
+    buf[1] = num;                                                              /* set index table number */
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, buf, 2);        /* write data */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                    /* uart write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    len = 33;                                                                  /* len 33 */
+    res = a_as608_uart_decode(handle, 300, &addr_check, buf, &len);            /* decode */
+    if (res != 0)                                                              /* check result */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (addr_check != addr)                                                    /* check addr */
+    {
+        handle->debug_print("as608: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len != 33)                                                             /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                       /* len is invalid */
+        
+        return 6;                                                              /* return error */
+    }
+    handle->status = buf[0];                                                   /* save status */
+    *status = (as608_status_t)handle->status;                                  /* set status */
+    memcpy(table, &buf[1], 32);                                                /* copy data */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     print status
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] status print status
+ * @return    status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_print_status(as608_handle_t *handle, as608_status_t status)
+{
+    if (handle == NULL)                                                          /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    switch (status)                                                              /* switch status */
+    {
+        case AS608_STATUS_OK :                                                   /* status case */
+        {
+            handle->debug_print("as608: ok.\n");                                 /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FRAME_ERROR :                                          /* status case */
+        {
             handle->debug_print("as608: frame error.\n");                        /* print message */
             
-            break;                                                               /* break */
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_NO_FINGERPRINT :                                       /* status case */
+        {
+            handle->debug_print("as608: no fingerprint.\n");                     /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_INPUT_ERROR :                                          /* status case */
+        {
+            handle->debug_print("as608: fingerprint image error.\n");            /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_IMAGE_TOO_DRY :                                        /* status case */
+        {
+            handle->debug_print("as608: fingerprint image too dry.\n");          /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_IMAGE_TOO_WET :                                        /* status case */
+        {
+            handle->debug_print("as608: fingerprint image too wet.\n");          /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_IMAGE_TOO_CLUTTER :                                    /* status case */
+        {
+            handle->debug_print("as608: fingerprint too clutter.\n");            /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_IMAGE_TOO_FEW_FEATURE :                                /* status case */
+        {
+            handle->debug_print("as608: fingerprint feature too few.\n");        /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_NOT_MATCH :                                            /* status case */
+        {
+            handle->debug_print("as608: not match.\n");                          /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_NOT_FOUND :                                            /* status case */
+        {
+            handle->debug_print("as608: not found.\n");                          /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FEATURE_COMBINE_ERROR :                                /* status case */
+        {
+            handle->debug_print("as608: feature combine error.\n");              /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_LIB_ADDR_OVER :                                        /* status case */
+        {
+            handle->debug_print("as608: fingerprint lib addr is over.\n");       /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_LIB_READ_ERROR :                                       /* status case */
+        {
+            handle->debug_print("as608: fingerprint lib read error.\n");         /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_UPLOAD_FEATURE_ERROR :                                 /* status case */
+        {
+            handle->debug_print("as608: upload feature error.\n");               /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_NO_FRAME :                                             /* status case */
+        {
+            handle->debug_print("as608: no frame.\n");                           /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_UPLOAD_IMAGE_ERROR :                                   /* status case */
+        {
+            handle->debug_print("as608: upload image error.\n");                 /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_LIB_DELETE_ERROR :                                     /* status case */
+        {
+            handle->debug_print("as608: delete lib error.\n");                   /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_LIB_CLEAR_ERROR :                                      /* status case */
+        {
+            handle->debug_print("as608: clear lib error.\n");                    /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_ENTER_LOW_POWER_ERROR :                                /* status case */
+        {
+            handle->debug_print("as608: enter low power error.\n");              /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_COMMAND_INVALID :                                      /* status case */
+        {
+            handle->debug_print("as608: command invalid.\n");                    /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_RESET_ERROR :                                          /* status case */
+        {
+            handle->debug_print("as608: reset error.\n");                        /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_BUFFER_INVALID :                                       /* status case */
+        {
+            handle->debug_print("as608: buffer invalid.\n");                     /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_UPDATE_ERROR :                                         /* status case */
+        {
+            handle->debug_print("as608: update error.\n");                       /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_NO_MOVE :                                              /* status case */
+        {
+            handle->debug_print("as608: no move.\n");                            /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FLASH_ERROR :                                          /* status case */
+        {
+            handle->debug_print("as608: flash error.\n");                        /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_F0_RESPONSE :                                          /* status case */
+        {
+            handle->debug_print("as608: f0 response.\n");                        /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_F1_RESPONSE :                                          /* status case */
+        {
+            handle->debug_print("as608: f1 response.\n");                        /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FLASH_WRITE_SUM_ERROR :                                /* status case */
+        {
+            handle->debug_print("as608: flash sum error.\n");                    /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FLASH_WRITE_HEADER_ERROR :                             /* status case */
+        {
+            handle->debug_print("as608: flash header error.\n");                 /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FLASH_WRITE_LENGTH_ERROR :                             /* status case */
+        {
+            handle->debug_print("as608: flash length error.\n");                 /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FLASH_WRITE_LENGTH_TOO_LONG :                          /* status case */
+        {
+            handle->debug_print("as608: flash length too long.\n");              /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_FLASH_WRITE_ERROR :                                    /* status case */
+        {
+            handle->debug_print("as608: flash write error.\n");                  /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_UNKNOWN :                                              /* status case */
+        {
+            handle->debug_print("as608: unknown.\n");                            /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_REG_INVALID :                                          /* status case */
+        {
+            handle->debug_print("as608: reg invalid.\n");                        /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_DATA_INVALID :                                         /* status case */
+        {
+            handle->debug_print("as608: data invalid.\n");                       /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_NOTE_PAGE_INVALID :                                    /* status case */
+        {
+            handle->debug_print("as608: note page invalid.\n");                  /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_PORT_INVALID :                                         /* status case */
+        {
+            handle->debug_print("as608: port invalid.\n");                       /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_ENROLL_ERROR :                                         /* status case */
+        {
+            handle->debug_print("as608: enroll error.\n");                       /* print message */
+            
+            break;                                                               /* break */
+        }
+        case AS608_STATUS_LIB_FULL :                                             /* status case */
+        {
+            handle->debug_print("as608: lib full.\n");                           /* print message */
+            
+            break;                                                               /* break */
+        }
+        default :                                                                /* default */
+        {
+            handle->debug_print("as608: invalid type.\n");                       /* print message */
+            
+            break;                                                               /* break */
+        }
+    }
+    
+    return 0;                                                                    /* success return 0 */ 
+}
+
+/**
+ * @brief     complete the command in flight
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] res result
+ * @param[in] l response frame length
+ * @note      none
+ */
+static void a_as608_async_complete(as608_handle_t *handle, uint8_t res, uint16_t l)
+{
+    as608_status_t status;
+    uint8_t *payload;
+    uint16_t len;
+    
+    status = AS608_STATUS_OK;                                                        /* init ok */
+    payload = NULL;                                                                  /* init NULL */
+    len = 0;                                                                         /* init 0 */
+    if (res == 0)                                                                    /* if success */
+    {
+        handle->status = handle->buf[9];                                             /* save status */
+        status = (as608_status_t)handle->status;                                     /* set status */
+        payload = &handle->buf[10];                                                  /* set payload */
+        len = l - 12;                                                                /* set payload length */
+    }
+    handle->async_busy = 0;                                                          /* clear busy */
+    if (handle->async_callback != NULL)                                              /* check callback */
+    {
+        handle->async_callback(handle->async_arg, res, handle->async_command, 
+                               status, payload, len);                                /* run callback */
+    }
+}
+
+/**
+ * @brief     submit a command without waiting for the response
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr chip address
+ * @param[in] *input_buffer pointer to a command buffer, the first byte is the command code
+ * @param[in] input_len command buffer length
+ * @param[in] timeout_ms response timeout in ms
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a command is in flight
+ *            - 5 timestamp_ms is null
+ *            - 6 len is invalid
+ * @note      only the commands answered by a single response frame are supported,
+ *            the blocking functions must not be called while a command is in flight
+ */
+uint8_t as608_async_submit(as608_handle_t *handle, uint32_t addr, uint8_t *input_buffer, uint16_t input_len,
+                           uint32_t timeout_ms, as608_async_callback_t callback, void *arg)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->async_busy != 0)                                                         /* check busy */
+    {
+        handle->debug_print("as608: a command is in flight.\n");                         /* a command is in flight */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (a_as608_port_has_timestamp(handle) == 0)                                         /* check timestamp */
+    {
+        handle->debug_print("as608: timestamp_ms is null.\n");                           /* timestamp_ms is null */
+        
+        return 5;                                                                        /* return error */
+    }
+    if ((input_buffer == NULL) || (input_len == 0))                                      /* check length */
+    {
+        handle->debug_print("as608: len is invalid.\n");                                 /* len is invalid */
+        
+        return 6;                                                                        /* return error */
+    }
+    
+    res = a_as608_uart_write(handle, addr, AS608_TYPE_COMMAND, input_buffer, input_len); /* write data */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("as608: uart write failed.\n");                              /* uart write failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->async_command = input_buffer[0];                                             /* save command */
+    handle->async_addr = addr;                                                           /* save address */
+    handle->async_start = a_as608_port_timestamp_ms(handle);                             /* save start time */
+    handle->async_timeout_ms = timeout_ms;                                               /* save timeout */
+    handle->async_callback = callback;                                                   /* save callback */
+    handle->async_arg = arg;                                                             /* save argument */
+    handle->async_busy = 1;                                                              /* set busy */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      poll the command in flight
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *busy pointer to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the function never waits, it parses the bytes which are available now and
+ *             runs the completion callback when the response is received or the command times out
+ */
+uint8_t as608_async_poll(as608_handle_t *handle, as608_bool_t *busy)
+{
+    uint8_t res;
+    uint16_t l;
+    uint32_t addr_check;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    if (handle->async_busy != 0)                                                             /* check busy */
+    {
+        if (a_as608_uart_receive_poll(handle, &l) == 0)                                      /* poll the frame */
+        {
+            res = a_as608_uart_check_frame(handle, l, &addr_check);                          /* check the frame */
+            if (res == 2)                                                                    /* check length */
+            {
+                res = 4;                                                                     /* len is invalid */
+            }
+            else if ((res == 0) && (addr_check != handle->async_addr))                       /* check address */
+            {
+                handle->debug_print("as608: addr is invalid.\n");                            /* addr is invalid */
+                res = 5;                                                                     /* addr is invalid */
+            }
+            a_as608_async_complete(handle, res, l);                                          /* complete */
+        }
+        else if (a_as608_elapsed_ms(handle, handle->async_start, 0) >= 
+                 handle->async_timeout_ms)                                                   /* check timeout */
+        {
+            handle->debug_print("as608: no response.\n");                                    /* no response */
+            a_as608_stats_error(handle, AS608_STATS_ERROR_TIMEOUT);                          /* timeout error */
+            a_as608_async_complete(handle, 1, 0);                                            /* complete */
+        }
+    }
+    if (busy != NULL)                                                                        /* check busy */
+    {
+        *busy = (as608_bool_t)(handle->async_busy);                                          /* set busy */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     cancel the command in flight
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the completion callback runs with res 2, a late response is dropped by the next command
+ */
+uint8_t as608_async_cancel(as608_handle_t *handle)
+{
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    if (handle->inited != 1)                               /* check handle initialization */
+    {
+        return 3;                                          /* return error */
+    }
+    
+    if (handle->async_busy != 0)                           /* check busy */
+    {
+        a_as608_uart_rx_reset(handle);                     /* reset the receive buffer */
+        a_as608_async_complete(handle, 2, 0);              /* complete */
+    }
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the stream pacing
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when the pacing is disabled, the data packets are sent every 100ms
+ */
+uint8_t as608_set_stream_pacing(as608_handle_t *handle, as608_bool_t enable)
+{
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    if (handle->inited != 1)                        /* check handle initialization */
+    {
+        return 3;                                   /* return error */
+    }
+    
+    handle->stream_pacing = (uint8_t)enable;        /* set pacing */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the stream pacing status
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_stream_pacing(as608_handle_t *handle, as608_bool_t *enable)
+{
+    if (handle == NULL)                                       /* check handle */
+    {
+        return 2;                                             /* return error */
+    }
+    if (handle->inited != 1)                                  /* check handle initialization */
+    {
+        return 3;                                             /* return error */
+    }
+    
+    *enable = (as608_bool_t)(handle->stream_pacing);          /* get pacing */
+    
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the stream margin
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] ms margin in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the margin is added to the wire time of each data packet, default is 5ms
+ */
+uint8_t as608_set_stream_margin(as608_handle_t *handle, uint16_t ms)
+{
+    if (handle == NULL)                           /* check handle */
+    {
+        return 2;                                 /* return error */
+    }
+    if (handle->inited != 1)                      /* check handle initialization */
+    {
+        return 3;                                 /* return error */
+    }
+    
+    handle->stream_margin_ms = ms;                /* set margin */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the stream margin
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *ms pointer to a margin buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_stream_margin(as608_handle_t *handle, uint16_t *ms)
+{
+    if (handle == NULL)                           /* check handle */
+    {
+        return 2;                                 /* return error */
+    }
+    if (handle->inited != 1)                      /* check handle initialization */
+    {
+        return 3;                                 /* return error */
+    }
+    
+    *ms = handle->stream_margin_ms;               /* get margin */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the stream gap of a full data packet
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *ms pointer to a gap buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the gap is computed from n_9600 and packet_size
+ */
+uint8_t as608_get_stream_gap(as608_handle_t *handle, uint16_t *ms)
+{
+    if (handle == NULL)                                                       /* check handle */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    
+    *ms = (uint16_t)a_as608_stream_gap_ms(handle, handle->packet_size);       /* get gap */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      bulk probe the link stability
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 link is not stable
+ * @note       none
+ */
+static uint8_t a_as608_bulk_probe(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+{
+    uint8_t i;
+    as608_params_t param;
+    
+    for (i = 0; i < AS608_BULK_PROBE_ROUNDS; i++)                                  /* probe rounds */
+    {
+        if (as608_get_params(handle, addr, &param, status) != 0)                   /* get params */
+        {
+            return 1;                                                              /* return error */
+        }
+        if ((*status) != AS608_STATUS_OK)                                          /* check status */
+        {
+            return 1;                                                              /* return error */
+        }
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      bulk find the fastest host baud rate
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *n_9600 pointer to an n_9600 buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 handshake failed
+ * @note       only the host rate is changed and set back, the chip register is not written,
+ *             the link is checked by a handshake at the old rate after every change,
+ *             n_9600 is the old rate if no faster host rate is usable
+ */
+static uint8_t a_as608_bulk_find(as608_handle_t *handle, uint32_t addr, uint8_t *n_9600, as608_status_t *status)
+{
+    uint8_t n;
+    uint8_t ok;
+    as608_params_t param;
+    
+    *n_9600 = handle->bulk_n_9600;                                                           /* init the old rate */
+    for (n = 12; n > handle->bulk_n_9600; n--)                                               /* probe downward */
+    {
+        ok = (a_as608_port_uart_set_baud_rate(handle, (uint32_t)n * 9600) == 0);             /* set the host rate only */
+        if (a_as608_port_uart_set_baud_rate(handle, 
+                                            (uint32_t)handle->bulk_n_9600 * 9600) != 0)      /* set the old host rate */
+        {
+            return 1;                                                                        /* return error */
+        }
+        if ((as608_get_params(handle, addr, &param, status) != 0) || 
+            ((*status) != AS608_STATUS_OK))                                                  /* handshake */
+        {
+            return 1;                                                                        /* return error */
+        }
+        if (ok != 0)                                                                         /* check the host rate */
+        {
+            *n_9600 = n;                                                                     /* save the rate */
+            
+            return 0;                                                                        /* success return 0 */
+        }
+    }
+    
+    return 0;                                                                                /* keep the old rate */
+}
+
+/**
+ * @brief      bulk switch to the fastest stable baud rate
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 switch failed
+ * @note       the profile rate is used first, otherwise the fastest host rate is found without touching the chip,
+ *             the chip register is written once for the chosen rate and once more to go back if the link is not stable
+ */
+static uint8_t a_as608_bulk_switch(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+{
+    uint8_t n;
+    uint8_t res;
+    
+    if (handle->bulk_profile.valid != 0)                                                     /* check profile */
+    {
+        n = handle->bulk_profile.n_9600;                                                     /* use the profile rate */
+    }
+    else
+    {
+        if (a_as608_bulk_find(handle, addr, &n, status) != 0)                                /* find the host rate */
+        {
+            return 1;                                                                        /* return error */
+        }
+    }
+    if (n == handle->n_9600)                                                                 /* check rate */
+    {
+        *status = AS608_STATUS_OK;                                                           /* set status */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    
+    res = as608_switch_baud_rate(handle, addr, n, status);                                   /* switch rate once */
+    if ((res == 1) || (res == 7))                                                            /* check the chip rate is known */
+    {
+        return 1;                                                                            /* return error */
+    }
+    if ((res == 0) && ((*status) == AS608_STATUS_OK) && (handle->n_9600 == n))               /* check result */
+    {
+        if (a_as608_bulk_probe(handle, addr, status) == 0)                                   /* check stability */
+        {
+            return 0;                                                                        /* success return 0 */
+        }
+        if (as608_switch_baud_rate(handle, addr, handle->bulk_n_9600, status) != 0)          /* switch back */
+        {
+            return 1;                                                                        /* return error */
+        }
+    }
+    if (handle->n_9600 != handle->bulk_n_9600)                                               /* check the old rate */
+    {
+        return 1;                                                                            /* return error */
+    }
+    handle->bulk_profile.valid = 0;                                                          /* the profile is stale */
+    *status = AS608_STATUS_OK;                                                               /* set status */
+    
+    return 0;                                                                                /* keep the old rate */
+}
+
+/**
+ * @brief      bulk restore the settings before the session
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 restore failed
+ * @note       the packet size is still restored after the baud rate restore fails
+ */
+static uint8_t a_as608_bulk_restore(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+{
+    uint8_t res;
+    uint8_t ret;
+    as608_status_t s;
+    
+    ret = 0;                                                                                   /* init 0 */
+    s = AS608_STATUS_OK;                                                                       /* init ok */
+    *status = AS608_STATUS_OK;                                                                 /* set status */
+    if (handle->n_9600 != handle->bulk_n_9600)                                                 /* check rate */
+    {
+        res = as608_switch_baud_rate(handle, addr, handle->bulk_n_9600, &s);                   /* restore rate */
+        if ((res != 0) || (s != AS608_STATUS_OK))                                              /* check result */
+        {
+            handle->debug_print("as608: restore baud rate failed.\n");                         /* restore baud rate failed */
+            *status = s;                                                                       /* save status */
+            ret = 1;                                                                           /* set error */
+        }
+    }
+    if (handle->bulk_packet_size != AS608_PACKET_SIZE_256_BYTES)                               /* check packet size */
+    {
+        res = as608_set_packet_size(handle, addr, handle->bulk_packet_size, &s);               /* restore packet size */
+        if ((res != 0) || (s != AS608_STATUS_OK))                                              /* check result */
+        {
+            handle->debug_print("as608: restore packet size failed.\n");                       /* restore packet size failed */
+            *status = (ret != 0) ? *status : s;                                                /* keep the first status */
+            ret = 1;                                                                           /* set error */
+        }
+    }
+    
+    return ret;                                                                                /* return the result */
+}
+
+/**
+ * @brief      begin a bulk transfer session
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bulk begin failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 a command is in flight or a bulk session is active
+ * @note       the chip is switched to 256 bytes packets and the highest stable baud rate,
+ *             the rate is probed on the host side only and the chip baud register is written once for it,
+ *             the working settings are saved in the bulk profile and later sessions skip probing,
+ *             the baud rate is kept when uart_set_baud_rate is not linked,
+ *             if the begin fails the settings before the session are restored and no session is open
+ */
+uint8_t as608_bulk_begin(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (handle->async_busy != 0)                                                               /* check busy */
+    {
+        handle->debug_print("as608: a command is in flight.\n");                               /* a command is in flight */
+        
+        return 4;                                                                              /* return error */
+    }
+    if (handle->bulk_active != 0)                                                              /* check session */
+    {
+        handle->debug_print("as608: bulk session is active.\n");                               /* bulk session is active */
+        
+        return 4;                                                                              /* return error */
+    }
+    
+    handle->bulk_n_9600 = (uint8_t)handle->n_9600;                                             /* save n_9600 */
+    handle->bulk_packet_size = (handle->packet_size >= 256) ? AS608_PACKET_SIZE_256_BYTES :
+                               (handle->packet_size >= 128) ? AS608_PACKET_SIZE_128_BYTES :
+                               (handle->packet_size >= 64) ? AS608_PACKET_SIZE_64_BYTES :
+                               AS608_PACKET_SIZE_32_BYTES;                                     /* save packet size */
+    if (handle->bulk_packet_size != AS608_PACKET_SIZE_256_BYTES)                               /* check packet size */
+    {
+        res = as608_set_packet_size(handle, addr, AS608_PACKET_SIZE_256_BYTES, status);        /* set packet size */
+        if ((res != 0) || ((*status) != AS608_STATUS_OK))                                      /* check result */
+        {
+            handle->debug_print("as608: set packet size failed.\n");                           /* set packet size failed */
+            
+            return 1;                                                                          /* return error */
+        }
+    }
+    *status = AS608_STATUS_OK;                                                                 /* set status */
+    if (a_as608_port_has_set_baud_rate(handle) != 0)                                           /* check uart_set_baud_rate */
+    {
+        if (a_as608_bulk_switch(handle, addr, status) != 0)                                    /* switch rate */
+        {
+            handle->debug_print("as608: bulk switch failed.\n");                               /* bulk switch failed */
+            (void)a_as608_bulk_restore(handle, addr, status);                                  /* restore the settings */
+            
+            return 1;                                                                          /* return error */
+        }
+    }
+    handle->bulk_active = 1;                                                                   /* set session */
+    handle->bulk_profile.valid = 1;                                                            /* set valid */
+    handle->bulk_profile.n_9600 = (uint8_t)handle->n_9600;                                     /* save n_9600 */
+    handle->bulk_profile.packet_size = AS608_PACKET_SIZE_256_BYTES;                            /* save packet size */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      end a bulk transfer session
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bulk end failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 a command is in flight or the bulk session is not active
+ * @note       the packet size and the baud rate before the session are restored,
+ *             the session is closed even if a restore fails and the other setting is still restored,
+ *             so after a failure the chip may be left at the session baud rate or 256 bytes packets
+ */
+uint8_t as608_bulk_end(as608_handle_t *handle, uint32_t addr, as608_status_t *status)
+{
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (handle->async_busy != 0)                                                               /* check busy */
+    {
+        handle->debug_print("as608: a command is in flight.\n");                               /* a command is in flight */
+        
+        return 4;                                                                              /* return error */
+    }
+    if (handle->bulk_active == 0)                                                              /* check session */
+    {
+        handle->debug_print("as608: bulk session is not active.\n");                           /* bulk session is not active */
+        
+        return 4;                                                                              /* return error */
+    }
+    
+    handle->bulk_active = 0;                                                                   /* clear session */
+    if (a_as608_bulk_restore(handle, addr, status) != 0)                                       /* restore the settings */
+    {
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the bulk profile
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *profile pointer to a bulk profile buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_bulk_profile(as608_handle_t *handle, as608_bulk_profile_t *profile)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    memcpy(profile, &handle->bulk_profile, sizeof(as608_bulk_profile_t));   /* copy profile */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the bulk profile
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *profile pointer to a bulk profile buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 profile is invalid
+ * @note      used to restore a saved profile, so that the first session skips probing
+ */
+uint8_t as608_set_bulk_profile(as608_handle_t *handle, as608_bulk_profile_t *profile)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if ((profile->valid != 0) && 
+        ((profile->n_9600 < 1) || (profile->n_9600 > 12)))                  /* check profile */
+    {
+        handle->debug_print("as608: profile is invalid.\n");                /* profile is invalid */
+        
+        return 4;                                                           /* return error */
+    }
+    
+    memcpy(&handle->bulk_profile, profile, sizeof(as608_bulk_profile_t));   /* copy profile */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the stats block
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *stats pointer to a stats block or NULL to disable the stats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the block is cleared and can be set before as608_init,
+ *            the latency needs timestamp_ms, otherwise all responses are counted in bucket 0
+ */
+uint8_t as608_set_stats(as608_handle_t *handle, as608_stats_t *stats)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    
+    if (stats != NULL)                                              /* check stats */
+    {
+        memset(stats, 0, sizeof(as608_stats_t));                    /* clear stats */
+    }
+    handle->stats = stats;                                          /* set stats */
+    handle->stats_pending = 0;                                      /* clear pending */
+    handle->stats_dropped = handle->parser.dropped;                 /* save dropped bytes */
+    handle->stats_invalid = handle->parser.invalid;                 /* save invalid headers */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get a snapshot of the stats
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *stats pointer to a stats buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 stats is not set
+ * @note       none
+ */
+uint8_t as608_get_stats(as608_handle_t *handle, as608_stats_t *stats)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if ((handle->stats == NULL) || (stats == NULL))                 /* check stats */
+    {
+        return 4;                                                   /* return error */
+    }
+    
+    a_as608_stats_sync(handle);                                     /* sync the stats */
+    memcpy(stats, handle->stats, sizeof(as608_stats_t));            /* copy stats */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 stats is not set
+ * @note      none
+ */
+uint8_t as608_reset_stats(as608_handle_t *handle)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->stats == NULL)                                      /* check stats */
+    {
+        return 4;                                                   /* return error */
+    }
+    
+    return as608_set_stats(handle, handle->stats);                  /* clear stats */
+}
+
+/**
+ * @brief      get a latency percentile of a command
+ * @param[in]  *stats pointer to a stats snapshot
+ * @param[in]  command command code
+ * @param[in]  percent percentile in 1 - 100
+ * @param[out] *ms pointer to a latency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ *             - 3 command or percent is invalid
+ *             - 4 no response is counted
+ * @note       ms is the upper bound of the histogram bucket, so p99 of 300ms responses gives 512ms
+ */
+uint8_t as608_stats_get_latency(as608_stats_t *stats, uint8_t command, uint8_t percent, uint32_t *ms)
+{
+    uint8_t i;
+    uint32_t total;
+    uint32_t count;
+    uint32_t rank;
+    
+    if ((stats == NULL) || (ms == NULL))                            /* check stats */
+    {
+        return 2;                                                   /* return error */
+    }
+    if ((command >= AS608_STATS_COMMAND_MAX) || 
+        (percent == 0) || (percent > 100))                          /* check command and percent */
+    {
+        return 3;                                                   /* return error */
+    }
+    
+    total = 0;                                                      /* init 0 */
+    for (i = 0; i < AS608_STATS_BUCKET_MAX; i++)                    /* loop all buckets */
+    {
+        total += stats->latency[command][i];                        /* sum all */
+    }
+    if (total == 0)                                                 /* check total */
+    {
+        return 4;                                                   /* return error */
+    }
+    rank = (uint32_t)(((uint64_t)total * percent + 99) / 100);      /* get the rank */
+    count = 0;                                                      /* init 0 */
+    for (i = 0; i < (AS608_STATS_BUCKET_MAX - 1); i++)              /* find the bucket */
+    {
+        count += stats->latency[command][i];                        /* count adds bucket */
+        if (count >= rank)                                          /* check rank */
+        {
+            break;                                                  /* break */
+        }
+    }
+    *ms = (uint32_t)1 << i;                                         /* bucket upper bound */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the frame trace
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] trace pointer to a trace function or NULL to disable the trace
+ * @param[in] *arg pointer to a trace argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the trace can be set before as608_init and should not block,
+ *            the timestamp needs timestamp_ms, otherwise it is 0
+ */
+uint8_t as608_set_trace(as608_handle_t *handle, as608_trace_t trace, void *arg)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    
+    handle->trace = trace;                                          /* set trace */
+    handle->trace_arg = arg;                                        /* set argument */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      initialize a capture config with the default values
+ * @param[out] *config pointer to a capture config structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 config is NULL
+ * @note       10ms min gap, 500ms max gap, 10s timeout and no wait function
+ */
+uint8_t as608_capture_config_init(as608_capture_config_t *config)
+{
+    if (config == NULL)                                                      /* check config */
+    {
+        return 2;                                                            /* return error */
+    }
+    
+    config->min_gap_ms = AS608_CAPTURE_DEFAULT_MIN_GAP_MS;                   /* set min gap */
+    config->max_gap_ms = AS608_CAPTURE_DEFAULT_MAX_GAP_MS;                   /* set max gap */
+    config->timeout_ms = AS608_CAPTURE_DEFAULT_TIMEOUT_MS;                   /* set timeout */
+    config->wait = NULL;                                                     /* no wait function */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      capture one fingerprint image
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  *config pointer to a capture config structure
+ * @param[out] *result pointer to a capture result buffer, it can be NULL
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get image failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timeout
+ *             - 5 config is invalid
+ * @note       no fingerprint keeps polling, the first poll runs at once and the gap starts at min_gap_ms
+ *             and doubles up to max_gap_ms, a too dry, too wet or too clutter image is retried at once,
+ *             an ok image or any other status ends the capture and the status is returned to the caller
+ */
+uint8_t as608_capture_image(as608_handle_t *handle, uint32_t addr, as608_capture_config_t *config, 
+                            as608_capture_result_t *result, as608_status_t *status)
+{
+    uint8_t res;
+    uint32_t start;
+    uint32_t polled;
+    uint32_t elapsed;
+    uint32_t gap;
+    as608_capture_result_t r;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if ((config == NULL) || (config->max_gap_ms < config->min_gap_ms))                  /* check config */
+    {
+        handle->debug_print("as608: config is invalid.\n");                             /* config is invalid */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    memset(&r, 0, sizeof(as608_capture_result_t));                                      /* clear the result */
+    start = a_as608_port_timestamp_ms(handle);                                           /* get the start time */
+    polled = 0;                                                                          /* init 0 */
+    gap = 0;                                                                             /* poll at once after the prompt */
+    while (1)                                                                            /* loop */
+    {
+        res = as608_get_image(handle, addr, status);                                     /* get image */
+        if (res != 0)                                                                    /* check result */
+        {
+            return 1;                                                                    /* return error */
+        }
+        r.polls++;                                                                       /* polls++ */
+        if (a_as608_port_has_timestamp(handle) == 0)                                     /* check timestamp */
+        {
+            polled += AS608_CAPTURE_IMAGE_MS;                                            /* count the get image time */
+        }
+        elapsed = a_as608_elapsed_ms(handle, start, polled);                             /* get the elapsed time */
+        r.latency_ms = elapsed;                                                          /* set latency */
+        if ((*status == AS608_STATUS_IMAGE_TOO_DRY) || 
+            (*status == AS608_STATUS_IMAGE_TOO_WET) || 
+            (*status == AS608_STATUS_IMAGE_TOO_CLUTTER))                                 /* a finger is on the sensor */
+        {
+            r.retries++;                                                                 /* retries++ */
+            gap = 0;                                                                     /* retry at once */
+        }
+        else if (*status == AS608_STATUS_NO_FINGERPRINT)                                 /* no finger */
+        {
+            gap = (gap == 0) ? config->min_gap_ms : (gap * 2);                           /* back off */
+            gap = (gap > config->max_gap_ms) ? config->max_gap_ms : gap;                 /* limit the gap */
+        }
+        else
+        {
+            break;                                                                       /* the capture is over */
+        }
+        if (elapsed >= config->timeout_ms)                                               /* check timeout */
+        {
+            if (result != NULL)                                                          /* check result */
+            {
+                *result = r;                                                             /* save result */
+            }
+            
+            return 4;                                                                    /* return timeout */
+        }
+        if (gap != 0)                                                                    /* check the gap */
+        {
+            polled += gap;                                                               /* polled time adds the gap */
+            if (config->wait != NULL)                                                    /* check the wait function */
+            {
+                if (config->wait(gap) == 0)                                              /* the wait is woken */
+                {
+                    gap = 0;                                                             /* poll tightly again */
+                }
+            }
+            else
+            {
+                a_as608_port_delay_ms(handle, gap);                                      /* delay the gap */
+            }
+        }
+    }
+    if (result != NULL)                                                                  /* check result */
+    {
+        *result = r;                                                                     /* save result */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     enroll async completion
+ * @param[in] *arg pointer to an enroll structure
+ * @param[in] res command result
+ * @param[in] command command code
+ * @param[in] status chip status
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @note      none
+ */
+static void a_as608_enroll_complete(void *arg, uint8_t res, uint8_t command, as608_status_t status, 
+                                    uint8_t *payload, uint16_t len)
+{
+    as608_enroll_t *enroll = (as608_enroll_t *)arg;
+    
+    (void)command;                                                                   /* not used */
+    enroll->busy = 0;                                                                /* clear busy */
+    enroll->res = res;                                                               /* save result */
+    enroll->status = status;                                                         /* save status */
+    enroll->value = 0;                                                               /* init 0 */
+    if ((res == 0) && (len >= 2))                                                    /* check the payload */
+    {
+        enroll->value = (uint16_t)((uint16_t)payload[0] << 8) | payload[1];          /* save value */
+    }
+}
+
+/**
+ * @brief     enroll run the callback
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] event enroll event
+ * @note      none
+ */
+static void a_as608_enroll_event(as608_enroll_t *enroll, as608_enroll_event_t event)
+{
+    if (enroll->callback != NULL)                                                    /* check callback */
+    {
+        enroll->callback(enroll->arg, event, enroll->sample, enroll->status);       /* run callback */
+    }
+}
+
+/**
+ * @brief     enroll enter a finger wait state
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] state wait state
+ * @param[in] now current timestamp
+ * @note      the first get image runs at once
+ */
+static void a_as608_enroll_wait(as608_enroll_t *enroll, as608_enroll_state_t state, uint32_t now)
+{
+    enroll->state = state;                                                           /* set state */
+    enroll->gap_ms = 0;                                                              /* poll at once */
+    enroll->wait_start = now;                                                        /* save start time */
+    enroll->next_ms = now;                                                           /* next poll now */
+}
+
+/**
+ * @brief     enroll back off the get image
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] now current timestamp
+ * @note      none
+ */
+static void a_as608_enroll_backoff(as608_enroll_t *enroll, uint32_t now)
+{
+    enroll->gap_ms = (enroll->gap_ms == 0) ? enroll->min_gap_ms : (enroll->gap_ms * 2);          /* back off */
+    enroll->gap_ms = (enroll->gap_ms > enroll->max_gap_ms) ? enroll->max_gap_ms : enroll->gap_ms; /* limit the gap */
+    enroll->next_ms = now + enroll->gap_ms;                                                       /* next poll time */
+}
+
+/**
+ * @brief     enroll handle the completed command
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] now current timestamp
+ * @note      none
+ */
+static void a_as608_enroll_response(as608_enroll_t *enroll, uint32_t now)
+{
+    if (enroll->res != 0)                                                                /* check result */
+    {
+        if ((enroll->res != 2) && (enroll->errors < AS608_ENROLL_ERROR_RETRY))           /* check the retry */
+        {
+            enroll->errors++;                                                            /* errors++ */
+            enroll->next_ms = now;                                                       /* submit the command again */
+            
+            return;                                                                      /* return */
+        }
+        enroll->state = AS608_ENROLL_STATE_FAILED;                                       /* failed */
+        a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                          /* error event */
+        
+        return;                                                                          /* return */
+    }
+    enroll->errors = 0;                                                                  /* clear errors */
+    
+    switch (enroll->state)
+    {
+        case AS608_ENROLL_STATE_WAIT_FINGER :
+        {
+            if (enroll->status == AS608_STATUS_OK)                                       /* finger down */
+            {
+                enroll->state = AS608_ENROLL_STATE_GEN_FEATURE;                          /* generate feature */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_FINGER_DOWN);            /* finger down event */
+            }
+            else if (enroll->status == AS608_STATUS_NO_FINGERPRINT)                      /* no finger */
+            {
+                a_as608_enroll_backoff(enroll, now);                                     /* back off */
+            }
+            else if ((enroll->status == AS608_STATUS_IMAGE_TOO_DRY) || 
+                     (enroll->status == AS608_STATUS_IMAGE_TOO_WET) || 
+                     (enroll->status == AS608_STATUS_IMAGE_TOO_CLUTTER))                 /* poor image */
+            {
+                enroll->gap_ms = 0;                                                      /* retry at once */
+                enroll->next_ms = now;                                                   /* next poll now */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_RETRY);                  /* retry event */
+            }
+            else
+            {
+                enroll->state = AS608_ENROLL_STATE_FAILED;                               /* failed */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                  /* error event */
+            }
+            
+            break;
+        }
+        case AS608_ENROLL_STATE_GEN_FEATURE :
+        {
+            if (enroll->status != AS608_STATUS_OK)                                       /* poor feature */
+            {
+                enroll->retake = 1;                                                      /* take the sample again */
+                a_as608_enroll_wait(enroll, AS608_ENROLL_STATE_WAIT_LIFT, now);          /* wait for the lift first */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_QUALITY);                /* quality event */
+            }
+            else if (enroll->sample == 1)                                                /* first sample */
+            {
+                enroll->retake = 0;                                                      /* take the next sample */
+                a_as608_enroll_wait(enroll, AS608_ENROLL_STATE_WAIT_LIFT, now);          /* wait for the lift */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_FEATURE);                /* feature event */
+            }
+            else
+            {
+                enroll->state = AS608_ENROLL_STATE_MATCH;                                /* match */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_FEATURE);                /* feature event */
+            }
+            
+            break;
+        }
+        case AS608_ENROLL_STATE_WAIT_LIFT :
+        {
+            if (enroll->status == AS608_STATUS_NO_FINGERPRINT)                           /* finger up */
+            {
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_FINGER_UP);              /* finger up event */
+                enroll->sample = (enroll->retake != 0) ? enroll->sample : 2;             /* the same or the second sample */
+                enroll->retake = 0;                                                      /* clear retake */
+                a_as608_enroll_wait(enroll, AS608_ENROLL_STATE_WAIT_FINGER, now);        /* wait for the finger */
+            }
+            else
+            {
+                a_as608_enroll_backoff(enroll, now);                                     /* back off */
+            }
+            
+            break;
+        }
+        case AS608_ENROLL_STATE_MATCH :
+        {
+            if (enroll->status == AS608_STATUS_OK)                                       /* matched */
+            {
+                enroll->score = enroll->value;                                           /* save score */
+                enroll->state = AS608_ENROLL_STATE_COMBINE;                              /* combine */
+            }
+            else
+            {
+                enroll->state = AS608_ENROLL_STATE_FAILED;                               /* failed */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                  /* error event */
+            }
+            
+            break;
+        }
+        case AS608_ENROLL_STATE_COMBINE :
+        {
+            if (enroll->status == AS608_STATUS_OK)                                       /* combined */
+            {
+                enroll->state = AS608_ENROLL_STATE_GET_PAGE;                             /* get page */
+            }
+            else
+            {
+                enroll->state = AS608_ENROLL_STATE_FAILED;                               /* failed */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                  /* error event */
+            }
+            
+            break;
+        }
+        case AS608_ENROLL_STATE_GET_PAGE :
+        {
+            if (enroll->status == AS608_STATUS_OK)                                       /* got the page */
+            {
+                enroll->page_number = enroll->value;                                     /* save page number */
+                enroll->state = AS608_ENROLL_STATE_STORE;                                /* store */
+            }
+            else
+            {
+                enroll->state = AS608_ENROLL_STATE_FAILED;                               /* failed */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                  /* error event */
+            }
+            
+            break;
+        }
+        case AS608_ENROLL_STATE_STORE :
+        {
+            if (enroll->status == AS608_STATUS_OK)                                       /* stored */
+            {
+                enroll->state = AS608_ENROLL_STATE_DONE;                                 /* done */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_STORED);                 /* stored event */
+            }
+            else
+            {
+                enroll->state = AS608_ENROLL_STATE_FAILED;                               /* failed */
+                a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                  /* error event */
+            }
+            
+            break;
+        }
+        default :
+        {
+            break;
         }
-        case AS608_STATUS_NO_FINGERPRINT :                                       /* status case */
+    }
+}
+
+/**
+ * @brief     enroll submit the command of the state
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] now current timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      a get image is not submitted before its poll time
+ */
+static uint8_t a_as608_enroll_submit(as608_handle_t *handle, as608_enroll_t *enroll, uint32_t now)
+{
+    uint8_t buf[4];
+    uint16_t len;
+    uint32_t timeout_ms;
+    
+    switch (enroll->state)
+    {
+        case AS608_ENROLL_STATE_WAIT_FINGER :
+        case AS608_ENROLL_STATE_WAIT_LIFT :
         {
-            handle->debug_print("as608: no fingerprint.\n");                     /* print message */
+            if ((int32_t)(now - enroll->next_ms) < 0)                                    /* check the poll time */
+            {
+                return 0;                                                                /* not yet */
+            }
+            buf[0] = AS608_COMMAND_GET_IMAGE;                                            /* get image */
+            len = 1;                                                                     /* len 1 */
+            timeout_ms = 500;                                                            /* 500ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_INPUT_ERROR :                                          /* status case */
+        case AS608_ENROLL_STATE_GEN_FEATURE :
         {
-            handle->debug_print("as608: fingerprint image error.\n");            /* print message */
+            buf[0] = AS608_COMMAND_GEN_CHAR;                                             /* generate char */
+            buf[1] = enroll->sample;                                                     /* set the buffer number */
+            len = 2;                                                                     /* len 2 */
+            timeout_ms = 400;                                                            /* 400ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_IMAGE_TOO_DRY :                                        /* status case */
+        case AS608_ENROLL_STATE_MATCH :
         {
-            handle->debug_print("as608: fingerprint image too dry.\n");          /* print message */
+            buf[0] = AS608_COMMAND_MATCH;                                                /* match feature */
+            len = 1;                                                                     /* len 1 */
+            timeout_ms = 300;                                                            /* 300ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_IMAGE_TOO_WET :                                        /* status case */
+        case AS608_ENROLL_STATE_COMBINE :
         {
-            handle->debug_print("as608: fingerprint image too wet.\n");          /* print message */
+            buf[0] = AS608_COMMAND_REG_MODEL;                                            /* reg model */
+            len = 1;                                                                     /* len 1 */
+            timeout_ms = 300;                                                            /* 300ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_IMAGE_TOO_CLUTTER :                                    /* status case */
+        case AS608_ENROLL_STATE_GET_PAGE :
         {
-            handle->debug_print("as608: fingerprint too clutter.\n");            /* print message */
+            buf[0] = AS608_COMMAND_VALID_TEMPLATE_NUM;                                   /* valid template num */
+            len = 1;                                                                     /* len 1 */
+            timeout_ms = 300;                                                            /* 300ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_IMAGE_TOO_FEW_FEATURE :                                /* status case */
+        case AS608_ENROLL_STATE_STORE :
         {
-            handle->debug_print("as608: fingerprint feature too few.\n");        /* print message */
+            buf[0] = AS608_COMMAND_STORE_CHAR;                                           /* store char */
+            buf[1] = AS608_BUFFER_NUMBER_2;                                              /* set the buffer number */
+            buf[2] = (enroll->page_number >> 8) & 0xFF;                                  /* set the page number msb */
+            buf[3] = (enroll->page_number >> 0) & 0xFF;                                  /* set the page number lsb */
+            len = 4;                                                                     /* len 4 */
+            timeout_ms = 300;                                                            /* 300ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_NOT_MATCH :                                            /* status case */
+        default :
         {
-            handle->debug_print("as608: not match.\n");                          /* print message */
-            
-            break;                                                               /* break */
+            return 0;                                                                    /* nothing to submit */
         }
-        case AS608_STATUS_NOT_FOUND :                                            /* status case */
+    }
+    if (as608_async_submit(handle, enroll->addr, buf, len, timeout_ms, 
+                           a_as608_enroll_complete, enroll) != 0)                        /* submit */
+    {
+        return 1;                                                                        /* return error */
+    }
+    enroll->busy = 1;                                                                    /* set busy */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     start an enrollment
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] addr chip address
+ * @param[in] *config pointer to a capture config structure
+ * @param[in] *callback pointer to a progress callback, it can be NULL
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a command is in flight
+ *            - 5 timestamp_ms is null
+ *            - 6 config is invalid
+ * @note      the gaps, the finger wait timeout and the wait function come from the config,
+ *            a transport error is retried up to 3 times in a row before the enrollment fails
+ */
+uint8_t as608_enroll_start(as608_handle_t *handle, as608_enroll_t *enroll, uint32_t addr, 
+                           as608_capture_config_t *config, as608_enroll_callback_t callback, void *arg)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->async_busy != 0)                                                         /* check busy */
+    {
+        handle->debug_print("as608: a command is in flight.\n");                         /* a command is in flight */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (a_as608_port_has_timestamp(handle) == 0)                                         /* check timestamp */
+    {
+        handle->debug_print("as608: timestamp_ms is null.\n");                           /* timestamp_ms is null */
+        
+        return 5;                                                                        /* return error */
+    }
+    if ((enroll == NULL) || (config == NULL) || 
+        (config->max_gap_ms < config->min_gap_ms))                                      /* check config */
+    {
+        handle->debug_print("as608: config is invalid.\n");                              /* config is invalid */
+        
+        return 6;                                                                        /* return error */
+    }
+    
+    memset(enroll, 0, sizeof(as608_enroll_t));                                           /* clear the enroll */
+    enroll->addr = addr;                                                                 /* set address */
+    enroll->sample = 1;                                                                  /* first sample */
+    enroll->status = AS608_STATUS_OK;                                                    /* init ok */
+    enroll->min_gap_ms = config->min_gap_ms;                                             /* set min gap */
+    enroll->max_gap_ms = config->max_gap_ms;                                             /* set max gap */
+    enroll->timeout_ms = config->timeout_ms;                                             /* set timeout */
+    enroll->wait = config->wait;                                                         /* set wait */
+    enroll->callback = callback;                                                         /* set callback */
+    enroll->arg = arg;                                                                   /* set argument */
+    a_as608_enroll_wait(enroll, AS608_ENROLL_STATE_WAIT_FINGER, 
+                        a_as608_port_timestamp_ms(handle));                              /* wait for the finger */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      run one enrollment step
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *enroll pointer to an enroll structure
+ * @param[out] *done pointer to a done flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 step failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 enroll is NULL
+ * @note       the function polls the command in flight and submits the next one,
+ *             it never waits without a wait function, otherwise it waits for the next get image in it
+ *             and a wake polls at once,
+ *             done is true when the state is done or failed and the callback has run,
+ *             the blocking functions must not be called before the enrollment is done
+ */
+uint8_t as608_enroll_step(as608_handle_t *handle, as608_enroll_t *enroll, as608_bool_t *done)
+{
+    uint32_t now;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (enroll == NULL)                                                                  /* check enroll */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    if (enroll->busy != 0)                                                               /* check busy */
+    {
+        (void)as608_async_poll(handle, NULL);                                            /* poll the command */
+        if (enroll->busy == 0)                                                           /* check the completion */
         {
-            handle->debug_print("as608: not found.\n");                          /* print message */
-            
-            break;                                                               /* break */
+            a_as608_enroll_response(enroll, a_as608_port_timestamp_ms(handle));          /* handle the response */
         }
-        case AS608_STATUS_FEATURE_COMBINE_ERROR :                                /* status case */
+    }
+    if (enroll->busy == 0)                                                               /* check busy */
+    {
+        now = a_as608_port_timestamp_ms(handle);                                         /* get the time */
+        if (((enroll->state == AS608_ENROLL_STATE_WAIT_FINGER) || 
+             (enroll->state == AS608_ENROLL_STATE_WAIT_LIFT)) && 
+            ((now - enroll->wait_start) >= enroll->timeout_ms))                          /* check timeout */
         {
-            handle->debug_print("as608: feature combine error.\n");              /* print message */
-            
-            break;                                                               /* break */
+            enroll->state = AS608_ENROLL_STATE_FAILED;                                   /* failed */
+            a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_TIMEOUT);                    /* timeout event */
         }
-        case AS608_STATUS_LIB_ADDR_OVER :                                        /* status case */
+        if (((enroll->state == AS608_ENROLL_STATE_WAIT_FINGER) || 
+             (enroll->state == AS608_ENROLL_STATE_WAIT_LIFT)) && 
+            (enroll->wait != NULL) && ((int32_t)(enroll->next_ms - now) > 0))             /* check the poll time */
         {
-            handle->debug_print("as608: fingerprint lib addr is over.\n");       /* print message */
-            
-            break;                                                               /* break */
+            if (enroll->wait(enroll->next_ms - now) == 0)                                /* the wait is woken */
+            {
+                enroll->gap_ms = 0;                                                      /* poll tightly again */
+            }
+            now = a_as608_port_timestamp_ms(handle);                                     /* get the time */
+            enroll->next_ms = now;                                                       /* poll now */
         }
-        case AS608_STATUS_LIB_READ_ERROR :                                       /* status case */
+        if (a_as608_enroll_submit(handle, enroll, now) != 0)                             /* submit the next command */
         {
-            handle->debug_print("as608: fingerprint lib read error.\n");         /* print message */
+            handle->debug_print("as608: submit failed.\n");                              /* submit failed */
+            enroll->state = AS608_ENROLL_STATE_FAILED;                                   /* failed */
+            a_as608_enroll_event(enroll, AS608_ENROLL_EVENT_ERROR);                      /* error event */
+            if (done != NULL)                                                            /* check done */
+            {
+                *done = AS608_BOOL_TRUE;                                                 /* set done */
+            }
             
-            break;                                                               /* break */
+            return 1;                                                                    /* return error */
         }
-        case AS608_STATUS_UPLOAD_FEATURE_ERROR :                                 /* status case */
+    }
+    if (done != NULL)                                                                    /* check done */
+    {
+        *done = ((enroll->state == AS608_ENROLL_STATE_DONE) || 
+                 (enroll->state == AS608_ENROLL_STATE_FAILED) || 
+                 (enroll->state == AS608_ENROLL_STATE_IDLE)) ? AS608_BOOL_TRUE : AS608_BOOL_FALSE; /* set done */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     cancel an enrollment
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *enroll pointer to an enroll structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 enroll is NULL
+ * @note      the command in flight is cancelled and the state goes back to idle without a callback
+ */
+uint8_t as608_enroll_cancel(as608_handle_t *handle, as608_enroll_t *enroll)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (enroll == NULL)                                                                  /* check enroll */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    if (enroll->busy != 0)                                                               /* check busy */
+    {
+        (void)as608_async_cancel(handle);                                                /* cancel the command */
+    }
+    enroll->busy = 0;                                                                    /* clear busy */
+    enroll->state = AS608_ENROLL_STATE_IDLE;                                             /* idle */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     verify async completion
+ * @param[in] *arg pointer to a verify structure
+ * @param[in] res command result
+ * @param[in] command command code
+ * @param[in] status chip status
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @note      none
+ */
+static void a_as608_verify_complete(void *arg, uint8_t res, uint8_t command, as608_status_t status, 
+                                    uint8_t *payload, uint16_t len)
+{
+    as608_verify_t *verify = (as608_verify_t *)arg;
+    
+    (void)command;                                                                   /* not used */
+    verify->busy = 0;                                                                /* clear busy */
+    verify->res = res;                                                               /* save result */
+    verify->status = status;                                                         /* save status */
+    memset(verify->payload, 0, 4);                                                   /* clear the payload */
+    if (res == 0)                                                                    /* check result */
+    {
+        memcpy(verify->payload, payload, (len > 4) ? 4 : len);                       /* save the payload */
+    }
+}
+
+/**
+ * @brief     verify finish
+ * @param[in] *verify pointer to a verify structure
+ * @param[in] state end state
+ * @param[in] now current timestamp
+ * @note      none
+ */
+static void a_as608_verify_finish(as608_verify_t *verify, as608_verify_state_t state, uint32_t now)
+{
+    verify->phase = verify->state;                                                   /* save the last phase */
+    verify->state = state;                                                           /* set state */
+    verify->timing.total_ms = now - verify->start;                                   /* set the total time */
+}
+
+/**
+ * @brief     verify handle the completed command
+ * @param[in] *verify pointer to a verify structure
+ * @param[in] now current timestamp
+ * @note      none
+ */
+static void a_as608_verify_response(as608_verify_t *verify, uint32_t now)
+{
+    if (verify->res != 0)                                                                /* check result */
+    {
+        a_as608_verify_finish(verify, AS608_VERIFY_STATE_FAILED, now);                   /* failed */
+        
+        return;                                                                          /* return */
+    }
+    
+    switch (verify->state)
+    {
+        case AS608_VERIFY_STATE_IMAGE :
         {
-            handle->debug_print("as608: upload feature error.\n");               /* print message */
+            verify->timing.image_ms = now - verify->submit;                              /* set the image time */
+            verify->timing.wait_ms = verify->submit - verify->start;                     /* set the wait time */
+            if (verify->status == AS608_STATUS_OK)                                       /* finger down */
+            {
+                verify->state = AS608_VERIFY_STATE_FEATURE;                              /* generate feature */
+            }
+            else if ((now - verify->start) >= verify->timeout_ms)                        /* check timeout */
+            {
+                a_as608_verify_finish(verify, AS608_VERIFY_STATE_DONE, now);             /* done */
+            }
+            else if (verify->status == AS608_STATUS_NO_FINGERPRINT)                      /* no finger */
+            {
+                verify->gap_ms = (verify->gap_ms == 0) ? verify->min_gap_ms : (verify->gap_ms * 2);          /* back off */
+                verify->gap_ms = (verify->gap_ms > verify->max_gap_ms) ? verify->max_gap_ms : verify->gap_ms; /* limit the gap */
+                verify->next_ms = now + verify->gap_ms;                                                       /* next poll time */
+            }
+            else if ((verify->status == AS608_STATUS_IMAGE_TOO_DRY) || 
+                     (verify->status == AS608_STATUS_IMAGE_TOO_WET) || 
+                     (verify->status == AS608_STATUS_IMAGE_TOO_CLUTTER))                 /* poor image */
+            {
+                verify->gap_ms = 0;                                                      /* retry at once */
+                verify->next_ms = now;                                                   /* next poll now */
+            }
+            else
+            {
+                a_as608_verify_finish(verify, AS608_VERIFY_STATE_DONE, now);             /* done */
+            }
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_NO_FRAME :                                             /* status case */
+        case AS608_VERIFY_STATE_FEATURE :
         {
-            handle->debug_print("as608: no frame.\n");                           /* print message */
+            verify->timing.feature_ms = now - verify->submit;                            /* set the feature time */
+            if (verify->status == AS608_STATUS_OK)                                       /* generated */
+            {
+                verify->state = AS608_VERIFY_STATE_SEARCH;                               /* search */
+            }
+            else
+            {
+                a_as608_verify_finish(verify, AS608_VERIFY_STATE_DONE, now);             /* done */
+            }
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_UPLOAD_IMAGE_ERROR :                                   /* status case */
+        case AS608_VERIFY_STATE_SEARCH :
         {
-            handle->debug_print("as608: upload image error.\n");                 /* print message */
+            verify->timing.search_ms += now - verify->submit;                            /* add the search time */
+            if ((verify->mode == AS608_VERIFY_MODE_HIGH_SPEED_SEARCH) && (verify->confirm == 0) && 
+                (verify->status == AS608_STATUS_NOT_FOUND))                              /* the high speed search may miss */
+            {
+                verify->confirm = 1;                                                     /* confirm by a full search */
+                
+                break;
+            }
+            verify->found_page = (uint16_t)((uint16_t)verify->payload[0] << 8) | 
+                                 verify->payload[1];                                     /* set the found page */
+            verify->score = (uint16_t)((uint16_t)verify->payload[2] << 8) | 
+                            verify->payload[3];                                          /* set the score */
+            a_as608_verify_finish(verify, AS608_VERIFY_STATE_DONE, now);                 /* done */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_LIB_DELETE_ERROR :                                     /* status case */
+        default :
         {
-            handle->debug_print("as608: delete lib error.\n");                   /* print message */
-            
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_LIB_CLEAR_ERROR :                                      /* status case */
+    }
+}
+
+/**
+ * @brief     verify submit the command of the state
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @param[in] now current timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      a get image is not submitted before its poll time
+ */
+static uint8_t a_as608_verify_submit(as608_handle_t *handle, as608_verify_t *verify, uint32_t now)
+{
+    uint8_t buf[6];
+    uint16_t len;
+    uint32_t timeout_ms;
+    
+    switch (verify->state)
+    {
+        case AS608_VERIFY_STATE_IMAGE :
         {
-            handle->debug_print("as608: clear lib error.\n");                    /* print message */
+            if ((int32_t)(now - verify->next_ms) < 0)                                    /* check the poll time */
+            {
+                return 0;                                                                /* not yet */
+            }
+            buf[0] = AS608_COMMAND_GET_IMAGE;                                            /* get image */
+            len = 1;                                                                     /* len 1 */
+            timeout_ms = 500;                                                            /* 500ms */
+            verify->timing.polls++;                                                      /* polls++ */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_ENTER_LOW_POWER_ERROR :                                /* status case */
+        case AS608_VERIFY_STATE_FEATURE :
         {
-            handle->debug_print("as608: enter low power error.\n");              /* print message */
+            buf[0] = AS608_COMMAND_GEN_CHAR;                                             /* generate char */
+            buf[1] = verify->num;                                                        /* set the buffer number */
+            len = 2;                                                                     /* len 2 */
+            timeout_ms = 400;                                                            /* 400ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_COMMAND_INVALID :                                      /* status case */
+        case AS608_VERIFY_STATE_SEARCH :
         {
-            handle->debug_print("as608: command invalid.\n");                    /* print message */
+            buf[0] = ((verify->mode == AS608_VERIFY_MODE_HIGH_SPEED_SEARCH) && (verify->confirm == 0)) ? 
+                     AS608_COMMAND_HIGH_SPEED_SEARCH : AS608_COMMAND_SEARCH;             /* search */
+            buf[1] = verify->num;                                                        /* set the buffer number */
+            buf[2] = (verify->start_page >> 8) & 0xFF;                                   /* start page msb */
+            buf[3] = (verify->start_page >> 0) & 0xFF;                                   /* start page lsb */
+            buf[4] = (verify->page_number >> 8) & 0xFF;                                  /* page number msb */
+            buf[5] = (verify->page_number >> 0) & 0xFF;                                  /* page number lsb */
+            len = 6;                                                                     /* len 6 */
+            timeout_ms = 300;                                                            /* 300ms */
             
-            break;                                                               /* break */
+            break;
         }
-        case AS608_STATUS_RESET_ERROR :                                          /* status case */
+        default :
+        {
+            return 0;                                                                    /* nothing to submit */
+        }
+    }
+    if (as608_async_submit(handle, verify->addr, buf, len, timeout_ms, 
+                           a_as608_verify_complete, verify) != 0)                        /* submit */
+    {
+        return 1;                                                                        /* return error */
+    }
+    verify->submit = now;                                                                /* save the submit time */
+    verify->busy = 1;                                                                    /* set busy */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     start a verification
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @param[in] addr chip address
+ * @param[in] mode search mode
+ * @param[in] num buffer number
+ * @param[in] start_page search start page
+ * @param[in] page_number search page number
+ * @param[in] *config pointer to a capture config structure, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a command is in flight
+ *            - 5 timestamp_ms is null
+ *            - 6 config is invalid
+ * @note      with a config the finger is waited for as the capture does,
+ *            without a config the image is taken once,
+ *            a not found of the high speed search is confirmed by a full search
+ */
+uint8_t as608_verify_start(as608_handle_t *handle, as608_verify_t *verify, uint32_t addr, as608_verify_mode_t mode, 
+                           as608_buffer_number_t num, uint16_t start_page, uint16_t page_number, 
+                           as608_capture_config_t *config)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->async_busy != 0)                                                         /* check busy */
+    {
+        handle->debug_print("as608: a command is in flight.\n");                         /* a command is in flight */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (a_as608_port_has_timestamp(handle) == 0)                                         /* check timestamp */
+    {
+        handle->debug_print("as608: timestamp_ms is null.\n");                           /* timestamp_ms is null */
+        
+        return 5;                                                                        /* return error */
+    }
+    if ((verify == NULL) || 
+        ((config != NULL) && (config->max_gap_ms < config->min_gap_ms)))                 /* check config */
+    {
+        handle->debug_print("as608: config is invalid.\n");                              /* config is invalid */
+        
+        return 6;                                                                        /* return error */
+    }
+    
+    memset(verify, 0, sizeof(as608_verify_t));                                           /* clear the verify */
+    verify->addr = addr;                                                                 /* set address */
+    verify->mode = mode;                                                                 /* set mode */
+    verify->num = num;                                                                   /* set buffer number */
+    verify->start_page = start_page;                                                     /* set start page */
+    verify->page_number = page_number;                                                   /* set page number */
+    verify->status = AS608_STATUS_OK;                                                    /* init ok */
+    if (config != NULL)                                                                  /* check config */
+    {
+        verify->min_gap_ms = config->min_gap_ms;                                         /* set min gap */
+        verify->max_gap_ms = config->max_gap_ms;                                         /* set max gap */
+        verify->timeout_ms = config->timeout_ms;                                         /* set timeout */
+    }
+    verify->start = a_as608_port_timestamp_ms(handle);                                   /* save start time */
+    verify->next_ms = verify->start;                                                     /* next poll now */
+    verify->state = AS608_VERIFY_STATE_IMAGE;                                            /* get image */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      run one verification step
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *verify pointer to a verify structure
+ * @param[out] *done pointer to a done flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 step failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 verify is NULL
+ * @note       the function never waits, the host can do its own work between the steps while the chip
+ *             processes the command in flight, when done the status is the status of the last command,
+ *             found_page and score are valid if the status is ok, the phase timing is kept in timing
+ */
+uint8_t as608_verify_step(as608_handle_t *handle, as608_verify_t *verify, as608_bool_t *done)
+{
+    uint8_t res;
+    uint32_t now;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (verify == NULL)                                                                  /* check verify */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    res = 0;                                                                             /* init 0 */
+    if (verify->busy != 0)                                                               /* check busy */
+    {
+        (void)as608_async_poll(handle, NULL);                                            /* poll the command */
+        if (verify->busy == 0)                                                           /* check the completion */
         {
-            handle->debug_print("as608: reset error.\n");                        /* print message */
-            
-            break;                                                               /* break */
+            a_as608_verify_response(verify, a_as608_port_timestamp_ms(handle));          /* handle the response */
+            res = (verify->state == AS608_VERIFY_STATE_FAILED) ? 1 : 0;                  /* set result */
         }
-        case AS608_STATUS_BUFFER_INVALID :                                       /* status case */
+    }
+    if (verify->busy == 0)                                                               /* check busy */
+    {
+        now = a_as608_port_timestamp_ms(handle);                                         /* get the time */
+        if (a_as608_verify_submit(handle, verify, now) != 0)                             /* submit the next command */
         {
-            handle->debug_print("as608: buffer invalid.\n");                     /* print message */
-            
-            break;                                                               /* break */
+            handle->debug_print("as608: submit failed.\n");                              /* submit failed */
+            a_as608_verify_finish(verify, AS608_VERIFY_STATE_FAILED, now);               /* failed */
+            res = 1;                                                                     /* set result */
         }
-        case AS608_STATUS_UPDATE_ERROR :                                         /* status case */
+    }
+    if (done != NULL)                                                                    /* check done */
+    {
+        *done = ((verify->state == AS608_VERIFY_STATE_DONE) || 
+                 (verify->state == AS608_VERIFY_STATE_FAILED) || 
+                 (verify->state == AS608_VERIFY_STATE_IDLE)) ? AS608_BOOL_TRUE : AS608_BOOL_FALSE; /* set done */
+    }
+    
+    return res;                                                                          /* return the result */
+}
+
+/**
+ * @brief     cancel a verification
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 verify is NULL
+ * @note      the command in flight is cancelled and the state goes back to idle
+ */
+uint8_t as608_verify_cancel(as608_handle_t *handle, as608_verify_t *verify)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (verify == NULL)                                                                  /* check verify */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    if (verify->busy != 0)                                                               /* check busy */
+    {
+        (void)as608_async_cancel(handle);                                                /* cancel the command */
+    }
+    verify->busy = 0;                                                                    /* clear busy */
+    verify->state = AS608_VERIFY_STATE_IDLE;                                             /* idle */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     best identify select the path
+ * @param[in] *best pointer to a best identify structure
+ * @param[in] start_page search start page
+ * @return    path
+ * @note      an unknown path goes first, then the least recently used path every explore period,
+ *            otherwise the path with the lowest ewma
+ */
+static as608_identify_path_t a_as608_best_select(as608_best_identify_t *best, uint16_t start_page)
+{
+    uint8_t i;
+    uint8_t first;
+    uint8_t path;
+    
+    first = (start_page == 0) ? AS608_IDENTIFY_PATH_IDENTIFY : AS608_IDENTIFY_PATH_SEARCH;      /* identify needs the whole library */
+    for (i = first; i < AS608_BEST_PATH_NUM; i++)                                               /* find an unknown path */
+    {
+        if (best->count[i] == 0)                                                                /* check the count */
         {
-            handle->debug_print("as608: update error.\n");                       /* print message */
-            
-            break;                                                               /* break */
+            return (as608_identify_path_t)i;                                                    /* return the path */
         }
-        case AS608_STATUS_NO_MOVE :                                              /* status case */
+    }
+    path = first;                                                                               /* init the first path */
+    if ((best->requests % AS608_BEST_EXPLORE_PERIOD) == 0)                                      /* explore */
+    {
+        for (i = first + 1; i < AS608_BEST_PATH_NUM; i++)                                       /* find the oldest path */
         {
-            handle->debug_print("as608: no move.\n");                            /* print message */
-            
-            break;                                                               /* break */
+            if (best->last_used[i] < best->last_used[path])                                     /* check the last used */
+            {
+                path = i;                                                                       /* save the path */
+            }
         }
-        case AS608_STATUS_FLASH_ERROR :                                          /* status case */
+    }
+    else
+    {
+        for (i = first + 1; i < AS608_BEST_PATH_NUM; i++)                                       /* find the fastest path */
         {
-            handle->debug_print("as608: flash error.\n");                        /* print message */
-            
-            break;                                                               /* break */
+            if (best->ewma_ms[i] < best->ewma_ms[path])                                         /* check the ewma */
+            {
+                path = i;                                                                       /* save the path */
+            }
         }
-        case AS608_STATUS_F0_RESPONSE :                                          /* status case */
+    }
+    
+    return (as608_identify_path_t)path;                                                         /* return the path */
+}
+
+/**
+ * @brief      best identify run one path
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *best pointer to a best identify structure
+ * @param[in]  addr chip address
+ * @param[in]  path identify path
+ * @param[in]  start_page search start page
+ * @param[in]  page_number search page number
+ * @param[out] *found_page pointer to a found page buffer
+ * @param[out] *score pointer to a score buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       an ok or not found answer updates the ewma of the path with weight 1/4,
+ *             a not found from the high speed search is confirmed by a full search and the time is
+ *             charged to the high speed path
+ */
+static uint8_t a_as608_best_run(as608_handle_t *handle, as608_best_identify_t *best, uint32_t addr, 
+                                as608_identify_path_t path, uint16_t start_page, uint16_t page_number, 
+                                uint16_t *found_page, uint16_t *score, as608_status_t *status)
+{
+    uint8_t res;
+    uint32_t start;
+    uint32_t ms;
+    
+    best->requests++;                                                                           /* requests++ */
+    best->path = path;                                                                          /* save the path */
+    best->last_used[path] = best->requests;                                                     /* save the last used */
+    start = a_as608_port_timestamp_ms(handle);                                                  /* get the start time */
+    if (path == AS608_IDENTIFY_PATH_IDENTIFY)                                                   /* identify */
+    {
+        res = as608_identify(handle, addr, found_page, score, status);                          /* identify */
+        if (res != 0)                                                                           /* check result */
         {
-            handle->debug_print("as608: f0 response.\n");                        /* print message */
-            
-            break;                                                               /* break */
+            return 1;                                                                           /* return error */
         }
-        case AS608_STATUS_F1_RESPONSE :                                          /* status case */
+    }
+    else
+    {
+        res = as608_get_image(handle, addr, status);                                            /* get image */
+        if (res != 0)                                                                           /* check result */
         {
-            handle->debug_print("as608: f1 response.\n");                        /* print message */
-            
-            break;                                                               /* break */
+            return 1;                                                                           /* return error */
         }
-        case AS608_STATUS_FLASH_WRITE_SUM_ERROR :                                /* status case */
+        if (*status != AS608_STATUS_OK)                                                         /* check status */
         {
-            handle->debug_print("as608: flash sum error.\n");                    /* print message */
-            
-            break;                                                               /* break */
+            return 0;                                                                           /* no sample */
         }
-        case AS608_STATUS_FLASH_WRITE_HEADER_ERROR :                             /* status case */
+        res = as608_generate_feature(handle, addr, AS608_BUFFER_NUMBER_1, status);              /* generate feature */
+        if (res != 0)                                                                           /* check result */
         {
-            handle->debug_print("as608: flash header error.\n");                 /* print message */
-            
-            break;                                                               /* break */
+            return 1;                                                                           /* return error */
         }
-        case AS608_STATUS_FLASH_WRITE_LENGTH_ERROR :                             /* status case */
+        if (*status != AS608_STATUS_OK)                                                         /* check status */
         {
-            handle->debug_print("as608: flash length error.\n");                 /* print message */
-            
-            break;                                                               /* break */
+            return 0;                                                                           /* no sample */
         }
-        case AS608_STATUS_FLASH_WRITE_LENGTH_TOO_LONG :                          /* status case */
+        if (path == AS608_IDENTIFY_PATH_SEARCH)                                                 /* search */
         {
-            handle->debug_print("as608: flash length too long.\n");              /* print message */
-            
-            break;                                                               /* break */
+            res = as608_search_feature(handle, addr, AS608_BUFFER_NUMBER_1, start_page, 
+                                       page_number, found_page, score, status);                 /* search feature */
         }
-        case AS608_STATUS_FLASH_WRITE_ERROR :                                    /* status case */
+        else
         {
-            handle->debug_print("as608: flash write error.\n");                  /* print message */
-            
-            break;                                                               /* break */
+            res = as608_high_speed_search(handle, addr, AS608_BUFFER_NUMBER_1, start_page, 
+                                          page_number, found_page, score, status);              /* high speed search */
+            if ((res == 0) && (*status == AS608_STATUS_NOT_FOUND))                              /* high speed search can miss */
+            {
+                res = as608_search_feature(handle, addr, AS608_BUFFER_NUMBER_1, start_page, 
+                                           page_number, found_page, score, status);             /* confirm by search */
+            }
         }
-        case AS608_STATUS_UNKNOWN :                                              /* status case */
+        if (res != 0)                                                                           /* check result */
         {
-            handle->debug_print("as608: unknown.\n");                            /* print message */
-            
-            break;                                                               /* break */
+            return 1;                                                                           /* return error */
         }
-        case AS608_STATUS_REG_INVALID :                                          /* status case */
+    }
+    ms = a_as608_port_timestamp_ms(handle) - start;                                             /* get the latency */
+    best->latency_ms = ms;                                                                      /* save the latency */
+    if ((*status == AS608_STATUS_OK) || (*status == AS608_STATUS_NOT_FOUND))                    /* the whole path ran */
+    {
+        if (best->count[path] == 0)                                                             /* first sample */
         {
-            handle->debug_print("as608: reg invalid.\n");                        /* print message */
-            
-            break;                                                               /* break */
+            best->ewma_ms[path] = ms;                                                           /* set the ewma */
         }
-        case AS608_STATUS_DATA_INVALID :                                         /* status case */
+        else
         {
-            handle->debug_print("as608: data invalid.\n");                       /* print message */
-            
-            break;                                                               /* break */
+            best->ewma_ms[path] = (best->ewma_ms[path] * 3 + ms + 2) / 4;                       /* update the ewma */
         }
-        case AS608_STATUS_NOTE_PAGE_INVALID :                                    /* status case */
+        best->count[path]++;                                                                    /* count++ */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      initialize the best identify statistics
+ * @param[out] *best pointer to a best identify structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 best is NULL
+ * @note       all paths start unknown and each one is tried once before the ewma is used
+ */
+uint8_t as608_best_identify_init(as608_best_identify_t *best)
+{
+    if (best == NULL)                                                     /* check best */
+    {
+        return 2;                                                         /* return error */
+    }
+    
+    memset(best, 0, sizeof(as608_best_identify_t));                       /* clear the statistics */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     benchmark the identify paths on the connected chip
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *best pointer to a best identify structure
+ * @param[in] addr chip address
+ * @param[in] start_page search start page
+ * @param[in] page_number search page number
+ * @param[in] rounds rounds of each path
+ * @return    status code
+ *            - 0 success
+ *            - 1 calibrate failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no valid sample
+ *            - 5 timestamp_ms is null
+ *            - 6 best is NULL
+ * @note      a finger must stay on the sensor, a round counts only when the chip answers ok or not found,
+ *            the identify path is skipped if start_page is not 0
+ */
+uint8_t as608_best_identify_calibrate(as608_handle_t *handle, as608_best_identify_t *best, uint32_t addr, 
+                                      uint16_t start_page, uint16_t page_number, uint8_t rounds)
+{
+    uint8_t i;
+    uint8_t j;
+    uint16_t found_page;
+    uint16_t score;
+    as608_status_t status;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (a_as608_port_has_timestamp(handle) == 0)                                                /* check timestamp */
+    {
+        handle->debug_print("as608: timestamp_ms is null.\n");                                  /* timestamp_ms is null */
+        
+        return 5;                                                                               /* return error */
+    }
+    if (best == NULL)                                                                           /* check best */
+    {
+        handle->debug_print("as608: best is NULL.\n");                                          /* best is NULL */
+        
+        return 6;                                                                               /* return error */
+    }
+    
+    for (i = (start_page == 0) ? AS608_IDENTIFY_PATH_IDENTIFY : AS608_IDENTIFY_PATH_SEARCH; 
+         i < AS608_BEST_PATH_NUM; i++)                                                          /* run all paths */
+    {
+        for (j = 0; j < rounds; j++)                                                            /* run all rounds */
         {
-            handle->debug_print("as608: note page invalid.\n");                  /* print message */
-            
-            break;                                                               /* break */
+            if (a_as608_best_run(handle, best, addr, (as608_identify_path_t)i, start_page, 
+                                 page_number, &found_page, &score, &status) != 0)               /* run the path */
+            {
+                handle->debug_print("as608: calibrate failed.\n");                              /* calibrate failed */
+                
+                return 1;                                                                       /* return error */
+            }
         }
-        case AS608_STATUS_PORT_INVALID :                                         /* status case */
+        if (best->count[i] == 0)                                                                /* check the samples */
         {
-            handle->debug_print("as608: port invalid.\n");                       /* print message */
+            handle->debug_print("as608: no valid sample.\n");                                   /* no valid sample */
             
-            break;                                                               /* break */
+            return 4;                                                                           /* return error */
         }
-        case AS608_STATUS_ENROLL_ERROR :                                         /* status case */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      identify through the lowest latency path
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *best pointer to a best identify structure
+ * @param[in]  addr chip address
+ * @param[in]  start_page search start page
+ * @param[in]  page_number search page number
+ * @param[out] *found_page pointer to a found page buffer
+ * @param[out] *score pointer to a score buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 identify failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 timestamp_ms is null
+ *             - 6 best is NULL
+ * @note       every path matches against the level set in the chip, so the score threshold is the same,
+ *             the high speed search only finds good samples, so its not found is confirmed by a full search,
+ *             the identify command always scans the whole library and is only used if start_page is 0,
+ *             each ok or not found answer updates the ewma of its path and every 32 requests the least
+ *             recently used path is tried to follow the chip as the library grows
+ */
+uint8_t as608_best_identify(as608_handle_t *handle, as608_best_identify_t *best, uint32_t addr, 
+                            uint16_t start_page, uint16_t page_number, 
+                            uint16_t *found_page, uint16_t *score, as608_status_t *status)
+{
+    as608_identify_path_t path;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (a_as608_port_has_timestamp(handle) == 0)                                                /* check timestamp */
+    {
+        handle->debug_print("as608: timestamp_ms is null.\n");                                  /* timestamp_ms is null */
+        
+        return 5;                                                                               /* return error */
+    }
+    if (best == NULL)                                                                           /* check best */
+    {
+        handle->debug_print("as608: best is NULL.\n");                                          /* best is NULL */
+        
+        return 6;                                                                               /* return error */
+    }
+    
+    path = a_as608_best_select(best, start_page);                                               /* select the path */
+    if (a_as608_best_run(handle, best, addr, path, start_page, page_number, 
+                         found_page, score, status) != 0)                                       /* run the path */
+    {
+        handle->debug_print("as608: identify failed.\n");                                       /* identify failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     initialize the frame parser
+ * @param[in] *parser pointer to an as608 parser structure
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] size frame buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 parser is NULL
+ *            - 3 size is too small
+ * @note      size >= 12
+ */
+uint8_t as608_parser_init(as608_parser_t *parser, uint8_t *buf, uint16_t size)
+{
+    if ((parser == NULL) || (buf == NULL))        /* check parser */
+    {
+        return 2;                                 /* return error */
+    }
+    if (size < 12)                                /* check size */
+    {
+        return 3;                                 /* return error */
+    }
+    
+    parser->buf = buf;                            /* set buffer */
+    parser->size = size;                          /* set size */
+    parser->point = 0;                            /* init 0 */
+    parser->need = 0;                             /* init 0 */
+    parser->dropped = 0;                          /* init 0 */
+    parser->invalid = 0;                          /* init 0 */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      feed bytes to the frame parser
+ * @param[in]  *parser pointer to an as608 parser structure
+ * @param[in]  *data pointer to an input buffer
+ * @param[in]  len input length
+ * @param[out] *used pointer to a used length buffer
+ * @param[out] *frame_len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 a frame is received
+ *             - 1 need more data
+ *             - 2 parser is NULL
+ * @note       the parser stops after a whole frame, the frame is saved in the parser buffer and
+ *             the remain bytes (len - used) should be fed again,
+ *             the parser resyncs on 0xEF 0x01 and the frame checksum is not checked
+ */
+uint8_t as608_parser_feed(as608_parser_t *parser, uint8_t *data, uint16_t len, 
+                          uint16_t *used, uint16_t *frame_len)
+{
+    uint16_t i;
+    uint16_t j;
+    uint16_t n;
+    uint8_t header[8];
+    
+    if ((parser == NULL) || (parser->buf == NULL))                                  /* check parser */
+    {
+        return 2;                                                                   /* return error */
+    }
+    
+    i = 0;                                                                          /* init 0 */
+    while (i < len)                                                                 /* loop all */
+    {
+        if (parser->point < 9)                                                      /* if in the header */
         {
-            handle->debug_print("as608: enroll error.\n");                       /* print message */
-            
-            break;                                                               /* break */
+            if (a_as608_parser_push(parser, data[i]) != 0)                          /* push one byte */
+            {
+                memcpy(header, &parser->buf[1], 8);                                 /* copy the header */
+                parser->point = 0;                                                  /* resync */
+                parser->dropped++;                                                  /* drop the header 0 */
+                parser->invalid++;                                                  /* invalid++ */
+                for (j = 0; j < 8; j++)                                             /* replay the header */
+                {
+                    (void)a_as608_parser_push(parser, header[j]);                   /* push one byte */
+                }
+            }
+            i++;                                                                    /* i++ */
         }
-        case AS608_STATUS_LIB_FULL :                                             /* status case */
+        else
         {
-            handle->debug_print("as608: lib full.\n");                           /* print message */
-            
-            break;                                                               /* break */
+            n = parser->need - parser->point;                                       /* get the remain length */
+            n = (n < (len - i)) ? n : (len - i);                                    /* get the copy length */
+            memcpy(&parser->buf[parser->point], &data[i], n);                       /* copy data */
+            parser->point += n;                                                     /* point adds n */
+            i += n;                                                                 /* i adds n */
         }
-        default :                                                                /* default */
+        if ((parser->point >= 9) && (parser->point == parser->need))                /* check the frame */
         {
-            handle->debug_print("as608: invalid type.\n");                       /* print message */
+            *used = i;                                                              /* set used length */
+            *frame_len = parser->point;                                             /* set frame length */
+            parser->point = 0;                                                      /* reset point */
             
-            break;                                                               /* break */
+            return 0;                                                               /* success return 0 */
         }
     }
+    *used = len;                                                                    /* all bytes are used */
     
-    return 0;                                                                    /* success return 0 */ 
+    return 1;                                                                       /* need more data */
 }
 
 /**
@@ -3438,7 +6733,7 @@ uint8_t as608_print_status(as608_handle_t *handle, as608_status_t status)
  * @param[in]     type frame type
  * @param[in]     *input_buffer pointer to an input buffer
  * @param[in]     input_len input length
- * @param[in]     ms delay in ms
+ * @param[in]     ms timeout in ms
  * @param[out]    *output_buffer pointer to an output buffer
  * @param[in,out] *output_len pointer to an output length buffer
  * @return        status code
@@ -206,6 +206,321 @@ typedef struct as608_params_s
     uint16_t n_9600;                        /**< n times of 9600 */
 } as608_params_t;
 
+/**
+ * @brief as608 bulk profile structure definition
+ */
+typedef struct as608_bulk_profile_s
+{
+    uint8_t valid;                          /**< valid flag */
+    uint8_t n_9600;                         /**< n times of 9600 */
+    as608_packet_size_t packet_size;        /**< packet size */
+} as608_bulk_profile_t;
+
+/**
+ * @brief as608 parser structure definition
+ */
+typedef struct as608_parser_s
+{
+    uint8_t *buf;             /**< frame buffer */
+    uint16_t size;            /**< frame buffer size */
+    uint16_t point;           /**< received length of the current frame */
+    uint16_t need;            /**< length of the current frame */
+    uint32_t dropped;         /**< dropped bytes when resyncing */
+    uint32_t invalid;         /**< dropped headers with an invalid length */
+} as608_parser_t;
+
+/**
+ * @brief as608 stats command max definition
+ */
+#define AS608_STATS_COMMAND_MAX    0x20        /**< command codes 0x00 - 0x1F are counted */
+
+/**
+ * @brief as608 stats bucket max definition
+ */
+#define AS608_STATS_BUCKET_MAX     16          /**< latency histogram buckets */
+
+/**
+ * @brief as608 stats error enumeration definition
+ */
+typedef enum
+{
+    AS608_STATS_ERROR_SUM     = 0x00,        /**< sum check error */
+    AS608_STATS_ERROR_HEADER  = 0x01,        /**< bytes dropped when searching the header */
+    AS608_STATS_ERROR_LEN     = 0x02,        /**< len is invalid */
+    AS608_STATS_ERROR_TYPE    = 0x03,        /**< type is invalid */
+    AS608_STATS_ERROR_ADDR    = 0x04,        /**< addr is invalid */
+    AS608_STATS_ERROR_TIMEOUT = 0x05,        /**< no response or the frame is not complete */
+    AS608_STATS_ERROR_MAX     = 0x06,        /**< error max */
+} as608_stats_error_t;
+
+/**
+ * @brief as608 stats structure definition
+ * @note  latency bucket 0 counts the responses in less than 1ms and bucket n counts [2^(n-1), 2^n) ms,
+ *        the last bucket also counts the longer ones
+ */
+typedef struct as608_stats_s
+{
+    uint32_t command_sent[AS608_STATS_COMMAND_MAX];                               /**< sent commands */
+    uint32_t frame_received[AS608_STATS_COMMAND_MAX];                             /**< received frames of every command */
+    uint32_t error[AS608_STATS_ERROR_MAX];                                        /**< errors */
+    uint32_t byte_in;                                                             /**< received bytes */
+    uint32_t byte_out;                                                            /**< sent bytes */
+    uint32_t latency[AS608_STATS_COMMAND_MAX][AS608_STATS_BUCKET_MAX];            /**< response latency histograms */
+} as608_stats_t;
+
+/**
+ * @brief as608 trace direction enumeration definition
+ */
+typedef enum
+{
+    AS608_TRACE_DIRECTION_TX = 0x00,        /**< frame sent to the chip */
+    AS608_TRACE_DIRECTION_RX = 0x01,        /**< frame received from the chip */
+} as608_trace_direction_t;
+
+/**
+ * @brief as608 trace frame structure definition
+ * @note  payload is only valid in the trace call
+ */
+typedef struct as608_trace_frame_s
+{
+    uint32_t timestamp_ms;                   /**< timestamp in ms */
+    as608_trace_direction_t direction;       /**< frame direction */
+    uint32_t addr;                           /**< frame address */
+    uint8_t type;                            /**< frame type */
+    uint8_t command;                         /**< command of the frame or of the request */
+    uint8_t *payload;                        /**< point to the payload */
+    uint16_t len;                            /**< payload length */
+    uint16_t sum;                            /**< check sum on the wire */
+} as608_trace_frame_t;
+
+/**
+ * @brief as608 trace definition
+ * @note  it is called for every sent frame and every received frame before it is checked
+ */
+typedef void (*as608_trace_t)(void *arg, as608_trace_frame_t *frame);
+
+/**
+ * @brief as608 capture wait definition
+ * @note  it waits up to ms and returns 0 when it is woken early, e.g. by the touch line
+ */
+typedef uint8_t (*as608_capture_wait_t)(uint32_t ms);
+
+/**
+ * @brief as608 capture config structure definition
+ */
+typedef struct as608_capture_config_s
+{
+    uint32_t min_gap_ms;              /**< first idle gap in ms */
+    uint32_t max_gap_ms;              /**< max idle gap in ms */
+    uint32_t timeout_ms;              /**< capture timeout in ms */
+    as608_capture_wait_t wait;        /**< wait function, NULL uses delay_ms */
+} as608_capture_config_t;
+
+/**
+ * @brief as608 capture result structure definition
+ */
+typedef struct as608_capture_result_s
+{
+    uint32_t latency_ms;        /**< time from the start to the last image */
+    uint32_t polls;             /**< get image times */
+    uint32_t retries;           /**< too dry, too wet or too clutter images */
+} as608_capture_result_t;
+
+/**
+ * @brief as608 enroll state enumeration definition
+ */
+typedef enum
+{
+    AS608_ENROLL_STATE_IDLE        = 0x00,        /**< idle */
+    AS608_ENROLL_STATE_WAIT_FINGER = 0x01,        /**< wait for the finger down */
+    AS608_ENROLL_STATE_GEN_FEATURE = 0x02,        /**< generate the sample feature */
+    AS608_ENROLL_STATE_WAIT_LIFT   = 0x03,        /**< wait for the finger up */
+    AS608_ENROLL_STATE_MATCH       = 0x04,        /**< match the two samples */
+    AS608_ENROLL_STATE_COMBINE     = 0x05,        /**< combine the two samples */
+    AS608_ENROLL_STATE_GET_PAGE    = 0x06,        /**< get the page number */
+    AS608_ENROLL_STATE_STORE       = 0x07,        /**< store the template */
+    AS608_ENROLL_STATE_DONE        = 0x08,        /**< done */
+    AS608_ENROLL_STATE_FAILED      = 0x09,        /**< failed */
+} as608_enroll_state_t;
+
+/**
+ * @brief as608 enroll event enumeration definition
+ */
+typedef enum
+{
+    AS608_ENROLL_EVENT_FINGER_DOWN = 0x00,        /**< the sample image is taken */
+    AS608_ENROLL_EVENT_FEATURE     = 0x01,        /**< the sample feature is generated */
+    AS608_ENROLL_EVENT_FINGER_UP   = 0x02,        /**< the finger is lifted */
+    AS608_ENROLL_EVENT_QUALITY     = 0x03,        /**< the feature is poor, the sample is taken again after the lift */
+    AS608_ENROLL_EVENT_TIMEOUT     = 0x04,        /**< no finger in time */
+    AS608_ENROLL_EVENT_STORED      = 0x05,        /**< the template is stored */
+    AS608_ENROLL_EVENT_ERROR       = 0x06,        /**< the enrollment failed */
+    AS608_ENROLL_EVENT_RETRY       = 0x07,        /**< the image is too dry, too wet or too clutter and is taken again */
+} as608_enroll_event_t;
+
+/**
+ * @brief as608 enroll callback definition
+ * @note  sample is 1 or 2 and status is the last status of the chip
+ */
+typedef void (*as608_enroll_callback_t)(void *arg, as608_enroll_event_t event, uint8_t sample, as608_status_t status);
+
+/**
+ * @brief as608 enroll structure definition
+ */
+typedef struct as608_enroll_s
+{
+    uint32_t addr;                            /**< chip address */
+    as608_enroll_state_t state;               /**< state */
+    uint8_t sample;                           /**< sample number */
+    uint8_t busy;                             /**< command in flight flag */
+    uint8_t res;                              /**< command result */
+    as608_status_t status;                    /**< last status */
+    uint16_t value;                           /**< last response value */
+    uint32_t min_gap_ms;                      /**< first idle gap in ms */
+    uint32_t max_gap_ms;                      /**< max idle gap in ms */
+    uint32_t timeout_ms;                      /**< finger wait timeout in ms */
+    uint32_t gap_ms;                          /**< current idle gap in ms */
+    uint32_t wait_start;                      /**< finger wait start timestamp */
+    uint32_t next_ms;                         /**< next get image timestamp */
+    uint16_t score;                           /**< match score */
+    uint16_t page_number;                     /**< stored page number */
+    uint8_t retake;                           /**< the lift is waited to take the sample again */
+    uint8_t errors;                           /**< transport errors in a row */
+    as608_capture_wait_t wait;                /**< wait function, NULL never waits */
+    as608_enroll_callback_t callback;         /**< progress callback */
+    void *arg;                                /**< callback argument */
+} as608_enroll_t;
+
+/**
+ * @brief as608 verify mode enumeration definition
+ */
+typedef enum
+{
+    AS608_VERIFY_MODE_SEARCH            = 0x00,        /**< search */
+    AS608_VERIFY_MODE_HIGH_SPEED_SEARCH = 0x01,        /**< high speed search */
+} as608_verify_mode_t;
+
+/**
+ * @brief as608 verify state enumeration definition
+ */
+typedef enum
+{
+    AS608_VERIFY_STATE_IDLE    = 0x00,        /**< idle */
+    AS608_VERIFY_STATE_IMAGE   = 0x01,        /**< get the image */
+    AS608_VERIFY_STATE_FEATURE = 0x02,        /**< generate the feature */
+    AS608_VERIFY_STATE_SEARCH  = 0x03,        /**< search the library */
+    AS608_VERIFY_STATE_DONE    = 0x04,        /**< done */
+    AS608_VERIFY_STATE_FAILED  = 0x05,        /**< failed */
+} as608_verify_state_t;
+
+/**
+ * @brief as608 verify timing structure definition
+ */
+typedef struct as608_verify_timing_s
+{
+    uint32_t wait_ms;           /**< time before the last get image */
+    uint32_t image_ms;          /**< last get image time */
+    uint32_t feature_ms;        /**< generate feature time */
+    uint32_t search_ms;         /**< search time, with the confirming full search */
+    uint32_t total_ms;          /**< time from the start to the end */
+    uint32_t polls;             /**< get image times */
+} as608_verify_timing_t;
+
+/**
+ * @brief as608 verify structure definition
+ */
+typedef struct as608_verify_s
+{
+    uint32_t addr;                            /**< chip address */
+    as608_verify_state_t state;               /**< state */
+    as608_verify_state_t phase;               /**< last phase before the end */
+    as608_verify_mode_t mode;                 /**< search mode */
+    uint8_t confirm;                          /**< full search confirming a high speed miss flag */
+    as608_buffer_number_t num;                /**< buffer number */
+    uint16_t start_page;                      /**< search start page */
+    uint16_t page_number;                     /**< search page number */
+    uint8_t busy;                             /**< command in flight flag */
+    uint8_t res;                              /**< command result */
+    as608_status_t status;                    /**< last status */
+    uint8_t payload[4];                       /**< last response payload */
+    uint32_t min_gap_ms;                      /**< first idle gap in ms */
+    uint32_t max_gap_ms;                      /**< max idle gap in ms */
+    uint32_t timeout_ms;                      /**< finger wait timeout in ms */
+    uint32_t gap_ms;                          /**< current idle gap in ms */
+    uint32_t start;                           /**< start timestamp */
+    uint32_t next_ms;                         /**< next get image timestamp */
+    uint32_t submit;                          /**< command submit timestamp */
+    uint16_t found_page;                      /**< found page */
+    uint16_t score;                           /**< score */
+    as608_verify_timing_t timing;             /**< phase timing */
+} as608_verify_t;
+
+/**
+ * @brief as608 identify path enumeration definition
+ */
+typedef enum
+{
+    AS608_IDENTIFY_PATH_IDENTIFY          = 0x00,        /**< identify command */
+    AS608_IDENTIFY_PATH_SEARCH            = 0x01,        /**< get image, generate feature and search */
+    AS608_IDENTIFY_PATH_HIGH_SPEED_SEARCH = 0x02,        /**< get image, generate feature and high speed search */
+} as608_identify_path_t;
+
+/**
+ * @brief as608 best identify structure definition
+ */
+typedef struct as608_best_identify_s
+{
+    uint32_t ewma_ms[3];                      /**< latency ewma of each path */
+    uint32_t count[3];                        /**< latency sample count of each path */
+    uint32_t last_used[3];                    /**< last request of each path */
+    uint32_t requests;                        /**< request count */
+    as608_identify_path_t path;               /**< last path */
+    uint32_t latency_ms;                      /**< last latency in ms */
+} as608_best_identify_t;
+
+/**
+ * @brief as608 io vector structure definition
+ */
+typedef struct as608_iovec_s
+{
+    uint8_t *buf;        /**< point to a data buffer */
+    uint16_t len;        /**< data length */
+} as608_iovec_t;
+
+/**
+ * @brief as608 transport structure definition
+ * @note  uart_writev is optional, it sends the buffers in order as one write and
+ *        the buffers are only valid in the call, without it the frame is copied to one buffer,
+ *        uart_drain is optional, it returns when all the written bytes are on the wire
+ */
+typedef struct as608_transport_s
+{
+    uint8_t (*uart_init)(void *ctx);                                    /**< point to a uart_init function address */
+    uint8_t (*uart_deinit)(void *ctx);                                  /**< point to a uart_deinit function address */
+    uint16_t (*uart_read)(void *ctx, uint8_t *buf, uint16_t len);       /**< point to a uart_read function address */
+    uint8_t (*uart_flush)(void *ctx);                                   /**< point to a uart_flush function address */
+    uint8_t (*uart_write)(void *ctx, uint8_t *buf, uint16_t len);       /**< point to a uart_write function address */
+    void (*delay_ms)(void *ctx, uint32_t ms);                           /**< point to a delay_ms function address */
+    uint32_t (*timestamp_ms)(void *ctx);                                /**< point to a timestamp_ms function address */
+    uint8_t (*uart_set_baud_rate)(void *ctx, uint32_t baud_rate);      /**< point to a uart_set_baud_rate function address */
+    uint8_t (*uart_writev)(void *ctx, as608_iovec_t *iov, uint8_t count);    /**< point to a uart_writev function address */
+    uint8_t (*uart_drain)(void *ctx);                                   /**< point to a uart_drain function address */
+} as608_transport_t;
+
+/**
+ * @brief as608 async callback definition
+ * @note  res is 0 success, 1 timeout, 2 cancelled, 3 sum check error, 4 len is invalid, 5 addr is invalid, 6 type is invalid,
+ *        payload points to the response data after the status byte and is only valid in the callback
+ */
+typedef void (*as608_async_callback_t)(void *arg, uint8_t res, uint8_t command, as608_status_t status, 
+                                       uint8_t *payload, uint16_t len);
+
+/**
+ * @brief as608 sink definition
+ * @note  buf holds one data packet and is only valid in the call, return 0 to continue or other values to stop
+ */
+typedef uint8_t (*as608_sink_t)(void *arg, uint8_t *buf, uint16_t len);
+
 /**
  * @brief as608 handle structure definition
  */
@@ -217,11 +532,44 @@ typedef struct as608_handle_s
     uint8_t (*uart_flush)(void);                              /**< point to a uart_flush function address */
     uint8_t (*uart_write)(uint8_t *buf, uint16_t len);        /**< point to a uart_write function address */
     void (*delay_ms)(uint32_t ms);                            /**< point to a delay_ms function address */
+    uint32_t (*timestamp_ms)(void);                           /**< point to a timestamp_ms function address */
+    uint8_t (*uart_set_baud_rate)(uint32_t baud_rate);        /**< point to a uart_set_baud_rate function address */
+    uint8_t (*uart_drain)(void);                              /**< point to a uart_drain function address */
     void (*debug_print)(const char *const fmt, ...);          /**< point to a debug_print function address */
+    const as608_transport_t *transport;                       /**< point to a transport */
+    void *ctx;                                                /**< transport context */
     uint8_t inited;                                           /**< inited flag */
     uint8_t buf[384];                                         /**< frame buf */
+    uint8_t rx_buf[384];                                      /**< receive buf */
+    uint16_t rx_tail;                                         /**< receive buf tail */
+    uint16_t rx_len;                                          /**< receive buf length */
+    as608_parser_t parser;                                    /**< frame parser */
     uint8_t status;                                           /**< status */
     uint16_t packet_size;                                     /**< packet size */
+    uint16_t n_9600;                                          /**< n times of 9600 */
+    uint8_t stream_pacing;                                    /**< stream pacing flag */
+    uint16_t stream_margin_ms;                                /**< stream margin in ms */
+    uint8_t async_busy;                                       /**< async busy flag */
+    uint8_t async_command;                                    /**< async command */
+    uint32_t async_addr;                                      /**< async chip address */
+    uint32_t async_start;                                     /**< async start timestamp */
+    uint32_t async_timeout_ms;                                /**< async timeout in ms */
+    as608_async_callback_t async_callback;                    /**< async completion callback */
+    void *async_arg;                                          /**< async callback argument */
+    as608_bulk_profile_t bulk_profile;                        /**< bulk profile */
+    uint8_t bulk_active;                                      /**< bulk session flag */
+    uint8_t bulk_n_9600;                                      /**< n times of 9600 before the bulk session */
+    as608_packet_size_t bulk_packet_size;                     /**< packet size before the bulk session */
+    as608_stats_t *stats;                                     /**< point to a stats block */
+    uint8_t stats_command;                                    /**< command of the stats */
+    uint8_t stats_pending;                                    /**< waiting for the response flag */
+    uint32_t stats_addr;                                      /**< chip address of the command */
+    uint32_t stats_start;                                     /**< start timestamp of the command */
+    uint32_t stats_dropped;                                   /**< counted parser dropped bytes */
+    uint32_t stats_invalid;                                   /**< counted parser invalid headers */
+    as608_trace_t trace;                                      /**< frame trace function */
+    void *trace_arg;                                          /**< trace argument */
+    uint8_t last_command;                                     /**< last sent command */
 } as608_handle_t;
 
 /**
@@ -295,7 +643,7 @@ typedef struct as608_info_s
  * @brief     link uart_flush function
  * @param[in] HANDLE pointer to an as608 handle structure
  * @param[in] FUC pointer to a uart_flush function address
- * @note      none
+ * @note      it drops the received bytes only, the pending output must be kept
  */
 #define DRIVER_AS608_LINK_UART_FLUSH(HANDLE, FUC)  (HANDLE)->uart_flush = FUC
 
@@ -307,6 +655,30 @@ typedef struct as608_info_s
  */
 #define DRIVER_AS608_LINK_DELAY_MS(HANDLE, FUC)    (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link timestamp_ms function
+ * @param[in] HANDLE pointer to an as608 handle structure
+ * @param[in] FUC pointer to a timestamp_ms function address
+ * @note      optional, a monotonic clock in ms used to measure the response timeout
+ */
+#define DRIVER_AS608_LINK_TIMESTAMP_MS(HANDLE, FUC) (HANDLE)->timestamp_ms = FUC
+
+/**
+ * @brief     link uart_set_baud_rate function
+ * @param[in] HANDLE pointer to an as608 handle structure
+ * @param[in] FUC pointer to a uart_set_baud_rate function address
+ * @note      optional, used by as608_switch_baud_rate to change the host uart rate
+ */
+#define DRIVER_AS608_LINK_UART_SET_BAUD_RATE(HANDLE, FUC) (HANDLE)->uart_set_baud_rate = FUC
+
+/**
+ * @brief     link uart_drain function
+ * @param[in] HANDLE pointer to an as608 handle structure
+ * @param[in] FUC pointer to a uart_drain function address
+ * @note      optional, it waits until the written bytes are sent to pace the data packets by the wire
+ */
+#define DRIVER_AS608_LINK_UART_DRAIN(HANDLE, FUC) (HANDLE)->uart_drain = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to an as608 handle structure
@@ -315,6 +687,16 @@ typedef struct as608_info_s
  */
 #define DRIVER_AS608_LINK_DEBUG_PRINT(HANDLE, FUC) (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link transport
+ * @param[in] HANDLE pointer to an as608 handle structure
+ * @param[in] TRANSPORT pointer to an as608 transport structure
+ * @param[in] CTX pointer to a transport context passed to every transport function
+ * @note      when the transport is linked, the uart and delay callbacks of the handle are not used
+ */
+#define DRIVER_AS608_LINK_TRANSPORT(HANDLE, TRANSPORT, CTX) \
+    do { (HANDLE)->transport = (TRANSPORT); (HANDLE)->ctx = (CTX); } while (0)
+
 /**
  * @}
  */
@@ -542,6 +924,28 @@ uint8_t as608_load_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_n
 uint8_t as608_upload_feature(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
                              uint8_t *output_buffer, uint16_t *output_len, as608_status_t *status);
 
+/**
+ * @brief      upload feature to a sink
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  num buffer num
+ * @param[in]  sink pointer to a sink function
+ * @param[in]  *arg pointer to a sink argument
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 upload feature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ *             - 7 sink stopped
+ * @note       every data packet is passed to the sink when it arrives
+ */
+uint8_t as608_upload_feature_to_sink(as608_handle_t *handle, uint32_t addr, as608_buffer_number_t num, 
+                                     as608_sink_t sink, void *arg, as608_status_t *status);
+
 /**
  * @brief      download feature
  * @param[in]  *handle pointer to an as608 handle structure
@@ -584,6 +988,27 @@ uint8_t as608_download_feature(as608_handle_t *handle, uint32_t addr, as608_buff
 uint8_t as608_upload_image(as608_handle_t *handle, uint32_t addr, uint8_t *output_buffer, 
                            uint16_t *output_len, as608_status_t *status);
 
+/**
+ * @brief      upload image to a sink
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  sink pointer to a sink function
+ * @param[in]  *arg pointer to a sink argument
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 upload image failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 decode failed
+ *             - 5 addr is invalid
+ *             - 6 len is invalid
+ *             - 7 sink stopped
+ * @note       every data packet is passed to the sink when it arrives, so no image sized buffer is needed
+ */
+uint8_t as608_upload_image_to_sink(as608_handle_t *handle, uint32_t addr, as608_sink_t sink, 
+                                   void *arg, as608_status_t *status);
+
 /**
  * @brief      download image
  * @param[in]  *handle pointer to an as608 handle structure
@@ -658,6 +1083,34 @@ uint8_t as608_empty_all_feature(as608_handle_t *handle, uint32_t addr, as608_sta
  */
 uint8_t as608_set_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_9600, as608_status_t *status);
 
+/**
+ * @brief      switch the baud rate of the chip and the host uart together
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  n_9600 n times of 9600
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 set baud rate failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 n_9600 is invalid
+ *             - 5 uart_set_baud_rate is null
+ *             - 6 handshake failed and the old rate is restored
+ *             - 7 handshake failed and the old rate can't be restored
+ * @note       1 <= n_9600 <= 12,
+ *             the chip is read back at the new rate and on failure both sides fall back to the old rate,
+ *             the chip is asked back to the old rate at the new rate only after the host has changed,
+ *             then the old rate is checked by a handshake,
+ *             0 means both sides run at the new rate or the chip refused it and status tells which,
+ *             1 means the command failed and the chip rate is unknown,
+ *             6 means both sides run at the old rate and the handshake passed,
+ *             7 means the host can't be set to the new rate while the chip runs there,
+ *             or the chip doesn't answer at the old rate,
+ *             the handle rate is the old rate on every failure
+ */
+uint8_t as608_switch_baud_rate(as608_handle_t *handle, uint32_t addr, uint8_t n_9600, as608_status_t *status);
+
 /**
  * @brief      set level
  * @param[in]  *handle pointer to an as608 handle structure
@@ -1028,6 +1481,577 @@ uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num
  * @}
  */
 
+/**
+ * @defgroup as608_async_driver as608 async driver function
+ * @brief    as608 async driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     submit a command without waiting for the response
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] addr chip address
+ * @param[in] *input_buffer pointer to a command buffer, the first byte is the command code
+ * @param[in] input_len command buffer length
+ * @param[in] timeout_ms response timeout in ms
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a command is in flight
+ *            - 5 timestamp_ms is null
+ *            - 6 len is invalid
+ * @note      only the commands answered by a single response frame are supported,
+ *            the blocking functions must not be called while a command is in flight
+ */
+uint8_t as608_async_submit(as608_handle_t *handle, uint32_t addr, uint8_t *input_buffer, uint16_t input_len,
+                           uint32_t timeout_ms, as608_async_callback_t callback, void *arg);
+
+/**
+ * @brief      poll the command in flight
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *busy pointer to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the function never waits, it parses the bytes which are available now and
+ *             runs the completion callback when the response is received or the command times out
+ */
+uint8_t as608_async_poll(as608_handle_t *handle, as608_bool_t *busy);
+
+/**
+ * @brief     cancel the command in flight
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the completion callback runs with res 2, a late response is dropped by the next command
+ */
+uint8_t as608_async_cancel(as608_handle_t *handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_stream_driver as608 stream driver function
+ * @brief    as608 stream driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     enable or disable the stream pacing
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when the pacing is enabled and uart_drain is linked, the next data packet is sent once the last one is on the wire,
+ *            when the pacing is disabled, the data packets are sent every 100ms
+ */
+uint8_t as608_set_stream_pacing(as608_handle_t *handle, as608_bool_t enable);
+
+/**
+ * @brief      get the stream pacing status
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_stream_pacing(as608_handle_t *handle, as608_bool_t *enable);
+
+/**
+ * @brief     set the stream margin
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] ms margin in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the margin is added to the wire time of each data packet when uart_drain is not linked, default is 5ms
+ */
+uint8_t as608_set_stream_margin(as608_handle_t *handle, uint16_t ms);
+
+/**
+ * @brief      get the stream margin
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *ms pointer to a margin buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_stream_margin(as608_handle_t *handle, uint16_t *ms);
+
+/**
+ * @brief      get the stream gap of a full data packet
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *ms pointer to a gap buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the gap is computed from n_9600 and packet_size
+ */
+uint8_t as608_get_stream_gap(as608_handle_t *handle, uint16_t *ms);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_bulk_driver as608 bulk driver function
+ * @brief    as608 bulk driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief      begin a bulk transfer session
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bulk begin failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 a command is in flight or a bulk session is active
+ * @note       the chip is switched to 256 bytes packets and the highest stable baud rate,
+ *             the rate is probed on the host side only and the chip baud register is written once for it,
+ *             the working settings are saved in the bulk profile and later sessions skip probing,
+ *             the baud rate is kept when uart_set_baud_rate is not linked,
+ *             if the begin fails the settings before the session are restored and no session is open
+ */
+uint8_t as608_bulk_begin(as608_handle_t *handle, uint32_t addr, as608_status_t *status);
+
+/**
+ * @brief      end a bulk transfer session
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bulk end failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 a command is in flight or the bulk session is not active
+ * @note       the packet size and the baud rate before the session are restored,
+ *             the session is closed even if a restore fails and the other setting is still restored,
+ *             so after a failure the chip may be left at the session baud rate or 256 bytes packets
+ */
+uint8_t as608_bulk_end(as608_handle_t *handle, uint32_t addr, as608_status_t *status);
+
+/**
+ * @brief      get the bulk profile
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *profile pointer to a bulk profile buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t as608_get_bulk_profile(as608_handle_t *handle, as608_bulk_profile_t *profile);
+
+/**
+ * @brief     set the bulk profile
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *profile pointer to a bulk profile buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 profile is invalid
+ * @note      used to restore a saved profile, so that the first session skips probing
+ */
+uint8_t as608_set_bulk_profile(as608_handle_t *handle, as608_bulk_profile_t *profile);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_parser_driver as608 parser driver function
+ * @brief    as608 parser driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the frame parser
+ * @param[in] *parser pointer to an as608 parser structure
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] size frame buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 parser is NULL
+ *            - 3 size is too small
+ * @note      size >= 12
+ */
+uint8_t as608_parser_init(as608_parser_t *parser, uint8_t *buf, uint16_t size);
+
+/**
+ * @brief      feed bytes to the frame parser
+ * @param[in]  *parser pointer to an as608 parser structure
+ * @param[in]  *data pointer to an input buffer
+ * @param[in]  len input length
+ * @param[out] *used pointer to a used length buffer
+ * @param[out] *frame_len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 a frame is received
+ *             - 1 need more data
+ *             - 2 parser is NULL
+ * @note       the parser stops after a whole frame, the frame is saved in the parser buffer and
+ *             the remain bytes (len - used) should be fed again,
+ *             the parser resyncs on 0xEF 0x01 and the frame checksum is not checked
+ */
+uint8_t as608_parser_feed(as608_parser_t *parser, uint8_t *data, uint16_t len, 
+                          uint16_t *used, uint16_t *frame_len);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_stats_driver as608 stats driver function
+ * @brief    as608 stats driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     set the stats block
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *stats pointer to a stats block or NULL to disable the stats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the block is cleared and can be set before as608_init,
+ *            the latency needs timestamp_ms, otherwise all responses are counted in bucket 0
+ */
+uint8_t as608_set_stats(as608_handle_t *handle, as608_stats_t *stats);
+
+/**
+ * @brief      get a snapshot of the stats
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[out] *stats pointer to a stats buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 stats is not set
+ * @note       none
+ */
+uint8_t as608_get_stats(as608_handle_t *handle, as608_stats_t *stats);
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle pointer to an as608 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 stats is not set
+ * @note      none
+ */
+uint8_t as608_reset_stats(as608_handle_t *handle);
+
+/**
+ * @brief      get a latency percentile of a command
+ * @param[in]  *stats pointer to a stats snapshot
+ * @param[in]  command command code
+ * @param[in]  percent percentile in 1 - 100
+ * @param[out] *ms pointer to a latency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ *             - 3 command or percent is invalid
+ *             - 4 no response is counted
+ * @note       ms is the upper bound of the histogram bucket, so p99 of 300ms responses gives 512ms
+ */
+uint8_t as608_stats_get_latency(as608_stats_t *stats, uint8_t command, uint8_t percent, uint32_t *ms);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_trace_driver as608 trace driver function
+ * @brief    as608 trace driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     set the frame trace
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] trace pointer to a trace function or NULL to disable the trace
+ * @param[in] *arg pointer to a trace argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the trace can be set before as608_init and should not block,
+ *            the timestamp needs timestamp_ms, otherwise it is 0
+ */
+uint8_t as608_set_trace(as608_handle_t *handle, as608_trace_t trace, void *arg);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_capture_driver as608 capture driver function
+ * @brief    as608 capture driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief      initialize a capture config with the default values
+ * @param[out] *config pointer to a capture config structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 config is NULL
+ * @note       10ms min gap, 500ms max gap, 10s timeout and no wait function
+ */
+uint8_t as608_capture_config_init(as608_capture_config_t *config);
+
+/**
+ * @brief      capture one fingerprint image
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  addr chip address
+ * @param[in]  *config pointer to a capture config structure
+ * @param[out] *result pointer to a capture result buffer, it can be NULL
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get image failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timeout
+ *             - 5 config is invalid
+ * @note       no fingerprint keeps polling, the first poll runs at once and the gap starts at min_gap_ms
+ *             and doubles up to max_gap_ms, a too dry, too wet or too clutter image is retried at once,
+ *             an ok image or any other status ends the capture and the status is returned to the caller
+ */
+uint8_t as608_capture_image(as608_handle_t *handle, uint32_t addr, as608_capture_config_t *config, 
+                            as608_capture_result_t *result, as608_status_t *status);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_enroll_driver as608 enroll driver function
+ * @brief    as608 enroll driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     start an enrollment
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *enroll pointer to an enroll structure
+ * @param[in] addr chip address
+ * @param[in] *config pointer to a capture config structure
+ * @param[in] *callback pointer to a progress callback, it can be NULL
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a command is in flight
+ *            - 5 timestamp_ms is null
+ *            - 6 config is invalid
+ * @note      the gaps, the finger wait timeout and the wait function come from the config,
+ *            a transport error is retried up to 3 times in a row before the enrollment fails
+ */
+uint8_t as608_enroll_start(as608_handle_t *handle, as608_enroll_t *enroll, uint32_t addr, 
+                           as608_capture_config_t *config, as608_enroll_callback_t callback, void *arg);
+
+/**
+ * @brief      run one enrollment step
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *enroll pointer to an enroll structure
+ * @param[out] *done pointer to a done flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 step failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 enroll is NULL
+ * @note       the function polls the command in flight and submits the next one,
+ *             it never waits without a wait function, otherwise it waits for the next get image in it
+ *             and a wake polls at once,
+ *             done is true when the state is done or failed and the callback has run,
+ *             the blocking functions must not be called before the enrollment is done
+ */
+uint8_t as608_enroll_step(as608_handle_t *handle, as608_enroll_t *enroll, as608_bool_t *done);
+
+/**
+ * @brief     cancel an enrollment
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *enroll pointer to an enroll structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 enroll is NULL
+ * @note      the command in flight is cancelled and the state goes back to idle without a callback
+ */
+uint8_t as608_enroll_cancel(as608_handle_t *handle, as608_enroll_t *enroll);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_verify_driver as608 verify driver function
+ * @brief    as608 verify driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief     start a verification
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @param[in] addr chip address
+ * @param[in] mode search mode
+ * @param[in] num buffer number
+ * @param[in] start_page search start page
+ * @param[in] page_number search page number
+ * @param[in] *config pointer to a capture config structure, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 a command is in flight
+ *            - 5 timestamp_ms is null
+ *            - 6 config is invalid
+ * @note      with a config the finger is waited for as the capture does,
+ *            without a config the image is taken once,
+ *            a not found of the high speed search is confirmed by a full search
+ */
+uint8_t as608_verify_start(as608_handle_t *handle, as608_verify_t *verify, uint32_t addr, as608_verify_mode_t mode, 
+                           as608_buffer_number_t num, uint16_t start_page, uint16_t page_number, 
+                           as608_capture_config_t *config);
+
+/**
+ * @brief      run one verification step
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *verify pointer to a verify structure
+ * @param[out] *done pointer to a done flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 step failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 verify is NULL
+ * @note       the function never waits, the host can do its own work between the steps while the chip
+ *             processes the command in flight, when done the status is the status of the last command,
+ *             found_page and score are valid if the status is ok, the phase timing is kept in timing
+ */
+uint8_t as608_verify_step(as608_handle_t *handle, as608_verify_t *verify, as608_bool_t *done);
+
+/**
+ * @brief     cancel a verification
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 verify is NULL
+ * @note      the command in flight is cancelled and the state goes back to idle
+ */
+uint8_t as608_verify_cancel(as608_handle_t *handle, as608_verify_t *verify);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup as608_best_driver as608 best identify driver function
+ * @brief    as608 best identify driver modules
+ * @ingroup  as608_driver
+ * @{
+ */
+
+/**
+ * @brief      initialize the best identify statistics
+ * @param[out] *best pointer to a best identify structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 best is NULL
+ * @note       all paths start unknown and each one is tried once before the ewma is used
+ */
+uint8_t as608_best_identify_init(as608_best_identify_t *best);
+
+/**
+ * @brief     benchmark the identify paths on the connected chip
+ * @param[in] *handle pointer to an as608 handle structure
+ * @param[in] *best pointer to a best identify structure
+ * @param[in] addr chip address
+ * @param[in] start_page search start page
+ * @param[in] page_number search page number
+ * @param[in] rounds rounds of each path
+ * @return    status code
+ *            - 0 success
+ *            - 1 calibrate failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no valid sample
+ *            - 5 timestamp_ms is null
+ *            - 6 best is NULL
+ * @note      a finger must stay on the sensor, a round counts only when the chip answers ok or not found,
+ *            the identify path is skipped if start_page is not 0
+ */
+uint8_t as608_best_identify_calibrate(as608_handle_t *handle, as608_best_identify_t *best, uint32_t addr, 
+                                      uint16_t start_page, uint16_t page_number, uint8_t rounds);
+
+/**
+ * @brief      identify through the lowest latency path
+ * @param[in]  *handle pointer to an as608 handle structure
+ * @param[in]  *best pointer to a best identify structure
+ * @param[in]  addr chip address
+ * @param[in]  start_page search start page
+ * @param[in]  page_number search page number
+ * @param[out] *found_page pointer to a found page buffer
+ * @param[out] *score pointer to a score buffer
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 identify failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 timestamp_ms is null
+ *             - 6 best is NULL
+ * @note       every path matches against the level set in the chip, so the score threshold is the same,
+ *             the high speed search only finds good samples, so its not found is confirmed by a full search,
+ *             the identify command always scans the whole library and is only used if start_page is 0,
+ *             each ok or not found answer updates the ewma of its path and every 32 requests the least
+ *             recently used path is tried to follow the chip as the library grows
+ */
+uint8_t as608_best_identify(as608_handle_t *handle, as608_best_identify_t *best, uint32_t addr, 
+                            uint16_t start_page, uint16_t page_number, 
+                            uint16_t *found_page, uint16_t *score, as608_status_t *status);
+
+/**
+ * @}
+ */
+
 /**
  * @defgroup as608_extern_driver as608 extern driver function
  * @brief    as608 extern driver modules
@@ -1042,7 +2066,7 @@ uint8_t as608_get_index_table(as608_handle_t *handle, uint32_t addr, uint8_t num
  * @param[in]     type frame type
  * @param[in]     *input_buffer pointer to an input buffer
  * @param[in]     input_len input length
- * @param[in]     ms delay in ms
+ * @param[in]     ms timeout in ms
  * @param[out]    *output_buffer pointer to an output buffer
  * @param[in,out] *output_len pointer to an output length buffer
  * @return        status code
@@ -0,0 +1,1459 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_as608_emulator_test.c
+ * @brief     driver as608 emulator test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-09-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/09/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_as608_emulator_test.h"
+#include "as608_emulator.h"
+#include <string.h>
+
+/**
+ * @brief emulator test command definition
+ */
+#define EMULATOR_TEST_COMMAND_GET_IMAGE            0x01        /**< get image command */
+#define EMULATOR_TEST_COMMAND_GEN_CHAR             0x02        /**< generate char command */
+#define EMULATOR_TEST_COMMAND_SEARCH               0x04        /**< search command */
+#define EMULATOR_TEST_COMMAND_WRITE_REG            0x0E        /**< write reg command */
+#define EMULATOR_TEST_COMMAND_IDENTIFY             0x11        /**< identify command */
+#define EMULATOR_TEST_COMMAND_HIGH_SPEED_SEARCH    0x1B        /**< high speed search command */
+
+/**
+ * @brief emulator test parameter definition
+ */
+#define EMULATOR_TEST_ADDR        0xFFFFFFFFU        /**< chip address */
+#define EMULATOR_TEST_FINGER      7                  /**< enrolled finger id */
+#define EMULATOR_TEST_STEP_MAX    100000             /**< max steps of a state machine */
+
+/**
+ * @brief emulator test fault enumeration definition
+ */
+typedef enum
+{
+    EMULATOR_TEST_FAULT_NONE     = 0x00,        /**< no fault */
+    EMULATOR_TEST_FAULT_DROP     = 0x01,        /**< one byte of the response is dropped */
+    EMULATOR_TEST_FAULT_FLIP     = 0x02,        /**< one bit of the status is flipped */
+    EMULATOR_TEST_FAULT_STALL    = 0x03,        /**< the response never comes */
+    EMULATOR_TEST_FAULT_REORDER  = 0x04,        /**< the two halves of the response are swapped */
+    EMULATOR_TEST_FAULT_GARBAGE  = 0x05,        /**< noise comes before the response */
+    EMULATOR_TEST_FAULT_COALESCE = 0x06,        /**< a second copy of the response comes with it */
+    EMULATOR_TEST_FAULT_LATENCY  = 0x07,        /**< the response comes value ms later */
+    EMULATOR_TEST_FAULT_STATUS   = 0x08,        /**< the response status is replaced by value */
+} emulator_test_fault_t;
+
+static as608_handle_t gs_handle;                                /**< as608 handle */
+static as608_emulator_t gs_emu;                                 /**< as608 emulator */
+static as608_stats_t gs_stats;                                  /**< as608 stats */
+static uint8_t gs_wire[AS608_EMULATOR_OUTPUT_SIZE];             /**< bytes on the wire to the host */
+static uint32_t gs_wire_head;                                   /**< wire head */
+static uint32_t gs_wire_tail;                                   /**< wire tail */
+static uint32_t gs_wire_ready;                                  /**< timestamp the wire bytes arrive */
+static uint8_t gs_buffer[AS608_EMULATOR_IMAGE_SIZE];            /**< test buffer */
+static uint8_t gs_buffer_check[AS608_EMULATOR_IMAGE_SIZE];      /**< test check buffer */
+static uint32_t gs_now;                                         /**< simulated clock */
+static uint8_t gs_host_n_9600;                                  /**< host rate */
+static uint8_t gs_host_max_n_9600;                              /**< max host rate */
+static uint8_t gs_split;                                        /**< one byte reads flag */
+static uint16_t gs_read_max;                                    /**< max read length */
+static uint32_t gs_sent[256];                                   /**< sent commands */
+static emulator_test_fault_t gs_fault;                          /**< armed fault */
+static uint8_t gs_fault_command;                                /**< faulted command */
+static uint32_t gs_fault_value;                                 /**< fault value */
+static uint8_t gs_fault_count;                                  /**< faulted responses */
+static uint8_t gs_async_done;                                   /**< async done flag */
+static uint8_t gs_async_res;                                    /**< async result */
+static as608_status_t gs_async_status;                          /**< async status */
+static uint8_t gs_event[64];                                    /**< enroll events */
+static uint8_t gs_event_sample[64];                             /**< enroll event samples */
+static uint8_t gs_event_len;                                    /**< enroll event length */
+
+/**
+ * @brief  emulator test uart init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_emulator_test_uart_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  emulator test uart deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_emulator_test_uart_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     emulator test move the chip output to the wire
+ * @param[in] command command code of the written frame, 0 for a data packet
+ * @param[in] delay_ms chip latency in ms
+ * @note      the armed fault is applied to the response frame of the faulted command
+ */
+static void a_emulator_test_pump(uint8_t command, uint32_t delay_ms)
+{
+    uint8_t *p;
+    uint8_t half[192];
+    uint32_t n;
+    uint32_t l;
+    uint32_t i;
+    uint16_t sum;
+    
+    /* take the output and keep room for the fault */
+    p = &gs_wire[gs_wire_tail];
+    n = as608_emulator_output(&gs_emu, p, AS608_EMULATOR_OUTPUT_SIZE - gs_wire_tail - 384);
+    if (n == 0)
+    {
+        return;
+    }
+    gs_wire_ready = gs_now + delay_ms;
+    
+    /* apply the fault */
+    if ((gs_fault != EMULATOR_TEST_FAULT_NONE) && (command != 0) && (command == gs_fault_command) && (n >= 12))
+    {
+        l = 9 + (((uint32_t)p[7] << 8) | p[8]);
+        l = (l > n) ? n : l;
+        l = (l > 384) ? 384 : l;
+        switch (gs_fault)
+        {
+            case EMULATOR_TEST_FAULT_DROP :
+            {
+                memmove(&p[5], &p[6], n - 6);
+                n--;
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_FLIP :
+            {
+                p[9] ^= 0x01;
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_STALL :
+            {
+                n = 0;
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_REORDER :
+            {
+                memcpy(half, p, l / 2);
+                memmove(p, &p[l / 2], l - l / 2);
+                memcpy(&p[l - l / 2], half, l / 2);
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_GARBAGE :
+            {
+                memmove(&p[3], p, n);
+                p[0] = 0x55;
+                p[1] = 0xEF;
+                p[2] = 0x00;
+                n += 3;
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_COALESCE :
+            {
+                memmove(&p[2 * l], &p[l], n - l);
+                memcpy(&p[l], p, l);
+                n += l;
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_LATENCY :
+            {
+                gs_wire_ready += gs_fault_value;
+                
+                break;
+            }
+            case EMULATOR_TEST_FAULT_STATUS :
+            {
+                p[9] = (uint8_t)gs_fault_value;
+                sum = 0;
+                for (i = 6; i < (l - 2); i++)
+                {
+                    sum += p[i];
+                }
+                p[l - 2] = (sum >> 8) & 0xFF;
+                p[l - 1] = (sum >> 0) & 0xFF;
+                
+                break;
+            }
+            default :
+            {
+                break;
+            }
+        }
+        gs_fault_count--;
+        if (gs_fault_count == 0)
+        {
+            gs_fault = EMULATOR_TEST_FAULT_NONE;
+        }
+    }
+    gs_wire_tail += n;
+}
+
+/**
+ * @brief      emulator test uart read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     read length
+ * @note       nothing is read before the chip latency has passed
+ */
+static uint16_t a_emulator_test_uart_read(uint8_t *buf, uint16_t len)
+{
+    uint32_t n;
+    
+    /* save the max asked length */
+    gs_read_max = (len > gs_read_max) ? len : gs_read_max;
+    
+    /* the chip is still working */
+    if ((int32_t)(gs_now - gs_wire_ready) < 0)
+    {
+        return 0;
+    }
+    n = gs_wire_tail - gs_wire_head;
+    n = (n > len) ? len : n;
+    n = ((gs_split != 0) && (n > 1)) ? 1 : n;
+    memcpy(buf, &gs_wire[gs_wire_head], n);
+    gs_wire_head += n;
+    
+    return (uint16_t)n;
+}
+
+/**
+ * @brief  emulator test uart flush
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_emulator_test_uart_flush(void)
+{
+    uint8_t buf[64];
+    
+    /* drop the output and the wire */
+    while (as608_emulator_output(&gs_emu, buf, 64) != 0)
+    {
+    }
+    gs_wire_head = 0;
+    gs_wire_tail = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator test uart write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the chip does not decode the bytes sent at another baud rate
+ */
+static uint8_t a_emulator_test_uart_write(uint8_t *buf, uint16_t len)
+{
+    uint8_t command;
+    uint32_t delay_ms;
+    
+    /* the bytes take time on the wire */
+    gs_now += 1;
+    if (gs_host_n_9600 != gs_emu.n_9600)
+    {
+        return 0;
+    }
+    
+    /* count the command */
+    command = 0;
+    if ((len > 9) && (buf[6] == 0x01))
+    {
+        command = buf[9];
+        gs_sent[command]++;
+    }
+    if (gs_wire_head == gs_wire_tail)
+    {
+        gs_wire_head = 0;
+        gs_wire_tail = 0;
+    }
+    
+    /* run the chip */
+    if (as608_emulator_input(&gs_emu, buf, len, &delay_ms) != 0)
+    {
+        return 1;
+    }
+    a_emulator_test_pump(command, delay_ms);
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator test delay
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_emulator_test_delay_ms(uint32_t ms)
+{
+    gs_now += ms;
+}
+
+/**
+ * @brief  emulator test timestamp
+ * @return timestamp in ms
+ * @note   every call takes 1ms, so the loops without a delay move on
+ */
+static uint32_t a_emulator_test_timestamp_ms(void)
+{
+    gs_now += 1;
+    
+    return gs_now;
+}
+
+/**
+ * @brief     emulator test uart set the baud rate
+ * @param[in] baud_rate baud rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 the host can't set the rate
+ * @note      none
+ */
+static uint8_t a_emulator_test_uart_set_baud_rate(uint32_t baud_rate)
+{
+    if ((baud_rate / 9600) > gs_host_max_n_9600)
+    {
+        return 1;
+    }
+    gs_host_n_9600 = (uint8_t)(baud_rate / 9600);
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator test uart drain
+ * @return status code
+ *         - 0 success
+ * @note   the written bytes reach the chip in the write
+ */
+static uint8_t a_emulator_test_uart_drain(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     emulator test capture wait
+ * @param[in] ms wait time
+ * @return    status code
+ *            - 1 the whole time is waited
+ * @note      none
+ */
+static uint8_t a_emulator_test_wait(uint32_t ms)
+{
+    gs_now += ms;
+    
+    return 1;
+}
+
+/**
+ * @brief     emulator test arm a fault
+ * @param[in] fault fault type
+ * @param[in] command faulted command
+ * @param[in] value fault value
+ * @param[in] count faulted responses
+ * @note      none
+ */
+static void a_emulator_test_arm(emulator_test_fault_t fault, uint8_t command, uint32_t value, uint8_t count)
+{
+    gs_fault = fault;
+    gs_fault_command = command;
+    gs_fault_value = value;
+    gs_fault_count = count;
+}
+
+/**
+ * @brief     emulator test async callback
+ * @param[in] *arg pointer to a callback argument
+ * @param[in] res command result
+ * @param[in] command command code
+ * @param[in] status chip status
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @note      none
+ */
+static void a_emulator_test_async_callback(void *arg, uint8_t res, uint8_t command, as608_status_t status, 
+                                           uint8_t *payload, uint16_t len)
+{
+    (void)arg;
+    (void)command;
+    (void)payload;
+    (void)len;
+    
+    gs_async_done = 1;
+    gs_async_res = res;
+    gs_async_status = status;
+}
+
+/**
+ * @brief     emulator test enroll callback
+ * @param[in] *arg pointer to a callback argument
+ * @param[in] event enroll event
+ * @param[in] sample sample number
+ * @param[in] status chip status
+ * @note      the finger is lifted after the first feature or a poor feature and put back after the lift
+ */
+static void a_emulator_test_enroll_callback(void *arg, as608_enroll_event_t event, uint8_t sample, as608_status_t status)
+{
+    (void)arg;
+    (void)status;
+    
+    /* save the event */
+    if (gs_event_len < 64)
+    {
+        gs_event[gs_event_len] = (uint8_t)event;
+        gs_event_sample[gs_event_len] = sample;
+        gs_event_len++;
+    }
+    
+    /* move the finger */
+    if (((event == AS608_ENROLL_EVENT_FEATURE) && (sample == 1)) || (event == AS608_ENROLL_EVENT_QUALITY))
+    {
+        (void)as608_emulator_set_finger(&gs_emu, 0, 0);
+    }
+    else if (event == AS608_ENROLL_EVENT_FINGER_UP)
+    {
+        (void)as608_emulator_set_finger(&gs_emu, 1, EMULATOR_TEST_FINGER);
+    }
+}
+
+/**
+ * @brief     emulator test count an enroll event
+ * @param[in] event enroll event
+ * @return    event count
+ * @note      none
+ */
+static uint8_t a_emulator_test_event_count(as608_enroll_event_t event)
+{
+    uint8_t i;
+    uint8_t count;
+    
+    count = 0;
+    for (i = 0; i < gs_event_len; i++)
+    {
+        count += (gs_event[i] == (uint8_t)event) ? 1 : 0;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief      emulator test build a frame
+ * @param[in]  type frame type
+ * @param[in]  *payload pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *frame pointer to a frame buffer
+ * @return     frame length
+ * @note       none
+ */
+static uint16_t a_emulator_test_frame(uint8_t type, uint8_t *payload, uint16_t len, uint8_t *frame)
+{
+    uint16_t i;
+    uint16_t sum;
+    
+    frame[0] = 0xEF;
+    frame[1] = 0x01;
+    frame[2] = 0xFF;
+    frame[3] = 0xFF;
+    frame[4] = 0xFF;
+    frame[5] = 0xFF;
+    frame[6] = type;
+    frame[7] = ((len + 2) >> 8) & 0xFF;
+    frame[8] = ((len + 2) >> 0) & 0xFF;
+    memcpy(&frame[9], payload, len);
+    sum = 0;
+    for (i = 6; i < (9 + len); i++)
+    {
+        sum += frame[i];
+    }
+    frame[9 + len] = (sum >> 8) & 0xFF;
+    frame[10 + len] = (sum >> 0) & 0xFF;
+    
+    return len + 11;
+}
+
+/**
+ * @brief  emulator test the frame parser
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+static uint8_t a_emulator_test_parser(void)
+{
+    uint8_t res;
+    uint8_t buf[64];
+    uint8_t frame[32];
+    uint8_t stream[96];
+    uint8_t payload[3] = {0x00, 0x12, 0x34};
+    uint8_t noise[4] = {0x55, 0xEF, 0x00, 0xEF};
+    uint16_t i;
+    uint16_t l;
+    uint16_t used;
+    uint16_t frame_len;
+    uint16_t frames;
+    as608_parser_t parser;
+    
+    /* check the buffer size */
+    if (as608_parser_init(&parser, buf, 11) != 3)
+    {
+        as608_interface_debug_print("as608: parser accepts a small buffer.\n");
+        
+        return 1;
+    }
+    if (as608_parser_init(&parser, buf, sizeof(buf)) != 0)
+    {
+        as608_interface_debug_print("as608: parser init failed.\n");
+        
+        return 1;
+    }
+    l = a_emulator_test_frame(0x07, payload, 3, frame);
+    
+    /* resync on noise with one byte chunks */
+    memcpy(stream, noise, 4);
+    memcpy(&stream[4], frame, l);
+    frames = 0;
+    frame_len = 0;
+    for (i = 0; i < (l + 4); i++)
+    {
+        if (as608_parser_feed(&parser, &stream[i], 1, &used, &frame_len) == 0)
+        {
+            frames++;
+            if ((frame_len != l) || (memcmp(buf, frame, l) != 0))
+            {
+                as608_interface_debug_print("as608: parser frame is wrong.\n");
+                
+                return 1;
+            }
+        }
+    }
+    if ((frames != 1) || (parser.dropped != 4))
+    {
+        as608_interface_debug_print("as608: parser resync failed.\n");
+        
+        return 1;
+    }
+    
+    /* two coalesced frames in one chunk */
+    memcpy(stream, frame, l);
+    memcpy(&stream[l], frame, l);
+    res = as608_parser_feed(&parser, stream, l * 2, &used, &frame_len);
+    if ((res != 0) || (used != l) || (frame_len != l))
+    {
+        as608_interface_debug_print("as608: parser first coalesced frame failed.\n");
+        
+        return 1;
+    }
+    res = as608_parser_feed(&parser, &stream[used], l * 2 - used, &used, &frame_len);
+    if ((res != 0) || (used != l) || (frame_len != l))
+    {
+        as608_interface_debug_print("as608: parser second coalesced frame failed.\n");
+        
+        return 1;
+    }
+    
+    /* a header with an invalid length */
+    memcpy(stream, frame, 9);
+    stream[7] = 0x00;
+    stream[8] = 0x00;
+    memcpy(&stream[9], frame, l);
+    res = as608_parser_feed(&parser, stream, l + 9, &used, &frame_len);
+    if ((res != 0) || (used != (l + 9)) || (parser.invalid != 1) || (memcmp(buf, frame, l) != 0))
+    {
+        as608_interface_debug_print("as608: parser invalid length resync failed.\n");
+        
+        return 1;
+    }
+    
+    /* a split frame needs more data */
+    res = as608_parser_feed(&parser, frame, l - 1, &used, &frame_len);
+    if ((res != 1) || (used != (l - 1)))
+    {
+        as608_interface_debug_print("as608: parser split frame failed.\n");
+        
+        return 1;
+    }
+    res = as608_parser_feed(&parser, &frame[l - 1], 1, &used, &frame_len);
+    if ((res != 0) || (frame_len != l))
+    {
+        as608_interface_debug_print("as608: parser split frame failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator test the link faults
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a finger is on the sensor
+ */
+static uint8_t a_emulator_test_fault(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint32_t start;
+    as608_status_t status;
+    as608_params_t param;
+    as608_stats_t stats;
+    const emulator_test_fault_t fault[4] = {EMULATOR_TEST_FAULT_DROP, EMULATOR_TEST_FAULT_FLIP, 
+                                            EMULATOR_TEST_FAULT_STALL, EMULATOR_TEST_FAULT_REORDER};
+    
+    /* split reads */
+    as608_interface_debug_print("as608: split reads.\n");
+    gs_split = 1;
+    res = as608_get_params(&gs_handle, EMULATOR_TEST_ADDR, &param, &status);
+    gs_split = 0;
+    if ((res != 0) || (status != AS608_STATUS_OK) || (param.n_9600 != 6))
+    {
+        as608_interface_debug_print("as608: get params with split reads failed.\n");
+        
+        return 1;
+    }
+    
+    /* exact length reads leave the coalesced frame in the uart */
+    as608_interface_debug_print("as608: coalesced response.\n");
+    gs_read_max = 0;
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_COALESCE, EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+    res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (gs_read_max > 12) || ((gs_wire_tail - gs_wire_head) != 12))
+    {
+        as608_interface_debug_print("as608: get image reads over the response.\n");
+        
+        return 1;
+    }
+    res = as608_get_params(&gs_handle, EMULATOR_TEST_ADDR, &param, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: stale frame is not dropped.\n");
+        
+        return 1;
+    }
+    
+    /* noise before the response */
+    as608_interface_debug_print("as608: noise before the response.\n");
+    (void)as608_reset_stats(&gs_handle);
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_GARBAGE, EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+    res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    (void)as608_get_stats(&gs_handle, &stats);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (stats.error[AS608_STATS_ERROR_HEADER] != 3))
+    {
+        as608_interface_debug_print("as608: resync failed.\n");
+        
+        return 1;
+    }
+    
+    /* extra latency in the deadline */
+    as608_interface_debug_print("as608: extra latency.\n");
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_LATENCY, EMULATOR_TEST_COMMAND_GET_IMAGE, 300, 1);
+    start = gs_now;
+    res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || ((gs_now - start) < 300))
+    {
+        as608_interface_debug_print("as608: late response failed.\n");
+        
+        return 1;
+    }
+    
+    /* latency over the deadline */
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_LATENCY, EMULATOR_TEST_COMMAND_GET_IMAGE, 800, 1);
+    start = gs_now;
+    res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res == 0) || ((gs_now - start) < 500) || ((gs_now - start) > 800))
+    {
+        as608_interface_debug_print("as608: deadline is not kept.\n");
+        
+        return 1;
+    }
+    res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: recovery after the late response failed.\n");
+        
+        return 1;
+    }
+    
+    /* broken responses */
+    for (i = 0; i < 4; i++)
+    {
+        as608_interface_debug_print("as608: broken response %d.\n", i + 1);
+        (void)as608_reset_stats(&gs_handle);
+        a_emulator_test_arm(fault[i], EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+        start = gs_now;
+        res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+        if ((res != 4) || ((gs_now - start) > 800))
+        {
+            as608_interface_debug_print("as608: broken response is accepted.\n");
+            
+            return 1;
+        }
+        (void)as608_get_stats(&gs_handle, &stats);
+        if ((fault[i] == EMULATOR_TEST_FAULT_FLIP) && (stats.error[AS608_STATS_ERROR_SUM] != 1))
+        {
+            as608_interface_debug_print("as608: sum check error is not counted.\n");
+            
+            return 1;
+        }
+        if ((fault[i] == EMULATOR_TEST_FAULT_STALL) && (((gs_now - start) < 500) || 
+            (stats.error[AS608_STATS_ERROR_TIMEOUT] != 1)))
+        {
+            as608_interface_debug_print("as608: stalled response is not timed out.\n");
+            
+            return 1;
+        }
+        res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+        if ((res != 0) || (status != AS608_STATUS_OK))
+        {
+            as608_interface_debug_print("as608: recovery failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator test run one async get image
+ * @param[in] cancel cancel flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_emulator_test_async_run(uint8_t cancel)
+{
+    uint8_t buf[1];
+    uint32_t i;
+    as608_bool_t busy;
+    
+    /* submit */
+    gs_async_done = 0;
+    buf[0] = EMULATOR_TEST_COMMAND_GET_IMAGE;
+    if (as608_async_submit(&gs_handle, EMULATOR_TEST_ADDR, buf, 1, 500, 
+                           a_emulator_test_async_callback, NULL) != 0)
+    {
+        return 1;
+    }
+    if (as608_async_submit(&gs_handle, EMULATOR_TEST_ADDR, buf, 1, 500, 
+                           a_emulator_test_async_callback, NULL) != 4)
+    {
+        as608_interface_debug_print("as608: second submit is accepted.\n");
+        
+        return 1;
+    }
+    if (cancel != 0)
+    {
+        return as608_async_cancel(&gs_handle);
+    }
+    
+    /* poll */
+    for (i = 0; i < EMULATOR_TEST_STEP_MAX; i++)
+    {
+        if (as608_async_poll(&gs_handle, &busy) != 0)
+        {
+            return 1;
+        }
+        if (busy == AS608_BOOL_FALSE)
+        {
+            return 0;
+        }
+        gs_now += 1;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief  emulator test the async commands
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a finger is on the sensor
+ */
+static uint8_t a_emulator_test_async(void)
+{
+    uint8_t res;
+    uint32_t start;
+    as608_status_t status;
+    
+    /* submit and poll */
+    as608_interface_debug_print("as608: async submit and poll.\n");
+    res = a_emulator_test_async_run(0);
+    if ((res != 0) || (gs_async_done == 0) || (gs_async_res != 0) || (gs_async_status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: async get image failed.\n");
+        
+        return 1;
+    }
+    
+    /* split and coalesced frames */
+    gs_split = 1;
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_COALESCE, EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+    res = a_emulator_test_async_run(0);
+    gs_split = 0;
+    if ((res != 0) || (gs_async_res != 0) || (gs_async_status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: async split and coalesced frames failed.\n");
+        
+        return 1;
+    }
+    
+    /* sum check error */
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_FLIP, EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+    res = a_emulator_test_async_run(0);
+    if ((res != 0) || (gs_async_res != 3))
+    {
+        as608_interface_debug_print("as608: async sum check error is not reported.\n");
+        
+        return 1;
+    }
+    
+    /* stalled response */
+    as608_interface_debug_print("as608: async timeout.\n");
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_STALL, EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+    start = gs_now;
+    res = a_emulator_test_async_run(0);
+    if ((res != 0) || (gs_async_res != 1) || ((gs_now - start) < 500))
+    {
+        as608_interface_debug_print("as608: async timeout is not reported.\n");
+        
+        return 1;
+    }
+    
+    /* cancel */
+    as608_interface_debug_print("as608: async cancel.\n");
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_LATENCY, EMULATOR_TEST_COMMAND_GET_IMAGE, 100, 1);
+    res = a_emulator_test_async_run(1);
+    if ((res != 0) || (gs_async_done == 0) || (gs_async_res != 2) || (gs_handle.async_busy != 0))
+    {
+        as608_interface_debug_print("as608: async cancel failed.\n");
+        
+        return 1;
+    }
+    gs_now += 200;
+    res = as608_get_image(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: late response is not dropped.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      emulator test run one enrollment
+ * @param[in]  timeout_ms finger wait timeout
+ * @param[out] *enroll pointer to an enroll structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_emulator_test_enroll_run(uint32_t timeout_ms, as608_enroll_t *enroll)
+{
+    uint32_t i;
+    as608_bool_t done;
+    as608_capture_config_t config;
+    
+    /* start */
+    gs_event_len = 0;
+    (void)as608_capture_config_init(&config);
+    config.timeout_ms = timeout_ms;
+    config.wait = a_emulator_test_wait;
+    if (as608_enroll_start(&gs_handle, enroll, EMULATOR_TEST_ADDR, &config, 
+                           a_emulator_test_enroll_callback, NULL) != 0)
+    {
+        return 1;
+    }
+    
+    /* step */
+    for (i = 0; i < EMULATOR_TEST_STEP_MAX; i++)
+    {
+        if (as608_enroll_step(&gs_handle, enroll, &done) != 0)
+        {
+            return 1;
+        }
+        if (done == AS608_BOOL_TRUE)
+        {
+            return 0;
+        }
+        gs_now += 1;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief  emulator test the enroll state machine
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   two templates of the test finger are stored in page 0 and page 1
+ */
+static uint8_t a_emulator_test_enroll(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint32_t gen;
+    as608_enroll_t enroll;
+    
+    /* no finger */
+    as608_interface_debug_print("as608: enroll timeout.\n");
+    (void)as608_emulator_set_finger(&gs_emu, 0, 0);
+    res = a_emulator_test_enroll_run(2000, &enroll);
+    if ((res != 0) || (enroll.state != AS608_ENROLL_STATE_FAILED) || 
+        (a_emulator_test_event_count(AS608_ENROLL_EVENT_TIMEOUT) != 1))
+    {
+        as608_interface_debug_print("as608: enroll timeout is not reported.\n");
+        
+        return 1;
+    }
+    
+    /* two samples with a lost response */
+    as608_interface_debug_print("as608: enroll with a lost response.\n");
+    (void)as608_emulator_set_finger(&gs_emu, 1, EMULATOR_TEST_FINGER);
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_STALL, EMULATOR_TEST_COMMAND_GET_IMAGE, 0, 1);
+    res = a_emulator_test_enroll_run(5000, &enroll);
+    if ((res != 0) || (enroll.state != AS608_ENROLL_STATE_DONE) || (enroll.page_number != 0) || 
+        (a_emulator_test_event_count(AS608_ENROLL_EVENT_STORED) != 1) || 
+        (a_emulator_test_event_count(AS608_ENROLL_EVENT_FINGER_UP) != 1))
+    {
+        as608_interface_debug_print("as608: enroll is not retried.\n");
+        
+        return 1;
+    }
+    
+    /* a poor feature is taken again after the lift */
+    as608_interface_debug_print("as608: enroll with a poor feature.\n");
+    (void)as608_emulator_set_finger(&gs_emu, 1, EMULATOR_TEST_FINGER);
+    gen = gs_sent[EMULATOR_TEST_COMMAND_GEN_CHAR];
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_STATUS, EMULATOR_TEST_COMMAND_GEN_CHAR, AS608_STATUS_IMAGE_TOO_FEW_FEATURE, 1);
+    res = a_emulator_test_enroll_run(5000, &enroll);
+    if ((res != 0) || (enroll.state != AS608_ENROLL_STATE_DONE) || (enroll.page_number != 1) || 
+        (a_emulator_test_event_count(AS608_ENROLL_EVENT_QUALITY) != 1) || 
+        (a_emulator_test_event_count(AS608_ENROLL_EVENT_FINGER_UP) != 2) || 
+        ((gs_sent[EMULATOR_TEST_COMMAND_GEN_CHAR] - gen) != 3))
+    {
+        as608_interface_debug_print("as608: poor feature is not taken again.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < gs_event_len; i++)
+    {
+        if ((gs_event[i] == AS608_ENROLL_EVENT_QUALITY) && (gs_event_sample[i] != 1))
+        {
+            as608_interface_debug_print("as608: poor feature moves to the next sample.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      emulator test run one verification
+ * @param[in]  mode search mode
+ * @param[out] *verify pointer to a verify structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_emulator_test_verify_run(as608_verify_mode_t mode, as608_verify_t *verify)
+{
+    uint32_t i;
+    as608_bool_t done;
+    
+    if (as608_verify_start(&gs_handle, verify, EMULATOR_TEST_ADDR, mode, 
+                           AS608_BUFFER_NUMBER_1, 0, 10, NULL) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < EMULATOR_TEST_STEP_MAX; i++)
+    {
+        (void)as608_verify_step(&gs_handle, verify, &done);
+        if (done == AS608_BOOL_TRUE)
+        {
+            return 0;
+        }
+        gs_now += 1;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief  emulator test the verify state machine
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the test finger is on the sensor
+ */
+static uint8_t a_emulator_test_verify(void)
+{
+    uint8_t res;
+    uint32_t search;
+    as608_verify_t verify;
+    
+    /* search */
+    as608_interface_debug_print("as608: verify search.\n");
+    res = a_emulator_test_verify_run(AS608_VERIFY_MODE_SEARCH, &verify);
+    if ((res != 0) || (verify.state != AS608_VERIFY_STATE_DONE) || 
+        (verify.status != AS608_STATUS_OK) || (verify.found_page != 0))
+    {
+        as608_interface_debug_print("as608: verify search failed.\n");
+        
+        return 1;
+    }
+    
+    /* high speed search */
+    as608_interface_debug_print("as608: verify high speed search.\n");
+    search = gs_sent[EMULATOR_TEST_COMMAND_SEARCH];
+    res = a_emulator_test_verify_run(AS608_VERIFY_MODE_HIGH_SPEED_SEARCH, &verify);
+    if ((res != 0) || (verify.status != AS608_STATUS_OK) || (verify.found_page != 0) || 
+        (verify.confirm != 0) || (gs_sent[EMULATOR_TEST_COMMAND_SEARCH] != search))
+    {
+        as608_interface_debug_print("as608: verify high speed search failed.\n");
+        
+        return 1;
+    }
+    
+    /* a high speed miss is confirmed */
+    as608_interface_debug_print("as608: verify high speed miss.\n");
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_STATUS, EMULATOR_TEST_COMMAND_HIGH_SPEED_SEARCH, AS608_STATUS_NOT_FOUND, 1);
+    res = a_emulator_test_verify_run(AS608_VERIFY_MODE_HIGH_SPEED_SEARCH, &verify);
+    if ((res != 0) || (verify.status != AS608_STATUS_OK) || (verify.found_page != 0) || 
+        (verify.confirm != 1) || (gs_sent[EMULATOR_TEST_COMMAND_SEARCH] != (search + 1)))
+    {
+        as608_interface_debug_print("as608: verify high speed miss is not confirmed.\n");
+        
+        return 1;
+    }
+    
+    /* a broken response fails the verification */
+    as608_interface_debug_print("as608: verify broken response.\n");
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_FLIP, EMULATOR_TEST_COMMAND_GEN_CHAR, 0, 1);
+    res = a_emulator_test_verify_run(AS608_VERIFY_MODE_SEARCH, &verify);
+    if ((res != 0) || (verify.state != AS608_VERIFY_STATE_FAILED) || 
+        (verify.phase != AS608_VERIFY_STATE_FEATURE) || (verify.res != 3))
+    {
+        as608_interface_debug_print("as608: verify broken response is accepted.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator test the best identify routing
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the test finger is on the sensor
+ */
+static uint8_t a_emulator_test_best_identify(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint16_t found_page;
+    uint16_t score;
+    uint32_t search;
+    as608_status_t status;
+    as608_best_identify_t best;
+    
+    /* check best */
+    as608_interface_debug_print("as608: best identify.\n");
+    if ((as608_best_identify_calibrate(&gs_handle, NULL, EMULATOR_TEST_ADDR, 0, 10, 1) != 6) || 
+        (as608_best_identify(&gs_handle, NULL, EMULATOR_TEST_ADDR, 0, 10, &found_page, &score, &status) != 6))
+    {
+        as608_interface_debug_print("as608: best NULL is accepted.\n");
+        
+        return 1;
+    }
+    
+    /* the identify command is the slowest path */
+    (void)as608_emulator_set_latency(&gs_emu, EMULATOR_TEST_COMMAND_IDENTIFY, 200);
+    (void)as608_best_identify_init(&best);
+    res = as608_best_identify_calibrate(&gs_handle, &best, EMULATOR_TEST_ADDR, 0, 10, 2);
+    if ((res != 0) || (best.count[AS608_IDENTIFY_PATH_IDENTIFY] != 2) || 
+        (best.count[AS608_IDENTIFY_PATH_SEARCH] != 2) || 
+        (best.count[AS608_IDENTIFY_PATH_HIGH_SPEED_SEARCH] != 2))
+    {
+        as608_interface_debug_print("as608: best identify calibrate failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        res = as608_best_identify(&gs_handle, &best, EMULATOR_TEST_ADDR, 0, 10, &found_page, &score, &status);
+        if ((res != 0) || (status != AS608_STATUS_OK) || (found_page != 0) || 
+            (best.path == AS608_IDENTIFY_PATH_IDENTIFY))
+        {
+            as608_interface_debug_print("as608: best identify takes the slow path.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* a high speed miss is confirmed by a search */
+    best.ewma_ms[AS608_IDENTIFY_PATH_SEARCH] = best.ewma_ms[AS608_IDENTIFY_PATH_HIGH_SPEED_SEARCH] + 100;
+    search = gs_sent[EMULATOR_TEST_COMMAND_SEARCH];
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_STATUS, EMULATOR_TEST_COMMAND_HIGH_SPEED_SEARCH, AS608_STATUS_NOT_FOUND, 1);
+    res = as608_best_identify(&gs_handle, &best, EMULATOR_TEST_ADDR, 0, 10, &found_page, &score, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (found_page != 0) || 
+        (best.path != AS608_IDENTIFY_PATH_HIGH_SPEED_SEARCH) || (gs_sent[EMULATOR_TEST_COMMAND_SEARCH] != (search + 1)))
+    {
+        as608_interface_debug_print("as608: best identify high speed miss is not confirmed.\n");
+        
+        return 1;
+    }
+    
+    /* the identify command is skipped in a part of the library */
+    res = as608_best_identify(&gs_handle, &best, EMULATOR_TEST_ADDR, 1, 9, &found_page, &score, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (found_page != 1) || 
+        (best.path == AS608_IDENTIFY_PATH_IDENTIFY))
+    {
+        as608_interface_debug_print("as608: best identify runs the identify in a part of the library.\n");
+        
+        return 1;
+    }
+    (void)as608_emulator_set_latency(&gs_emu, EMULATOR_TEST_COMMAND_IDENTIFY, 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator test the bulk session
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+static uint8_t a_emulator_test_bulk(void)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    uint16_t len;
+    uint32_t i;
+    uint32_t writes;
+    as608_status_t status;
+    as608_bulk_profile_t profile;
+    
+    /* a command in flight */
+    as608_interface_debug_print("as608: bulk with a command in flight.\n");
+    buf[0] = EMULATOR_TEST_COMMAND_GET_IMAGE;
+    if (as608_async_submit(&gs_handle, EMULATOR_TEST_ADDR, buf, 1, 500, 
+                           a_emulator_test_async_callback, NULL) != 0)
+    {
+        as608_interface_debug_print("as608: async submit failed.\n");
+        
+        return 1;
+    }
+    res = as608_bulk_begin(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    (void)as608_async_cancel(&gs_handle);
+    if (res != 4)
+    {
+        as608_interface_debug_print("as608: bulk begin with a command in flight is accepted.\n");
+        
+        return 1;
+    }
+    
+    /* begin at the fastest host rate */
+    as608_interface_debug_print("as608: bulk begin and end.\n");
+    gs_host_max_n_9600 = 12;
+    writes = gs_sent[EMULATOR_TEST_COMMAND_WRITE_REG];
+    res = as608_bulk_begin(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (gs_handle.n_9600 != 12) || (gs_host_n_9600 != 12) || 
+        (gs_emu.n_9600 != 12) || (gs_emu.packet_size != AS608_PACKET_SIZE_256_BYTES) || 
+        ((gs_sent[EMULATOR_TEST_COMMAND_WRITE_REG] - writes) != 2))
+    {
+        as608_interface_debug_print("as608: bulk begin failed.\n");
+        
+        return 1;
+    }
+    if (as608_bulk_begin(&gs_handle, EMULATOR_TEST_ADDR, &status) != 4)
+    {
+        as608_interface_debug_print("as608: second bulk begin is accepted.\n");
+        
+        return 1;
+    }
+    
+    /* image round trip in the session */
+    for (i = 0; i < AS608_EMULATOR_IMAGE_SIZE; i++)
+    {
+        gs_buffer_check[i] = (uint8_t)(i * 7 + 3);
+    }
+    res = as608_download_image(&gs_handle, EMULATOR_TEST_ADDR, gs_buffer_check, AS608_EMULATOR_IMAGE_SIZE, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: bulk download image failed.\n");
+        
+        return 1;
+    }
+    len = AS608_EMULATOR_IMAGE_SIZE;
+    res = as608_upload_image(&gs_handle, EMULATOR_TEST_ADDR, gs_buffer, &len, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (len != AS608_EMULATOR_IMAGE_SIZE) || 
+        (memcmp(gs_buffer, gs_buffer_check, AS608_EMULATOR_IMAGE_SIZE) != 0))
+    {
+        as608_interface_debug_print("as608: bulk image round trip failed.\n");
+        
+        return 1;
+    }
+    
+    /* end restores the settings */
+    res = as608_bulk_end(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (gs_handle.n_9600 != 6) || (gs_host_n_9600 != 6) || 
+        (gs_emu.n_9600 != 6) || (gs_emu.packet_size != AS608_PACKET_SIZE_128_BYTES))
+    {
+        as608_interface_debug_print("as608: bulk end failed.\n");
+        
+        return 1;
+    }
+    if (as608_bulk_end(&gs_handle, EMULATOR_TEST_ADDR, &status) != 4)
+    {
+        as608_interface_debug_print("as608: second bulk end is accepted.\n");
+        
+        return 1;
+    }
+    
+    /* the profile skips the probing */
+    as608_interface_debug_print("as608: bulk profile.\n");
+    if ((as608_get_bulk_profile(&gs_handle, &profile) != 0) || (profile.valid == 0) || (profile.n_9600 != 12) || 
+        (profile.packet_size != AS608_PACKET_SIZE_256_BYTES))
+    {
+        as608_interface_debug_print("as608: bulk profile is not saved.\n");
+        
+        return 1;
+    }
+    writes = gs_sent[EMULATOR_TEST_COMMAND_WRITE_REG];
+    res = as608_bulk_begin(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (gs_emu.n_9600 != 12) || ((gs_sent[EMULATOR_TEST_COMMAND_WRITE_REG] - writes) != 2) || 
+        (as608_bulk_end(&gs_handle, EMULATOR_TEST_ADDR, &status) != 0) || (gs_emu.n_9600 != 6))
+    {
+        as608_interface_debug_print("as608: bulk profile failed.\n");
+        
+        return 1;
+    }
+    
+    /* the host can't go faster */
+    as608_interface_debug_print("as608: bulk at the host limit.\n");
+    gs_host_max_n_9600 = 6;
+    profile.valid = 0;
+    (void)as608_set_bulk_profile(&gs_handle, &profile);
+    res = as608_bulk_begin(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (gs_handle.n_9600 != 6) || (gs_emu.n_9600 != 6) || 
+        (as608_bulk_end(&gs_handle, EMULATOR_TEST_ADDR, &status) != 0) || 
+        (gs_emu.packet_size != AS608_PACKET_SIZE_128_BYTES))
+    {
+        as608_interface_debug_print("as608: bulk at the host limit failed.\n");
+        
+        return 1;
+    }
+    
+    /* the chip is switched but the host is not */
+    as608_interface_debug_print("as608: switch baud rate with a host failure.\n");
+    res = as608_switch_baud_rate(&gs_handle, EMULATOR_TEST_ADDR, 12, &status);
+    if ((res != 7) || (gs_handle.n_9600 != 6) || (gs_host_n_9600 != 6) || (gs_emu.n_9600 != 12))
+    {
+        as608_interface_debug_print("as608: switch baud rate host failure is not reported.\n");
+        
+        return 1;
+    }
+    
+    /* the host follows the chip */
+    gs_host_max_n_9600 = 12;
+    gs_host_n_9600 = 12;
+    res = as608_switch_baud_rate(&gs_handle, EMULATOR_TEST_ADDR, 6, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK) || (gs_handle.n_9600 != 6) || (gs_emu.n_9600 != 6))
+    {
+        as608_interface_debug_print("as608: switch baud rate back failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the driver runs against the as608 emulator in process with a simulated clock and injected link faults
+ */
+uint8_t as608_emulator_test(void)
+{
+    uint8_t res;
+    as608_status_t status;
+    
+    /* link interface function */
+    DRIVER_AS608_LINK_INIT(&gs_handle, as608_handle_t);
+    DRIVER_AS608_LINK_UART_INIT(&gs_handle, a_emulator_test_uart_init);
+    DRIVER_AS608_LINK_UART_DEINIT(&gs_handle, a_emulator_test_uart_deinit);
+    DRIVER_AS608_LINK_UART_READ(&gs_handle, a_emulator_test_uart_read);
+    DRIVER_AS608_LINK_UART_WRITE(&gs_handle, a_emulator_test_uart_write);
+    DRIVER_AS608_LINK_UART_FLUSH(&gs_handle, a_emulator_test_uart_flush);
+    DRIVER_AS608_LINK_DELAY_MS(&gs_handle, a_emulator_test_delay_ms);
+    DRIVER_AS608_LINK_TIMESTAMP_MS(&gs_handle, a_emulator_test_timestamp_ms);
+    DRIVER_AS608_LINK_UART_SET_BAUD_RATE(&gs_handle, a_emulator_test_uart_set_baud_rate);
+    DRIVER_AS608_LINK_UART_DRAIN(&gs_handle, a_emulator_test_uart_drain);
+    DRIVER_AS608_LINK_DEBUG_PRINT(&gs_handle, as608_interface_debug_print);
+    
+    /* start emulator test */
+    as608_interface_debug_print("as608: start emulator test.\n");
+    
+    /* frame parser */
+    as608_interface_debug_print("as608: frame parser.\n");
+    if (a_emulator_test_parser() != 0)
+    {
+        return 1;
+    }
+    
+    /* emulator init */
+    gs_now = 0;
+    gs_host_n_9600 = 6;
+    gs_host_max_n_9600 = 12;
+    gs_split = 0;
+    gs_wire_head = 0;
+    gs_wire_tail = 0;
+    gs_wire_ready = 0;
+    memset(gs_sent, 0, sizeof(gs_sent));
+    a_emulator_test_arm(EMULATOR_TEST_FAULT_NONE, 0, 0, 0);
+    res = as608_emulator_init(&gs_emu, EMULATOR_TEST_ADDR);
+    if (res != 0)
+    {
+        as608_interface_debug_print("as608: emulator init failed.\n");
+        
+        return 1;
+    }
+    
+    /* as608 init */
+    res = as608_init(&gs_handle, EMULATOR_TEST_ADDR);
+    if (res != 0)
+    {
+        as608_interface_debug_print("as608: init failed.\n");
+        
+        return 1;
+    }
+    res = as608_set_stats(&gs_handle, &gs_stats);
+    if (res != 0)
+    {
+        as608_interface_debug_print("as608: set stats failed.\n");
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = as608_empty_all_feature(&gs_handle, EMULATOR_TEST_ADDR, &status);
+    if ((res != 0) || (status != AS608_STATUS_OK))
+    {
+        as608_interface_debug_print("as608: empty all feature failed.\n");
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* link faults */
+    (void)as608_emulator_set_finger(&gs_emu, 1, EMULATOR_TEST_FINGER);
+    if (a_emulator_test_fault() != 0)
+    {
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* async commands */
+    if (a_emulator_test_async() != 0)
+    {
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* enroll */
+    if (a_emulator_test_enroll() != 0)
+    {
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* verify */
+    (void)as608_emulator_set_finger(&gs_emu, 1, EMULATOR_TEST_FINGER);
+    if (a_emulator_test_verify() != 0)
+    {
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* best identify */
+    if (a_emulator_test_best_identify() != 0)
+    {
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* bulk session */
+    if (a_emulator_test_bulk() != 0)
+    {
+        (void)as608_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish emulator test */
+    as608_interface_debug_print("as608: finish emulator test.\n");
+    (void)as608_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -71,6 +71,9 @@ uint8_t as608_fingerprint_test(uint32_t addr)
     DRIVER_AS608_LINK_UART_WRITE(&gs_handle, as608_interface_uart_write);
     DRIVER_AS608_LINK_UART_FLUSH(&gs_handle, as608_interface_uart_flush);
     DRIVER_AS608_LINK_DELAY_MS(&gs_handle, as608_interface_delay_ms);
+    DRIVER_AS608_LINK_TIMESTAMP_MS(&gs_handle, as608_interface_timestamp_ms);
+    DRIVER_AS608_LINK_UART_SET_BAUD_RATE(&gs_handle, as608_interface_uart_set_baud_rate);
+    DRIVER_AS608_LINK_UART_DRAIN(&gs_handle, as608_interface_uart_drain);
     DRIVER_AS608_LINK_DEBUG_PRINT(&gs_handle, as608_interface_debug_print);
     
     /* get as608 information */